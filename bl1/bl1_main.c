@@ -15,6 +15,9 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
+#if AUTH_SIG_CACHE
+#include <drivers/auth/mbedtls/mbedtls_sig_cache.h>
+#endif
 #include <drivers/console.h>
 #include <lib/cpus/errata_report.h>
 #include <lib/utils.h>
@@ -190,6 +193,10 @@ static void bl1_load_bl2(void)
 		plat_error_handler(err);
 	}
 
+#if AUTH_SIG_CACHE
+	sig_cache_flush();
+#endif
+
 	/* Allow platform to handle image information. */
 	err = bl1_plat_handle_post_image_load(BL2_IMAGE_ID);
 	if (err != 0) {
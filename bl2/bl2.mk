@@ -11,6 +11,10 @@ BL2_SOURCES		+=	bl2/bl2_image_load_v2.c			\
 				plat/common/${ARCH}/platform_up_stack.S	\
 				${MBEDTLS_SOURCES}
 
+ifeq (${ENABLE_BOOT_TIMELINE},1)
+BL2_SOURCES		+=	lib/pmf/pmf_timeline.c
+endif
+
 ifeq (${ARCH},aarch64)
 BL2_SOURCES		+=	common/aarch64/early_exceptions.S
 endif
@@ -42,6 +46,10 @@ ifeq (${DISABLE_MTPMU},1)
 BL2_SOURCES		+=	lib/extensions/mtpmu/${ARCH}/mtpmu.S
 endif
 
+ifeq (${BL2_PARALLEL_AUTH},1)
+BL2_SOURCES		+=	bl2/bl2_workers.c
+endif
+
 ifeq (${ARCH},aarch64)
 BL2_SOURCES		+=	lib/cpus/aarch64/dsu_helpers.S
 endif
@@ -11,14 +11,39 @@
 
 #include <arch.h>
 #include <arch_helpers.h>
+#include <bl2/bl2.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/desc_image_load.h>
 #include <drivers/auth/auth_mod.h>
+#if AUTH_SIG_CACHE
+#include <drivers/auth/mbedtls/mbedtls_sig_cache.h>
+#endif
+#include <lib/pmf/pmf_timeline.h>
 #include <plat/common/platform.h>
 
 #include "bl2_private.h"
 
+#if BL2_READ_AHEAD
+/*******************************************************************************
+ * Select the next image in the load list to be read from storage while the
+ * current one is being authenticated and post-processed.
+ ******************************************************************************/
+static void bl2_read_ahead_next(const bl_load_info_node_t *node_info)
+{
+	const bl_load_info_node_t *next = node_info->next_load_info;
+
+	while ((next != NULL) &&
+	       ((next->image_info->h.attr & IMAGE_ATTRIB_SKIP_LOADING) != 0U)) {
+		next = next->next_load_info;
+	}
+
+	if (next != NULL) {
+		load_image_read_ahead(next->image_id);
+	}
+}
+#endif /* BL2_READ_AHEAD */
+
 /*******************************************************************************
  * This function loads SCP_BL2/BL3x images and returns the ep_info for
  * the next executable image.
@@ -30,6 +55,7 @@ struct entry_point_info *bl2_load_images(void)
 	const bl_load_info_node_t *bl2_node_info;
 	int plat_setup_done = 0;
 	int err;
+	int tl;
 
 	/*
 	 * Get information about the images to load.
@@ -41,6 +67,10 @@ struct entry_point_info *bl2_load_images(void)
 	assert(bl2_load_info->h.version >= VERSION_2);
 	bl2_node_info = bl2_load_info->head;
 
+#if BL2_PARALLEL_AUTH
+	bl2_workers_start();
+#endif
+
 	while (bl2_node_info != NULL) {
 		/*
 		 * Perform platform setup before loading the image,
@@ -53,11 +83,20 @@ struct entry_point_info *bl2_load_images(void)
 				WARN("BL2: Platform setup already done!!\n");
 			} else {
 				INFO("BL2: Doing platform setup\n");
+				tl = PMF_TL_BEGIN("platform_setup", 0U);
 				bl2_platform_setup();
+				PMF_TL_END(tl);
 				plat_setup_done = 1;
 			}
 		}
 
+#if BL2_READ_AHEAD
+		/*
+		 * The pre-load hook may access the storage, which can't be
+		 * shared with the read ahead of this image.
+		 */
+		load_image_read_ahead_wait();
+#endif
 		err = bl2_plat_handle_pre_image_load(bl2_node_info->image_id);
 		if (err != 0) {
 			ERROR("BL2: Failure in pre image load handling (%i)\n", err);
@@ -66,6 +105,9 @@ struct entry_point_info *bl2_load_images(void)
 
 		if ((bl2_node_info->image_info->h.attr &
 		    IMAGE_ATTRIB_SKIP_LOADING) == 0U) {
+#if BL2_READ_AHEAD
+			bl2_read_ahead_next(bl2_node_info);
+#endif
 			INFO("BL2: Loading image id %d\n", bl2_node_info->image_id);
 			err = load_auth_image(bl2_node_info->image_id,
 				bl2_node_info->image_info);
@@ -79,7 +121,9 @@ struct entry_point_info *bl2_load_images(void)
 		}
 
 		/* Allow platform to handle image information. */
+		tl = PMF_TL_BEGIN("post_load", bl2_node_info->image_id);
 		err = bl2_plat_handle_post_image_load(bl2_node_info->image_id);
+		PMF_TL_END(tl);
 		if (err != 0) {
 			ERROR("BL2: Failure in post image load handling (%i)\n", err);
 			plat_error_handler(err);
@@ -89,6 +133,22 @@ struct entry_point_info *bl2_load_images(void)
 		bl2_node_info = bl2_node_info->next_load_info;
 	}
 
+#if BL2_PARALLEL_AUTH
+	/* All deferred image checks must pass before going any further */
+	tl = PMF_TL_BEGIN("auth_wait", 0U);
+	err = bl2_workers_stop();
+	PMF_TL_END(tl);
+	if (err != 0) {
+		ERROR("BL2: Failed to authenticate images (%i)\n", err);
+		plat_error_handler(err);
+	}
+#endif
+
+#if AUTH_SIG_CACHE
+	/* Store the signature checks of this boot in a single write */
+	sig_cache_flush();
+#endif
+
 	/*
 	 * Get information to pass to the next image.
 	 */
@@ -16,6 +16,7 @@
 #include <drivers/console.h>
 #include <drivers/fwu/fwu.h>
 #include <lib/extensions/pauth.h>
+#include <lib/pmf/pmf_timeline.h>
 #include <plat/common/platform.h>
 
 #include "bl2_private.h"
@@ -78,6 +79,12 @@ void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 void bl2_main(void)
 {
 	entry_point_info_t *next_bl_ep_info;
+	int tl_bl2;
+
+#if ENABLE_BOOT_TIMELINE
+	pmf_tl_init();
+#endif
+	tl_bl2 = PMF_TL_BEGIN("bl2", 0U);
 
 	NOTICE("BL2: %s\n", version_string);
 	NOTICE("BL2: %s\n", build_message);
@@ -106,6 +113,11 @@ void bl2_main(void)
 	/* Teardown the Measured Boot backend */
 	bl2_plat_mboot_finish();
 
+	PMF_TL_END(tl_bl2);
+#if ENABLE_BOOT_TIMELINE
+	pmf_tl_flush();
+#endif
+
 #if !BL2_AT_EL3 && !ENABLE_RME
 #ifndef __aarch64__
 	/*
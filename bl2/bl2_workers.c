@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <bl2/bl2.h>
+#include <common/debug.h>
+#include <drivers/delay_timer.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+
+/*
+ * The secondary CPUs released by BL2 each own a one-entry mailbox. Only the
+ * boot CPU moves a mailbox to BUSY, IDLE or STOP, and only the worker moves
+ * it to IDLE (when it comes up), DONE or PARKED, so plain ordered accesses
+ * are enough and no lock is needed. This matters because BL2 may run with
+ * the data cache disabled, where exclusive accesses cannot be relied on.
+ */
+#define BL2_WORKER_OFF		U(0)
+#define BL2_WORKER_BOOTING	U(1)
+#define BL2_WORKER_IDLE		U(2)
+#define BL2_WORKER_BUSY		U(3)
+#define BL2_WORKER_DONE		U(4)
+#define BL2_WORKER_STOP		U(5)
+#define BL2_WORKER_PARKED	U(6)
+
+/* How long a worker may take to come up, finish its work or park */
+#ifndef PLAT_BL2_WORKER_TIMEOUT_US
+#define PLAT_BL2_WORKER_TIMEOUT_US	U(5000000)
+#endif
+
+typedef struct bl2_worker {
+	bl2_work_fn_t fn;
+	void *arg;
+	int ret;
+	volatile unsigned int state;
+} bl2_worker_t;
+
+static bl2_worker_t bl2_workers[PLATFORM_CORE_COUNT];
+
+/* First error reported by a worker */
+static int bl2_work_error;
+
+/* Used by bl2_el3_worker_entrypoint() */
+uint8_t bl2_worker_stacks[PLATFORM_CORE_COUNT][PLATFORM_STACK_SIZE]
+	__aligned(16);
+
+static void bl2_worker_set_state(bl2_worker_t *worker, unsigned int state)
+{
+	/* Publish everything written so far along with the new state */
+	dmbsy();
+	worker->state = state;
+	dsbsy();
+	sev();
+}
+
+void __dead2 bl2_worker_main(void)
+{
+	bl2_worker_t *worker = &bl2_workers[plat_my_core_pos()];
+	unsigned int state;
+
+	bl2_plat_worker_setup();
+
+	bl2_worker_set_state(worker, BL2_WORKER_IDLE);
+
+	for (;;) {
+		state = worker->state;
+		if ((state == BL2_WORKER_IDLE) || (state == BL2_WORKER_DONE)) {
+			wfe();
+			continue;
+		}
+
+		if (state == BL2_WORKER_STOP)
+			break;
+
+		assert(state == BL2_WORKER_BUSY);
+		dmbsy();
+		worker->ret = worker->fn(worker->arg);
+		bl2_worker_set_state(worker, BL2_WORKER_DONE);
+	}
+
+	/* Get ready to be powered down, then let the boot CPU go on */
+	bl2_plat_worker_park();
+	bl2_worker_set_state(worker, BL2_WORKER_PARKED);
+
+	bl2_plat_worker_pwr_down();
+}
+
+/*
+ * Wait for a worker to leave the states of the calling CPU's choosing. The
+ * state is polled rather than waited for with WFE, as a stuck worker would
+ * never send the event that lets the timeout be checked.
+ */
+static unsigned int bl2_worker_wait(const bl2_worker_t *worker,
+				    unsigned int state1, unsigned int state2)
+{
+	uint64_t timeout = timeout_init_us(PLAT_BL2_WORKER_TIMEOUT_US);
+	unsigned int state;
+
+	for (state = worker->state;
+	     (state == state1) || (state == state2);
+	     state = worker->state) {
+		if (timeout_elapsed(timeout)) {
+			ERROR("BL2: Worker CPU %u stuck in state %u\n",
+			      (unsigned int)(worker - bl2_workers), state);
+			panic();
+		}
+	}
+
+	dmbsy();
+
+	return state;
+}
+
+static void bl2_worker_reap(bl2_worker_t *worker)
+{
+	if ((worker->ret != 0) && (bl2_work_error == 0))
+		bl2_work_error = worker->ret;
+
+	worker->state = BL2_WORKER_IDLE;
+}
+
+/*
+ * Release all secondary CPUs into bl2_worker_main(). This must be called by
+ * the boot CPU once BL2 is fully set up.
+ */
+void bl2_workers_start(void)
+{
+	unsigned int me = plat_my_core_pos();
+	unsigned int pos, count = 0U;
+
+	/*
+	 * The workers use their stacks before turning their data cache on,
+	 * make sure no stale copy of them is left in the caches.
+	 */
+	flush_dcache_range((uintptr_t)bl2_worker_stacks,
+			   sizeof(bl2_worker_stacks));
+
+	for (pos = 0U; pos < PLATFORM_CORE_COUNT; pos++) {
+		if (pos == me)
+			continue;
+
+		bl2_workers[pos].state = BL2_WORKER_BOOTING;
+		dsbsy();
+
+		if (bl2_plat_worker_release(pos,
+				(uintptr_t)bl2_el3_worker_entrypoint) != 0) {
+			bl2_workers[pos].state = BL2_WORKER_OFF;
+			continue;
+		}
+
+		count++;
+	}
+
+	INFO("BL2: Released %u worker CPUs\n", count);
+}
+
+/*
+ * Hand fn(arg) over to an idle worker. If all of them are busy, it is run
+ * right away by the calling CPU and its result returned. Otherwise 0 is
+ * returned and the result is reported by bl2_workers_stop().
+ */
+int bl2_work_queue(bl2_work_fn_t fn, void *arg)
+{
+	bl2_worker_t *worker;
+	unsigned int pos;
+
+	for (pos = 0U; pos < PLATFORM_CORE_COUNT; pos++) {
+		worker = &bl2_workers[pos];
+
+		if (worker->state == BL2_WORKER_DONE) {
+			dmbsy();
+			bl2_worker_reap(worker);
+		}
+
+		if (worker->state == BL2_WORKER_IDLE) {
+			worker->fn = fn;
+			worker->arg = arg;
+			bl2_worker_set_state(worker, BL2_WORKER_BUSY);
+			return 0;
+		}
+	}
+
+	return fn(arg);
+}
+
+/*
+ * Wait for all queued work to complete and park the workers again. Must be
+ * called before BL2 hands over to the next image.
+ *
+ * Return: 0 if all work succeeded, otherwise the first error
+ */
+int bl2_workers_stop(void)
+{
+	bl2_worker_t *worker;
+	unsigned int pos;
+
+	for (pos = 0U; pos < PLATFORM_CORE_COUNT; pos++) {
+		worker = &bl2_workers[pos];
+		if (worker->state == BL2_WORKER_OFF)
+			continue;
+
+		if (bl2_worker_wait(worker, BL2_WORKER_BOOTING,
+				    BL2_WORKER_BUSY) == BL2_WORKER_DONE)
+			bl2_worker_reap(worker);
+
+		/*
+		 * Park the workers one at a time, so that
+		 * bl2_plat_worker_park() never runs on two CPUs at once and
+		 * may update shared power controller registers.
+		 */
+		bl2_worker_set_state(worker, BL2_WORKER_STOP);
+		(void)bl2_worker_wait(worker, BL2_WORKER_STOP,
+				      BL2_WORKER_STOP);
+		worker->state = BL2_WORKER_OFF;
+	}
+
+	return bl2_work_error;
+}
@@ -50,6 +50,14 @@ ifeq (${ENABLE_PMF}, 1)
 BL31_SOURCES		+=	lib/pmf/pmf_main.c
 endif
 
+ifeq (${ENABLE_BOOT_TIMELINE},1)
+BL31_SOURCES		+=	lib/pmf/pmf_timeline.c
+endif
+
+ifeq (${ENABLE_SMC_LATENCY_STATS},1)
+BL31_SOURCES		+=	lib/pmf/pmf_smc_lat.c
+endif
+
 include lib/debugfs/debugfs.mk
 ifeq (${USE_DEBUGFS},1)
 	BL31_SOURCES	+= $(DEBUGFS_SRCS)
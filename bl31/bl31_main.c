@@ -18,6 +18,7 @@
 #include <drivers/console.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/pmf/pmf.h>
+#include <lib/pmf/pmf_timeline.h>
 #include <lib/runtime_instr.h>
 #include <plat/common/platform.h>
 #include <services/std_svc.h>
@@ -120,6 +121,13 @@ void bl31_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
  ******************************************************************************/
 void bl31_main(void)
 {
+	int tl_bl31, tl;
+
+#if ENABLE_BOOT_TIMELINE
+	pmf_tl_init();
+#endif
+	tl_bl31 = PMF_TL_BEGIN("bl31", 0U);
+
 	NOTICE("BL31: %s\n", version_string);
 	NOTICE("BL31: %s\n", build_message);
 
@@ -130,7 +138,9 @@ void bl31_main(void)
 #endif
 
 	/* Perform platform setup in BL31 */
+	tl = PMF_TL_BEGIN("platform_setup", 0U);
 	bl31_platform_setup();
+	PMF_TL_END(tl);
 
 	/* Initialise helper libraries */
 	bl31_lib_init();
@@ -142,7 +152,9 @@ void bl31_main(void)
 
 	/* Initialize the runtime services e.g. psci. */
 	INFO("BL31: Initializing runtime services\n");
+	tl = PMF_TL_BEGIN("runtime_svc_init", 0U);
 	runtime_svc_init();
+	PMF_TL_END(tl);
 
 	/*
 	 * All the cold boot actions on the primary cpu are done. We now need to
@@ -163,7 +175,9 @@ void bl31_main(void)
 	if (bl32_init != NULL) {
 		INFO("BL31: Initializing BL32\n");
 
+		tl = PMF_TL_BEGIN("bl32_init", 0U);
 		int32_t rc = (*bl32_init)();
+		PMF_TL_END(tl);
 
 		if (rc == 0) {
 			WARN("BL31: BL32 initialization failed\n");
@@ -192,6 +206,11 @@ void bl31_main(void)
 	 */
 	bl31_prepare_next_image_entry();
 
+	PMF_TL_END(tl_bl31);
+#if ENABLE_BOOT_TIMELINE
+	pmf_tl_flush();
+#endif
+
 	console_flush();
 
 	/*
@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <arch.h>
@@ -15,10 +16,23 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/io/io_storage.h>
+#include <lib/pmf/pmf_timeline.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <plat/common/platform.h>
 
+#if BL2_READ_AHEAD && defined(IMAGE_BL2)
+#include <platform_def.h>
+
+#if !defined(PLAT_BL2_READ_AHEAD_BASE) || !defined(PLAT_BL2_READ_AHEAD_SIZE)
+#error "BL2_READ_AHEAD requires PLAT_BL2_READ_AHEAD_BASE/SIZE to be defined"
+#endif
+
+#define IMAGE_READ_AHEAD	1
+#else
+#define IMAGE_READ_AHEAD	0
+#endif
+
 #if TRUSTED_BOARD_BOOT
 # ifdef DYN_DISABLE_AUTH
 static int disable_auth;
@@ -59,6 +73,127 @@ uintptr_t page_align(uintptr_t value, unsigned dir)
 	return value;
 }
 
+#if IMAGE_READ_AHEAD
+/*
+ * State of the image read ahead into the platform scratch buffer. The read is
+ * started once the current image has been loaded, so that the storage transfer
+ * overlaps with its authentication and post-processing.
+ */
+static struct {
+	unsigned int next_id;		/* Image to read ahead next */
+	unsigned int image_id;		/* Image held in the scratch buffer */
+	uintptr_t dev_handle;
+	uintptr_t image_handle;
+	size_t image_size;
+	bool pending;			/* Transfer in progress */
+} read_ahead = {
+	.next_id = INVALID_IMAGE_ID,
+	.image_id = INVALID_IMAGE_ID,
+};
+
+/*******************************************************************************
+ * Select the image to read ahead once the image being loaded is in memory.
+ ******************************************************************************/
+void load_image_read_ahead(unsigned int image_id)
+{
+	read_ahead.next_id = image_id;
+}
+
+static void read_ahead_start(void)
+{
+	unsigned int image_id = read_ahead.next_id;
+	uintptr_t image_spec;
+	int io_result;
+
+	read_ahead.next_id = INVALID_IMAGE_ID;
+	if ((image_id == INVALID_IMAGE_ID) || read_ahead.pending) {
+		return;
+	}
+
+	io_result = plat_get_image_source(image_id, &read_ahead.dev_handle,
+					  &image_spec);
+	if (io_result != 0) {
+		return;
+	}
+
+	io_result = io_open(read_ahead.dev_handle, image_spec,
+			    &read_ahead.image_handle);
+	if (io_result != 0) {
+		(void)io_dev_close(read_ahead.dev_handle);
+		return;
+	}
+
+	io_result = io_size(read_ahead.image_handle, &read_ahead.image_size);
+	if ((io_result == 0) && (read_ahead.image_size != 0U) &&
+	    (read_ahead.image_size <= PLAT_BL2_READ_AHEAD_SIZE)) {
+		io_result = io_read_async(read_ahead.image_handle,
+					  PLAT_BL2_READ_AHEAD_BASE,
+					  read_ahead.image_size);
+		if (io_result == 0) {
+			VERBOSE("Reading ahead image id=%u\n", image_id);
+			read_ahead.image_id = image_id;
+			read_ahead.pending = true;
+			return;
+		}
+	}
+
+	(void)io_close(read_ahead.image_handle);
+	(void)io_dev_close(read_ahead.dev_handle);
+}
+
+/*******************************************************************************
+ * Wait for the read ahead in progress, if any, and release the storage device
+ * so that it can be used to load other images. The image read stays in the
+ * scratch buffer until BL2 gets to it.
+ ******************************************************************************/
+void load_image_read_ahead_wait(void)
+{
+	size_t bytes_read = 0U;
+	int io_result;
+
+	if (!read_ahead.pending) {
+		return;
+	}
+
+	do {
+		io_result = io_read_poll(read_ahead.image_handle, &bytes_read);
+	} while (io_result == -EAGAIN);
+
+	if ((io_result != 0) || (bytes_read < read_ahead.image_size)) {
+		WARN("Failed to read ahead image id=%u (%i)\n",
+		     read_ahead.image_id, io_result);
+		read_ahead.image_id = INVALID_IMAGE_ID;
+	}
+
+	(void)io_close(read_ahead.image_handle);
+	(void)io_dev_close(read_ahead.dev_handle);
+	read_ahead.pending = false;
+}
+
+/* Copy the image held in the scratch buffer to its load address */
+static int read_ahead_load(unsigned int image_id, image_info_t *image_data)
+{
+	assert(read_ahead.image_id == image_id);
+
+	read_ahead.image_id = INVALID_IMAGE_ID;
+
+	if (read_ahead.image_size > image_data->image_max_size) {
+		WARN("Image id=%u size out of bounds\n", image_id);
+		return -EFBIG;
+	}
+
+	image_data->image_size = (uint32_t)read_ahead.image_size;
+	(void)memcpy((void *)image_data->image_base,
+		     (void *)PLAT_BL2_READ_AHEAD_BASE, read_ahead.image_size);
+
+	INFO("Image id=%u loaded: 0x%lx - 0x%lx\n", image_id,
+	     image_data->image_base,
+	     (uintptr_t)(image_data->image_base + image_data->image_size));
+
+	return 0;
+}
+#endif /* IMAGE_READ_AHEAD */
+
 /*******************************************************************************
  * Internal function to load an image at a specific address given
  * an image ID and extents of free memory.
@@ -76,15 +211,26 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	size_t image_size;
 	size_t bytes_read;
 	int io_result;
+	int tl;
 
 	assert(image_data != NULL);
 	assert(image_data->h.version >= VERSION_2);
 
 	image_base = image_data->image_base;
 
+#if IMAGE_READ_AHEAD
+	/* The storage device can't be shared with a read ahead in progress */
+	load_image_read_ahead_wait();
+	if (read_ahead.image_id == image_id) {
+		return read_ahead_load(image_id, image_data);
+	}
+#endif
+
 	/* Obtain a reference to the image by querying the platform layer */
+	tl = PMF_TL_BEGIN("open", image_id);
 	io_result = plat_get_image_source(image_id, &dev_handle, &image_spec);
 	if (io_result != 0) {
+		PMF_TL_END(tl);
 		WARN("Failed to obtain reference to image id=%u (%i)\n",
 			image_id, io_result);
 		return io_result;
@@ -92,6 +238,7 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* Attempt to access the image */
 	io_result = io_open(dev_handle, image_spec, &image_handle);
+	PMF_TL_END(tl);
 	if (io_result != 0) {
 		WARN("Failed to access image id=%u (%i)\n",
 			image_id, io_result);
@@ -123,7 +270,9 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
+	tl = PMF_TL_BEGIN("read", image_id);
 	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+	PMF_TL_END(tl);
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
@@ -172,6 +321,7 @@ static int load_auth_image_recursive(unsigned int image_id,
 				    int is_parent_image)
 {
 	int rc;
+	int tl;
 	unsigned int parent_id;
 
 	/* Use recursion to authenticate parent images */
@@ -189,10 +339,18 @@ static int load_auth_image_recursive(unsigned int image_id,
 		return rc;
 	}
 
+#if IMAGE_READ_AHEAD
+	if (is_parent_image == 0) {
+		read_ahead_start();
+	}
+#endif
+
 	/* Authenticate it */
+	tl = PMF_TL_BEGIN("auth", image_id);
 	rc = auth_mod_verify_img(image_id,
 				 (void *)image_data->image_base,
 				 image_data->image_size);
+	PMF_TL_END(tl);
 	if (rc != 0) {
 		/* Authentication error, zero memory and flush it right away. */
 		zero_normalmem((void *)image_data->image_base,
@@ -233,13 +391,22 @@ static int load_auth_image_recursive(unsigned int image_id,
 static int load_auth_image_internal(unsigned int image_id,
 				    image_info_t *image_data)
 {
+	int rc;
+
 #if TRUSTED_BOARD_BOOT
 	if (dyn_is_auth_disabled() == 0) {
 		return load_auth_image_recursive(image_id, image_data, 0);
 	}
 #endif
 
-	return load_image_flush(image_id, image_data);
+	rc = load_image_flush(image_id, image_data);
+#if IMAGE_READ_AHEAD
+	if (rc == 0) {
+		read_ahead_start();
+	}
+#endif
+
+	return rc;
 }
 
 /*******************************************************************************
@@ -252,6 +419,9 @@ static int load_auth_image_internal(unsigned int image_id,
 int load_auth_image(unsigned int image_id, image_info_t *image_data)
 {
 	int err;
+	int tl;
+
+	tl = PMF_TL_BEGIN("load", image_id);
 
 /*
  * All firmware banks should be part of the same non-volatile storage as per
@@ -266,6 +436,8 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 	} while ((err != 0) && (plat_try_next_boot_source() != 0));
 #endif /* PSA_FWU_SUPPORT */
 
+	PMF_TL_END(tl);
+
 	return err;
 }
 
@@ -5,16 +5,24 @@
  */
 
 #include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 
-#include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/image_decompress.h>
+#include <drivers/io/io_storage.h>
+#include <lib/pmf/pmf_timeline.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
 
 static uintptr_t decompressor_buf_base;
 static uint32_t decompressor_buf_size;
 static decompressor_t *decompressor;
+static bool decompress_in_place;
 static struct image_info saved_image_info;
 
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
@@ -23,10 +31,22 @@ void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 	decompressor_buf_base = buf_base;
 	decompressor_buf_size = buf_size;
 	decompressor = _decompressor;
+	decompress_in_place = false;
+}
+
+void image_decompress_init_in_place(uintptr_t work_base, uint32_t work_size,
+				    decompressor_t *_decompressor)
+{
+	decompressor_buf_base = work_base;
+	decompressor_buf_size = work_size;
+	decompressor = _decompressor;
+	decompress_in_place = true;
 }
 
 void image_decompress_prepare(struct image_info *info)
 {
+	assert(!decompress_in_place);
+
 	/*
 	 * If the image is compressed, it should be loaded into the temporary
 	 * buffer instead of its final destination.  We save image_info, then
@@ -38,11 +58,63 @@ void image_decompress_prepare(struct image_info *info)
 	info->image_max_size = decompressor_buf_size;
 }
 
+int image_decompress_prepare_in_place(unsigned int image_id,
+				      struct image_info *info)
+{
+	uintptr_t dev_handle, image_handle, image_spec;
+	uintptr_t window_end, load_base;
+	size_t image_size;
+	int ret;
+
+	assert(decompress_in_place);
+
+	/*
+	 * Look up the size of the compressed image so that it can be loaded
+	 * at the very end of its destination window.  The decompressor then
+	 * writes its output from the start of the window, consuming the input
+	 * ahead of it, and no temporary buffer for the compressed data is
+	 * needed.
+	 */
+	ret = plat_get_image_source(image_id, &dev_handle, &image_spec);
+	if (ret != 0)
+		return ret;
+
+	ret = io_open(dev_handle, image_spec, &image_handle);
+	if (ret == 0) {
+		ret = io_size(image_handle, &image_size);
+		(void)io_close(image_handle);
+	}
+
+	/* As in load_image(), the device is not kept open across images */
+	(void)io_dev_close(dev_handle);
+	if (ret != 0)
+		return ret;
+
+	if ((image_size == 0U) || (image_size > info->image_max_size)) {
+		WARN("Compressed image id=%u does not fit (0x%zx > 0x%x)\n",
+		     image_id, image_size, info->image_max_size);
+		return -ENOMEM;
+	}
+
+	window_end = info->image_base + info->image_max_size;
+	load_base = round_down(window_end - image_size,
+			       CACHE_WRITEBACK_GRANULE);
+	if (load_base < info->image_base)
+		load_base = info->image_base;
+
+	saved_image_info = *info;
+	info->image_base = load_base;
+	info->image_max_size = window_end - load_base;
+
+	return 0;
+}
+
 int image_decompress(struct image_info *info)
 {
 	uintptr_t compressed_image_base, image_base, work_base;
 	uint32_t compressed_image_size, work_size;
 	int ret;
+	int tl;
 
 	/*
 	 * The size of compressed data has been filled by load_image().
@@ -52,20 +124,34 @@ int image_decompress(struct image_info *info)
 	compressed_image_base = info->image_base;
 	*info = saved_image_info;
 
-	assert(compressed_image_size <= decompressor_buf_size);
-
 	image_base = info->image_base;
 
+	if (decompress_in_place) {
+		/* The whole buffer is available as workspace. */
+		work_base = decompressor_buf_base;
+		work_size = decompressor_buf_size;
+	} else {
+		assert(compressed_image_size <= decompressor_buf_size);
+
+		/*
+		 * Use the rest of the temporary buffer as workspace of the
+		 * decompressor since the decompressor may need additional
+		 * memory.
+		 */
+		work_base = compressed_image_base + compressed_image_size;
+		work_size = decompressor_buf_size - compressed_image_size;
+	}
+
 	/*
-	 * Use the rest of the temporary buffer as workspace of the
-	 * decompressor since the decompressor may need additional memory.
+	 * The decompressor cleans its output to the PoC chunk by chunk while
+	 * it is still hot in the cache, so no final cache maintenance over
+	 * the whole image is needed here.
 	 */
-	work_base = compressed_image_base + compressed_image_size;
-	work_size = decompressor_buf_size - compressed_image_size;
-
+	tl = PMF_TL_BEGIN("decompress", 0U);
 	ret = decompressor(&compressed_image_base, compressed_image_size,
 			   &image_base, info->image_max_size,
 			   work_base, work_size);
+	PMF_TL_END(tl);
 	if (ret) {
 		ERROR("Failed to decompress image (err=%d)\n", ret);
 		return ret;
@@ -74,7 +160,5 @@ int image_decompress(struct image_info *info)
 	/* image_base is updated to the final pos when decompressor() exits. */
 	info->image_size = image_base - info->image_base;
 
-	flush_dcache_range(info->image_base, info->image_size);
-
 	return 0;
 }
@@ -1,15 +1,19 @@
 /*
- * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
+#include <platform_def.h>
+
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <plat/common/platform.h>
 
 /*******************************************************************************
  * The 'rt_svc_descs' array holds the runtime service descriptors exported by
@@ -152,3 +156,214 @@ void __init runtime_svc_init(void)
 			rt_svc_descs_indices[start_idx] = index;
 	}
 }
+
+/*******************************************************************************
+ * The 'rt_svc_fid_descs' array holds the descriptors of the handlers of single
+ * SMC function IDs, placed in the 'rt_svc_fid_descs' linker section by runtime
+ * services that use rt_svc_fid_lookup() to dispatch their calls. They are
+ * indexed in two levels:
+ * - 'rt_svc_fid_owners' gives the slot of the unique oen of a function ID in
+ *   'rt_svc_fid_funcs', which is indexed by the SMC64 bit and the function
+ *   number. Its entries are either the index of a descriptor or, with
+ *   RT_SVC_FID_SUB_TABLE set, the index of a table in 'rt_svc_fid_subs'.
+ * - 'rt_svc_fid_subs' is indexed by the sub-command passed in x1. Its last
+ *   entry is used for the other sub-commands.
+ ******************************************************************************/
+#define RT_SVC_FID_MAX_OWNERS	U(2)
+#define RT_SVC_FID_NUM_FUNCS	U(256)
+#define RT_SVC_FID_MAX_SUB_TBLS	U(16)
+#define RT_SVC_FID_NUM_SUBS	U(32)
+#define RT_SVC_FID_MAX_DESCS	U(64)
+
+#define RT_SVC_FID_INVALID	U(0xff)
+#define RT_SVC_FID_SUB_TABLE	U(0x80)
+
+#define RT_SVC_FID_DESCS_NUM	((RT_SVC_FID_DESCS_END - \
+					RT_SVC_FID_DESCS_START) / \
+					sizeof(rt_svc_fid_desc_t))
+
+static uint8_t rt_svc_fid_owners[MAX_RT_SVCS];
+static uint8_t rt_svc_fid_funcs[RT_SVC_FID_MAX_OWNERS][2]
+			       [RT_SVC_FID_NUM_FUNCS];
+static uint8_t rt_svc_fid_subs[RT_SVC_FID_MAX_SUB_TBLS]
+			      [RT_SVC_FID_NUM_SUBS + 1U];
+static uint32_t rt_svc_fid_calls[PLATFORM_CORE_COUNT][RT_SVC_FID_MAX_DESCS];
+static bool rt_svc_fid_ready;
+
+static uint8_t *rt_svc_fid_func_entry(uint32_t smc_fid)
+{
+	unsigned int owner;
+
+	owner = rt_svc_fid_owners[get_unique_oen_from_smc_fid(smc_fid)];
+	if ((owner == RT_SVC_FID_INVALID) ||
+	    (GET_SMC_NUM(smc_fid) >= RT_SVC_FID_NUM_FUNCS)) {
+		return NULL;
+	}
+
+	return &rt_svc_fid_funcs[owner][GET_SMC_CC(smc_fid)]
+				[GET_SMC_NUM(smc_fid)];
+}
+
+/*******************************************************************************
+ * This function builds the index of the SMC function ID descriptors. It must
+ * be called by the runtime services using rt_svc_fid_lookup() from their
+ * initialisation routine. An invalid or duplicated descriptor is an error.
+ ******************************************************************************/
+void __init rt_svc_fid_init(void)
+{
+	const rt_svc_fid_desc_t *descs;
+	unsigned int index, uoen, num_owners = 0U, num_subs = 0U;
+	uint8_t *entry, *sub;
+
+	if (rt_svc_fid_ready) {
+		return;
+	}
+
+	assert((RT_SVC_FID_DESCS_END >= RT_SVC_FID_DESCS_START) &&
+	       (RT_SVC_FID_DESCS_NUM <= RT_SVC_FID_MAX_DESCS));
+
+	(void)memset(rt_svc_fid_owners, -1, sizeof(rt_svc_fid_owners));
+	(void)memset(rt_svc_fid_funcs, -1, sizeof(rt_svc_fid_funcs));
+	(void)memset(rt_svc_fid_subs, -1, sizeof(rt_svc_fid_subs));
+
+	descs = (const rt_svc_fid_desc_t *)RT_SVC_FID_DESCS_START;
+	for (index = 0U; index < RT_SVC_FID_DESCS_NUM; index++) {
+		const rt_svc_fid_desc_t *desc = &descs[index];
+
+		if ((desc->handle == NULL) ||
+		    (GET_SMC_NUM(desc->smc_fid) >= RT_SVC_FID_NUM_FUNCS)) {
+			ERROR("Invalid SMC function descriptor %s\n",
+			      desc->name);
+			panic();
+		}
+
+		uoen = get_unique_oen_from_smc_fid(desc->smc_fid);
+		if (rt_svc_fid_owners[uoen] == RT_SVC_FID_INVALID) {
+			if (num_owners == RT_SVC_FID_MAX_OWNERS) {
+				ERROR("Too many SMC function descriptor owners\n");
+				panic();
+			}
+			rt_svc_fid_owners[uoen] = (uint8_t)num_owners++;
+		}
+
+		entry = rt_svc_fid_func_entry(desc->smc_fid);
+		if (desc->sub_cmd == RT_SVC_FID_ANY_SUB) {
+			if (*entry == RT_SVC_FID_INVALID) {
+				*entry = (uint8_t)index;
+				continue;
+			}
+			if ((*entry & RT_SVC_FID_SUB_TABLE) == 0U) {
+				goto duplicate;
+			}
+			sub = &rt_svc_fid_subs[*entry & ~RT_SVC_FID_SUB_TABLE]
+					      [RT_SVC_FID_NUM_SUBS];
+		} else {
+			if (desc->sub_cmd >= RT_SVC_FID_NUM_SUBS) {
+				ERROR("Invalid SMC function descriptor %s\n",
+				      desc->name);
+				panic();
+			}
+			/* Move a catch-all handler to a new sub-command table */
+			if ((*entry == RT_SVC_FID_INVALID) ||
+			    ((*entry & RT_SVC_FID_SUB_TABLE) == 0U)) {
+				if (num_subs == RT_SVC_FID_MAX_SUB_TBLS) {
+					ERROR("Too many SMC sub-command tables\n");
+					panic();
+				}
+				rt_svc_fid_subs[num_subs][RT_SVC_FID_NUM_SUBS] =
+					*entry;
+				*entry = (uint8_t)(RT_SVC_FID_SUB_TABLE |
+						   num_subs++);
+			}
+			sub = &rt_svc_fid_subs[*entry & ~RT_SVC_FID_SUB_TABLE]
+					      [desc->sub_cmd];
+		}
+
+		if (*sub != RT_SVC_FID_INVALID) {
+			goto duplicate;
+		}
+		*sub = (uint8_t)index;
+		continue;
+
+duplicate:
+		ERROR("Duplicate SMC function descriptor %s\n", desc->name);
+		panic();
+	}
+
+	rt_svc_fid_ready = true;
+}
+
+/*******************************************************************************
+ * This function returns the descriptor of the handler of 'smc_fid' with the
+ * sub-command 'x1', or NULL if there is none, and counts the call.
+ ******************************************************************************/
+const rt_svc_fid_desc_t *rt_svc_fid_lookup(uint32_t smc_fid, u_register_t x1)
+{
+	const rt_svc_fid_desc_t *descs;
+	const uint8_t *entry;
+	unsigned int index;
+
+	assert(rt_svc_fid_ready);
+
+	entry = rt_svc_fid_func_entry(smc_fid);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	index = *entry;
+	if ((index != RT_SVC_FID_INVALID) &&
+	    ((index & RT_SVC_FID_SUB_TABLE) != 0U)) {
+		const uint8_t *subs =
+			rt_svc_fid_subs[index & ~RT_SVC_FID_SUB_TABLE];
+
+		index = RT_SVC_FID_INVALID;
+		if (x1 < RT_SVC_FID_NUM_SUBS) {
+			index = subs[x1];
+		}
+		if (index == RT_SVC_FID_INVALID) {
+			index = subs[RT_SVC_FID_NUM_SUBS];
+		}
+	}
+
+	if (index == RT_SVC_FID_INVALID) {
+		return NULL;
+	}
+
+	descs = (const rt_svc_fid_desc_t *)RT_SVC_FID_DESCS_START;
+	if (descs[index].smc_fid != smc_fid) {
+		return NULL;
+	}
+
+	rt_svc_fid_calls[plat_my_core_pos()][index]++;
+
+	return &descs[index];
+}
+
+/*******************************************************************************
+ * This function returns the number of calls handled by the descriptor of
+ * 'smc_fid' and 'sub_cmd' on all CPUs.
+ ******************************************************************************/
+uint64_t rt_svc_fid_call_count(uint32_t smc_fid, uint32_t sub_cmd)
+{
+	const rt_svc_fid_desc_t *descs;
+	uint64_t count = 0U;
+	unsigned int index, cpu;
+
+	descs = (const rt_svc_fid_desc_t *)RT_SVC_FID_DESCS_START;
+	for (index = 0U; index < RT_SVC_FID_DESCS_NUM; index++) {
+		if ((descs[index].smc_fid == smc_fid) &&
+		    (descs[index].sub_cmd == sub_cmd)) {
+			break;
+		}
+	}
+
+	if (index == RT_SVC_FID_DESCS_NUM) {
+		return 0U;
+	}
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		count += rt_svc_fid_calls[cpu][index];
+	}
+
+	return count;
+}
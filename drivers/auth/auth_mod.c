@@ -10,6 +10,8 @@
 
 #include <platform_def.h>
 
+#include <arch_helpers.h>
+#include <bl2/bl2.h>
 #include <common/debug.h>
 #include <common/tbbr/cot_def.h>
 #include <drivers/auth/auth_common.h>
@@ -18,6 +20,7 @@
 #include <drivers/auth/img_parser_mod.h>
 #include <drivers/fwu/fwu.h>
 #include <lib/fconf/fconf_tbbr_getter.h>
+#include <lib/utils.h>
 #include <plat/common/platform.h>
 
 /* ASN.1 tags */
@@ -118,6 +121,78 @@ static int auth_hash(const auth_method_param_hash_t *param,
 	return rc;
 }
 
+#if BL2_PARALLEL_AUTH && defined(IMAGE_BL2)
+/*
+ * Hash check of a raw image handed over to a BL2 worker. The expected hash is
+ * copied because the buffer of the parent certificate is reused for the next
+ * certificate before the check runs.
+ */
+typedef struct auth_deferred_hash {
+	void *data_ptr;
+	unsigned int data_len;
+	void *img;
+	unsigned int img_len;
+	unsigned int hash_der_len;
+	uint8_t hash_der[HASH_DER_LEN];
+} auth_deferred_hash_t;
+
+static auth_deferred_hash_t auth_deferred_hash[MAX_NUMBER_IDS];
+
+static int auth_deferred_hash_check(void *arg)
+{
+	auth_deferred_hash_t *job = arg;
+	int rc;
+
+	rc = crypto_mod_verify_hash(job->data_ptr, job->data_len,
+				    job->hash_der, job->hash_der_len);
+	if (rc != 0) {
+		/*
+		 * Same as load_auth_image() does for images checked right
+		 * away. The boot CPU reports the failure, as the console is
+		 * not meant to be shared.
+		 */
+		zeromem(job->img, job->img_len);
+		flush_dcache_range((uintptr_t)job->img, job->img_len);
+	}
+
+	return rc;
+}
+
+/*
+ * Same as auth_hash() but the hash of the image is only checked by a BL2
+ * worker. BL2 makes sure all checks have passed before it hands over to the
+ * next image.
+ */
+static int auth_hash_deferred(const auth_method_param_hash_t *param,
+			      const auth_img_desc_t *img_desc,
+			      void *img, unsigned int img_len)
+{
+	auth_deferred_hash_t *job = &auth_deferred_hash[img_desc->img_id];
+	void *hash_der_ptr;
+	unsigned int hash_der_len;
+	int rc;
+
+	rc = auth_get_param(param->hash, img_desc->parent,
+			&hash_der_ptr, &hash_der_len);
+	return_if_error(rc);
+
+	if (hash_der_len > sizeof(job->hash_der)) {
+		return auth_hash(param, img_desc, img, img_len);
+	}
+
+	rc = img_parser_get_auth_param(img_desc->img_type, param->data,
+			img, img_len, &job->data_ptr, &job->data_len);
+	return_if_error(rc);
+
+	(void)memcpy(job->hash_der, hash_der_ptr, hash_der_len);
+	job->hash_der_len = hash_der_len;
+	job->img = img;
+	job->img_len = img_len;
+
+	return bl2_work_queue(auth_deferred_hash_check, job);
+}
+#endif /* BL2_PARALLEL_AUTH && IMAGE_BL2 */
+
 /*
  * Authenticate by digital signature
  *
@@ -383,6 +458,15 @@ int auth_mod_verify_img(unsigned int img_id,
 			rc = 0;
 			break;
 		case AUTH_METHOD_HASH:
+#if BL2_PARALLEL_AUTH && defined(IMAGE_BL2)
+			/* Certificates are used right away, never defer them */
+			if ((img_desc->img_type == IMG_RAW) &&
+			    bl2_plat_defer_image_auth(img_id)) {
+				rc = auth_hash_deferred(&auth_method->param.hash,
+						img_desc, img_ptr, img_len);
+				break;
+			}
+#endif
 			rc = auth_hash(&auth_method->param.hash,
 					img_desc, img_ptr, img_len);
 			break;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -20,6 +20,9 @@
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/auth/mbedtls/mbedtls_common.h>
 #include <drivers/auth/mbedtls/mbedtls_config.h>
+#if AUTH_SIG_CACHE
+#include <drivers/auth/mbedtls/mbedtls_sig_cache.h>
+#endif
 #include <plat/common/platform.h>
 
 #define LIB_NAME		"mbed TLS"
@@ -48,6 +51,10 @@ static void init(void)
 {
 	/* Initialize mbed TLS */
 	mbedtls_init();
+
+#if AUTH_SIG_CACHE
+	sig_cache_init();
+#endif
 }
 
 /*
@@ -71,6 +78,18 @@ static int verify_signature(void *data_ptr, unsigned int data_len,
 	const mbedtls_md_info_t *md_info;
 	unsigned char *p, *end;
 	unsigned char hash[MBEDTLS_MD_MAX_SIZE];
+#if AUTH_SIG_CACHE
+	uint8_t cache_digest[SIG_CACHE_DIGEST_SIZE];
+	bool cacheable;
+
+	/* Skip the asymmetric operation if this check already passed */
+	cacheable = sig_cache_digest(data_ptr, data_len, sig_ptr, sig_len,
+				     sig_alg, sig_alg_len, pk_ptr, pk_len,
+				     cache_digest) == 0;
+	if (cacheable && sig_cache_lookup(cache_digest)) {
+		return CRYPTO_SUCCESS;
+	}
+#endif
 
 	/* Get pointers to signature OID and parameters */
 	p = (unsigned char *)sig_alg;
@@ -131,6 +150,11 @@ static int verify_signature(void *data_ptr, unsigned int data_len,
 
 	/* Signature verification success */
 	rc = CRYPTO_SUCCESS;
+#if AUTH_SIG_CACHE
+	if (cacheable) {
+		sig_cache_insert(cache_digest);
+	}
+#endif
 
 end1:
 	mbedtls_pk_free(&pk);
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2015-2017, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -9,3 +9,7 @@ include drivers/auth/mbedtls/mbedtls_common.mk
 MBEDTLS_SOURCES	+=		drivers/auth/mbedtls/mbedtls_crypto.c
 
 
+
+ifeq (${AUTH_SIG_CACHE},1)
+MBEDTLS_SOURCES	+=		drivers/auth/mbedtls/mbedtls_sig_cache.c
+endif
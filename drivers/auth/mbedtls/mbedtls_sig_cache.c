@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* mbed TLS headers */
+#include <mbedtls/md.h>
+#include <mbedtls/sha256.h>
+
+#include <common/debug.h>
+#include <drivers/auth/mbedtls/mbedtls_config.h>
+#include <drivers/auth/mbedtls/mbedtls_sig_cache.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+
+/*
+ * Signature verification result cache.
+ *
+ * Each entry is the SHA-256 of a (data, signature, algorithm, public key)
+ * tuple which has already gone through a full asymmetric verification. As the
+ * verification result only depends on those four inputs, finding the tuple in
+ * the cache on a later boot is enough to know that the signature is good.
+ *
+ * The cache lives in platform storage, so it is protected by an HMAC-SHA256
+ * computed with a device-unique key provided by the platform. A cache that
+ * does not authenticate is discarded and every signature is checked again.
+ * New entries are only kept in memory by sig_cache_insert(); the boot stage
+ * writes them back once, with sig_cache_flush(), after its images are loaded.
+ */
+
+#define SIG_CACHE_MAGIC		U(0x48434753)	/* "SGCH" */
+#define SIG_CACHE_VERSION	U(1)
+
+typedef struct sig_cache_blob {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;
+	uint32_t next;
+	uint8_t digest[SIG_CACHE_ENTRIES][SIG_CACHE_DIGEST_SIZE];
+	uint8_t mac[SIG_CACHE_DIGEST_SIZE];
+} sig_cache_blob_t;
+
+static sig_cache_blob_t sig_cache;
+static bool sig_cache_enabled;
+static bool sig_cache_dirty;
+
+/*
+ * Compute the MAC of the cache contents (everything but the MAC itself).
+ */
+static int sig_cache_mac(uint8_t mac[SIG_CACHE_DIGEST_SIZE])
+{
+	const mbedtls_md_info_t *md_info;
+	uint8_t *key;
+	size_t key_len;
+	int rc;
+
+	rc = plat_get_sig_cache_key(&key, &key_len);
+	if ((rc != 0) || (key == NULL) || (key_len == 0U)) {
+		return -1;
+	}
+
+	md_info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+	if (md_info == NULL) {
+		return -1;
+	}
+
+	rc = mbedtls_md_hmac(md_info, key, key_len,
+			     (const unsigned char *)&sig_cache,
+			     offsetof(sig_cache_blob_t, mac), mac);
+
+	return (rc == 0) ? 0 : -1;
+}
+
+/*
+ * Compare two MACs without leaking the position of the first difference.
+ */
+static bool sig_cache_mac_equal(const uint8_t *a, const uint8_t *b)
+{
+	uint8_t diff = 0U;
+	unsigned int i;
+
+	for (i = 0U; i < SIG_CACHE_DIGEST_SIZE; i++) {
+		diff |= a[i] ^ b[i];
+	}
+
+	return diff == 0U;
+}
+
+static void sig_cache_reset(void)
+{
+	zeromem(&sig_cache, sizeof(sig_cache));
+	sig_cache.magic = SIG_CACHE_MAGIC;
+	sig_cache.version = SIG_CACHE_VERSION;
+}
+
+/*
+ * Load the cache from platform storage. Any failure leaves an empty cache, so
+ * that all signatures are verified in full.
+ */
+void sig_cache_init(void)
+{
+	uint8_t mac[SIG_CACHE_DIGEST_SIZE];
+
+	if (sig_cache_enabled) {
+		return;
+	}
+
+	if (sig_cache_mac(mac) != 0) {
+		WARN("Signature cache disabled: no device key\n");
+		return;
+	}
+	sig_cache_enabled = true;
+
+	if (plat_sig_cache_read(&sig_cache, sizeof(sig_cache)) != 0) {
+		VERBOSE("Signature cache: nothing stored\n");
+		sig_cache_reset();
+		return;
+	}
+
+	if ((sig_cache.magic != SIG_CACHE_MAGIC) ||
+	    (sig_cache.version != SIG_CACHE_VERSION) ||
+	    (sig_cache.count > SIG_CACHE_ENTRIES) ||
+	    (sig_cache.next >= SIG_CACHE_ENTRIES) ||
+	    (sig_cache_mac(mac) != 0) ||
+	    !sig_cache_mac_equal(mac, sig_cache.mac)) {
+		WARN("Signature cache: stored cache is invalid, discarding\n");
+		sig_cache_reset();
+		return;
+	}
+
+	VERBOSE("Signature cache: %u entries\n", sig_cache.count);
+}
+
+static int sig_cache_update(mbedtls_sha256_context *ctx, const void *ptr,
+			    unsigned int len)
+{
+	uint8_t len_le[4];
+	int rc;
+
+	/* Prefix each field with its length so fields cannot be re-split */
+	len_le[0] = (uint8_t)len;
+	len_le[1] = (uint8_t)(len >> 8);
+	len_le[2] = (uint8_t)(len >> 16);
+	len_le[3] = (uint8_t)(len >> 24);
+
+	rc = mbedtls_sha256_update_ret(ctx, len_le, sizeof(len_le));
+	if (rc == 0) {
+		rc = mbedtls_sha256_update_ret(ctx, ptr, len);
+	}
+
+	return rc;
+}
+
+/*
+ * Compute the cache key of a signature check. Returns 0 on success.
+ */
+int sig_cache_digest(const void *data_ptr, unsigned int data_len,
+		     const void *sig_ptr, unsigned int sig_len,
+		     const void *sig_alg, unsigned int sig_alg_len,
+		     const void *pk_ptr, unsigned int pk_len,
+		     uint8_t digest[SIG_CACHE_DIGEST_SIZE])
+{
+	mbedtls_sha256_context ctx;
+	int rc;
+
+	if (!sig_cache_enabled) {
+		return -1;
+	}
+
+	mbedtls_sha256_init(&ctx);
+	rc = mbedtls_sha256_starts_ret(&ctx, 0);
+	if (rc == 0) {
+		rc = sig_cache_update(&ctx, data_ptr, data_len);
+	}
+	if (rc == 0) {
+		rc = sig_cache_update(&ctx, sig_ptr, sig_len);
+	}
+	if (rc == 0) {
+		rc = sig_cache_update(&ctx, sig_alg, sig_alg_len);
+	}
+	if (rc == 0) {
+		rc = sig_cache_update(&ctx, pk_ptr, pk_len);
+	}
+	if (rc == 0) {
+		rc = mbedtls_sha256_finish_ret(&ctx, digest);
+	}
+	mbedtls_sha256_free(&ctx);
+
+	return (rc == 0) ? 0 : -1;
+}
+
+bool sig_cache_lookup(const uint8_t digest[SIG_CACHE_DIGEST_SIZE])
+{
+	unsigned int i;
+
+	if (!sig_cache_enabled) {
+		return false;
+	}
+
+	for (i = 0U; i < sig_cache.count; i++) {
+		if (memcmp(sig_cache.digest[i], digest,
+			   SIG_CACHE_DIGEST_SIZE) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Record a successful signature check. Entries are replaced in round-robin
+ * order once the cache is full. The cache is only marked dirty here, storage
+ * is not accessed until sig_cache_flush().
+ */
+void sig_cache_insert(const uint8_t digest[SIG_CACHE_DIGEST_SIZE])
+{
+	if (!sig_cache_enabled || sig_cache_lookup(digest)) {
+		return;
+	}
+
+	memcpy(sig_cache.digest[sig_cache.next], digest,
+	       SIG_CACHE_DIGEST_SIZE);
+	sig_cache.next = (sig_cache.next + 1U) % SIG_CACHE_ENTRIES;
+	if (sig_cache.count < SIG_CACHE_ENTRIES) {
+		sig_cache.count++;
+	}
+
+	sig_cache_dirty = true;
+}
+
+/*
+ * Write the cache back to platform storage if it changed since it was loaded.
+ * Called once all the images of the boot stage have been loaded.
+ */
+void sig_cache_flush(void)
+{
+	if (!sig_cache_enabled || !sig_cache_dirty) {
+		return;
+	}
+
+	if (sig_cache_mac(sig_cache.mac) != 0) {
+		WARN("Signature cache: cannot compute MAC\n");
+		return;
+	}
+
+	if (plat_sig_cache_write(&sig_cache, sizeof(sig_cache)) != 0) {
+		WARN("Signature cache: cannot store cache\n");
+		return;
+	}
+
+	sig_cache_dirty = false;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <drivers/ring_console.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+
+CASSERT(IS_POWER_OF_TWO(CONSOLE_RING_SIZE), assert_console_ring_size);
+
+/*
+ * Each CPU only writes to its own ring, so no lock is needed on the write
+ * side. The readers use the head, published after the characters it covers,
+ * to know which characters are valid, and check it again after copying them
+ * to detect the ones overwritten meanwhile. The last slot before the oldest
+ * character is never read as it may be in the middle of being overwritten.
+ */
+typedef struct console_ring {
+	/* Number of characters written to the ring */
+	volatile uint64_t head;
+	/* Position up to which the ring was drained */
+	uint64_t drained;
+	char buf[CONSOLE_RING_SIZE];
+} __aligned(CACHE_WRITEBACK_GRANULE) console_ring_t;
+
+static console_ring_t console_rings[PLATFORM_CORE_COUNT];
+static spinlock_t console_ring_drain_lock;
+
+static int console_ring_putc(int c, console_t *console)
+{
+	console_ring_t *ring;
+	uint64_t head;
+
+	/*
+	 * Only write with the data cache enabled, so that the ring is never
+	 * out of sync with the cached copy the readers see. What is printed
+	 * before on the warm boot path is lost.
+	 */
+	if ((read_sctlr_el3() & SCTLR_C_BIT) == 0U)
+		return c;
+
+	ring = &console_rings[plat_my_core_pos()];
+	head = ring->head;
+	ring->buf[head & (CONSOLE_RING_SIZE - 1U)] = (char)c;
+
+	/* Make the character visible before the head that covers it */
+	dmbishst();
+	ring->head = head + 1U;
+
+	return c;
+}
+
+static void console_ring_flush(console_t *console)
+{
+	console_ring_drain();
+}
+
+static console_t console_ring = {
+	.putc = console_ring_putc,
+	.flush = console_ring_flush,
+};
+
+int console_ring_register(void)
+{
+	console_set_scope(&console_ring, CONSOLE_FLAG_RUNTIME);
+
+	return console_register(&console_ring);
+}
+
+size_t console_ring_read(unsigned int cpu, uint64_t *pos, char *buf,
+			 size_t len)
+{
+	const console_ring_t *ring;
+	uint64_t head, start;
+	size_t i, n;
+
+	assert(cpu < PLATFORM_CORE_COUNT);
+	ring = &console_rings[cpu];
+
+	do {
+		head = ring->head;
+		/* Read the characters after the head that covers them */
+		dmbishld();
+
+		start = *pos;
+		if ((start > head) || ((head - start) >= CONSOLE_RING_SIZE))
+			start = (head >= CONSOLE_RING_SIZE) ?
+				(head - CONSOLE_RING_SIZE + 1U) : 0U;
+
+		n = MIN(len, (size_t)(head - start));
+		for (i = 0U; i < n; i++)
+			buf[i] = ring->buf[(start + i) & (CONSOLE_RING_SIZE - 1U)];
+
+		/* Start again if some of them were overwritten meanwhile */
+		dmbishld();
+	} while ((ring->head - start) >= CONSOLE_RING_SIZE);
+
+	*pos = start + n;
+
+	return n;
+}
+
+/* Output a character on all the consoles registered for the crash state */
+static void console_ring_drain_putc(int c)
+{
+	console_t *console;
+
+	for (console = console_list; console != NULL; console = console->next) {
+		if (((console->flags & CONSOLE_FLAG_CRASH) == 0U) ||
+		    (console->putc == NULL))
+			continue;
+
+		if ((c == '\n') &&
+		    ((console->flags & CONSOLE_FLAG_TRANSLATE_CRLF) != 0U))
+			(void)console->putc('\r', console);
+		(void)console->putc(c, console);
+	}
+}
+
+void console_ring_drain(void)
+{
+	console_t *console;
+	unsigned int cpu;
+	char buf[64];
+	size_t i, n;
+
+	spin_lock(&console_ring_drain_lock);
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		do {
+			n = console_ring_read(cpu, &console_rings[cpu].drained,
+					      buf, sizeof(buf));
+			for (i = 0U; i < n; i++)
+				console_ring_drain_putc(buf[i]);
+		} while (n != 0U);
+	}
+
+	for (console = console_list; console != NULL; console = console->next) {
+		if (((console->flags & CONSOLE_FLAG_CRASH) != 0U) &&
+		    (console->flush != NULL))
+			console->flush(console);
+	}
+
+	spin_unlock(&console_ring_drain_lock);
+}
@@ -0,0 +1,450 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/delay_timer.h>
+#include <drivers/io/io_encrypted.h>
+#include <lib/cassert.h>
+#include <lib/mmio.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+#include <tools_share/firmware_encrypted.h>
+
+#include <imx_caam_gcm.h>
+
+CASSERT(sizeof(imx_caam_key_id_t) <= ENC_MAX_KEY_SIZE,
+	assert_caam_key_id_size);
+
+/* Controller registers */
+#define CAAM_MCFGR			U(0x004)
+#define MCFGR_PS			BIT_32(16)
+
+/* Job ring registers, each job ring has a 4KB page after the controller's */
+#define CAAM_JR_BASE(_base, _jr)	((_base) + (((_jr) + 1U) * U(0x1000)))
+#define JR_IRBAR			U(0x000)
+#define JR_IRSR				U(0x00c)
+#define JR_IRJAR			U(0x01c)
+#define JR_ORBAR			U(0x020)
+#define JR_ORSR				U(0x02c)
+#define JR_ORJRR			U(0x034)
+#define JR_ORSFR			U(0x03c)
+#define JR_JRINTR			U(0x04c)
+#define JR_JRCFGR_LS			U(0x054)
+#define JR_JRCR				U(0x06c)
+
+#define JRINTR_HALT_MASK		U(0xc)
+#define JRINTR_HALT_IN_PROGRESS		U(0x4)
+#define JRCFGR_LS_IMSK			BIT_32(0)
+#define JRCR_RESET			BIT_32(0)
+
+/* Descriptor commands */
+#define CMD_HEADER			U(0xb0800000)
+#define CMD_KEY_CLASS1			U(0x02000000)
+#define CMD_KEY_CLASS2			U(0x04000000)
+#define KEY_IMM				BIT_32(23)
+#define KEY_ENC				BIT_32(22)
+#define CMD_LOAD_CONTEXT1		U(0x12200000)
+#define CMD_STORE_CONTEXT1		U(0x52200000)
+#define CMD_FIFO_LOAD_CLASS1		U(0x22000000)
+#define FIFOLD_IMM			BIT_32(23)
+#define FIFOLD_EXT			BIT_32(22)
+#define FIFOLD_TYPE_MSG			U(0x00100000)
+#define FIFOLD_TYPE_IV			U(0x00200000)
+#define FIFOLD_TYPE_ICV			U(0x00380000)
+#define FIFOLD_LAST1			U(0x00020000)
+#define FIFOLD_FLUSH1			U(0x00040000)
+#define CMD_FIFO_STORE_MSG_EXT		U(0x60700000)
+#define CMD_SEQ_IN_PTR_EXT		U(0xf0400000)
+#define CMD_SEQ_OUT_PTR_EXT		U(0xf8400000)
+#define CMD_OP_AES_GCM_DEC		U(0x82100900)
+#define OP_AS_UPDATE			U(0x0)
+#define OP_AS_INIT			U(0x4)
+#define OP_AS_FINALIZE			U(0x8)
+#define OP_AS_INITFINAL			U(0xc)
+#define OP_ICV_ON			U(0x2)
+#define CMD_OP_BLOB_DECAP_BLACK		U(0x860d0004)
+
+#define DESC_MAX_WORDS			U(64)
+/* Class 1 context register, which holds the GCM state between two chunks */
+#define CONTEXT1_SIZE			U(64)
+/* Blob key and MAC around the key in a blob */
+#define BLOB_OVERHEAD			U(48)
+#define JOB_TIMEOUT_US			U(100000)
+
+typedef struct caam_gcm {
+	uintptr_t jr_base;
+	unsigned int ptr_size;
+	bool busy;
+	bool init;
+	bool last;
+	bool black;
+	unsigned int key_len;
+	unsigned int iv_len;
+	unsigned int tag_len;
+	uintptr_t buffer;
+	size_t len;
+	uint8_t key[32];
+	uint8_t iv[ENC_MAX_IV_SIZE];
+	uint8_t tag[ENC_MAX_TAG_SIZE];
+} caam_gcm_t;
+
+static caam_gcm_t caam_gcm;
+
+/* Memory accessed by the CAAM, in their own cache lines */
+static uint32_t caam_desc[DESC_MAX_WORDS] __aligned(CACHE_WRITEBACK_GRANULE);
+static uint8_t caam_context[CONTEXT1_SIZE] __aligned(CACHE_WRITEBACK_GRANULE);
+static uint8_t caam_black_key[32] __aligned(CACHE_WRITEBACK_GRANULE);
+static uint64_t caam_in_ring __aligned(CACHE_WRITEBACK_GRANULE);
+static uint32_t caam_out_ring[4] __aligned(CACHE_WRITEBACK_GRANULE);
+
+static void desc_add_word(uint32_t word)
+{
+	unsigned int len = caam_desc[0] & U(0x7f);
+
+	assert(len < DESC_MAX_WORDS);
+
+	caam_desc[len] = word;
+	caam_desc[0]++;
+}
+
+/*
+ * Pointers are 64-bit when the controller is configured so (MCFGR.PS). The
+ * i.MX CAAM then expects their most significant word first.
+ */
+static void desc_add_ptr(uintptr_t ptr)
+{
+	if (caam_gcm.ptr_size == 8U) {
+		desc_add_word((uint32_t)((uint64_t)ptr >> 32));
+		desc_add_word((uint32_t)ptr);
+	} else {
+		assert(((uint64_t)ptr >> 32) == 0U);
+		desc_add_word((uint32_t)ptr);
+	}
+}
+
+static void desc_add_data(const uint8_t *data, unsigned int len)
+{
+	uint32_t word;
+	unsigned int i;
+
+	for (i = 0U; i < len; i += sizeof(word)) {
+		word = 0U;
+		memcpy(&word, &data[i],
+		       MIN(len - i, (unsigned int)sizeof(word)));
+		desc_add_word(word);
+	}
+}
+
+/* Start the job described in caam_desc, on the single slot of the ring */
+static void caam_jr_enqueue(void)
+{
+	/*
+	 * With 32-bit pointers, the ring entry is the low word. With 64-bit
+	 * pointers, the most significant word comes first, as in descriptors.
+	 */
+	if (caam_gcm.ptr_size == 8U) {
+		caam_in_ring = ((uint64_t)(uintptr_t)caam_desc << 32) |
+			       ((uint64_t)(uintptr_t)caam_desc >> 32);
+	} else {
+		caam_in_ring = (uint64_t)(uintptr_t)caam_desc;
+	}
+
+	flush_dcache_range((uintptr_t)caam_desc, sizeof(caam_desc));
+	flush_dcache_range((uintptr_t)&caam_in_ring, sizeof(caam_in_ring));
+	flush_dcache_range((uintptr_t)caam_out_ring, sizeof(caam_out_ring));
+	dsbsy();
+
+	mmio_write_32(caam_gcm.jr_base + JR_IRJAR, 1U);
+}
+
+/* Returns -EAGAIN while the job is running, then the result of the job */
+static int caam_jr_poll(void)
+{
+	uint32_t status;
+
+	if (mmio_read_32(caam_gcm.jr_base + JR_ORSFR) == 0U)
+		return -EAGAIN;
+
+	inv_dcache_range((uintptr_t)caam_out_ring, sizeof(caam_out_ring));
+	status = caam_out_ring[caam_gcm.ptr_size / sizeof(uint32_t)];
+	mmio_write_32(caam_gcm.jr_base + JR_ORJRR, 1U);
+
+	if (status != 0U) {
+		VERBOSE("CAAM: job failed (0x%x)\n", status);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int caam_jr_run(void)
+{
+	uint64_t timeout;
+	int ret;
+
+	caam_jr_enqueue();
+
+	timeout = timeout_init_us(JOB_TIMEOUT_US);
+	do {
+		ret = caam_jr_poll();
+	} while ((ret == -EAGAIN) && !timeout_elapsed(timeout));
+
+	return (ret == -EAGAIN) ? -ETIMEDOUT : ret;
+}
+
+static int caam_jr_reset(void)
+{
+	uintptr_t jr_base = caam_gcm.jr_base;
+	uint64_t timeout;
+
+	/* The first reset halts the ring, the second one resets it */
+	mmio_write_32(jr_base + JR_JRCR, JRCR_RESET);
+	timeout = timeout_init_us(JOB_TIMEOUT_US);
+	while ((mmio_read_32(jr_base + JR_JRINTR) & JRINTR_HALT_MASK) ==
+	       JRINTR_HALT_IN_PROGRESS) {
+		if (timeout_elapsed(timeout))
+			return -ETIMEDOUT;
+	}
+
+	mmio_write_32(jr_base + JR_JRCR, JRCR_RESET);
+	while ((mmio_read_32(jr_base + JR_JRCR) & JRCR_RESET) != 0U) {
+		if (timeout_elapsed(timeout))
+			return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+/* Decapsulate the blob of the key into a black key */
+static int caam_load_black_key(const imx_caam_key_id_t *key_id)
+{
+	uintptr_t blob = (uintptr_t)key_id->blob_base;
+	size_t blob_len = key_id->key_len + BLOB_OVERHEAD;
+	int ret;
+
+	if ((key_id->key_len == 0U) ||
+	    (key_id->key_len > sizeof(caam_black_key)))
+		return -EINVAL;
+
+	/* The key modifier must be in memory, use the context buffer */
+	memcpy(caam_context, key_id->key_mod, sizeof(key_id->key_mod));
+	flush_dcache_range((uintptr_t)caam_context, sizeof(caam_context));
+	flush_dcache_range(blob, blob_len);
+
+	caam_desc[0] = CMD_HEADER;
+	desc_add_word(CMD_KEY_CLASS2 | sizeof(key_id->key_mod));
+	desc_add_ptr((uintptr_t)caam_context);
+	desc_add_word(CMD_SEQ_IN_PTR_EXT);
+	desc_add_ptr(blob);
+	desc_add_word(blob_len);
+	desc_add_word(CMD_SEQ_OUT_PTR_EXT);
+	desc_add_ptr((uintptr_t)caam_black_key);
+	/* Black keys are padded to the AES block size */
+	desc_add_word(round_up(key_id->key_len, 16U));
+	desc_add_word(CMD_OP_BLOB_DECAP_BLACK);
+
+	ret = caam_jr_run();
+	zeromem(caam_context, sizeof(caam_context));
+
+	return ret;
+}
+
+static int caam_gcm_start(enum crypto_dec_algo dec_algo, const void *key,
+			  unsigned int key_len, unsigned int key_flags,
+			  const void *iv, unsigned int iv_len, const void *tag,
+			  unsigned int tag_len)
+{
+	const imx_caam_key_id_t *key_id = key;
+	int ret;
+
+	/* Leave anything else to the software implementation */
+	if ((dec_algo != CRYPTO_GCM_DECRYPT) || (iv_len != 12U) ||
+	    (tag_len > sizeof(caam_gcm.tag)))
+		return -ENOTSUP;
+
+	if ((key_flags & ENC_KEY_IS_IDENTIFIER) != 0U) {
+		if ((key_len < sizeof(*key_id)) ||
+		    (key_id->type != IMX_CAAM_KEY_BLACK_BLOB))
+			return -ENOTSUP;
+
+		ret = caam_load_black_key(key_id);
+		if (ret != 0)
+			return ret;
+
+		caam_gcm.black = true;
+		caam_gcm.key_len = key_id->key_len;
+	} else {
+		if ((key_len != 16U) && (key_len != 24U) && (key_len != 32U))
+			return -ENOTSUP;
+
+		caam_gcm.black = false;
+		caam_gcm.key_len = key_len;
+		memcpy(caam_gcm.key, key, key_len);
+	}
+
+	memcpy(caam_gcm.iv, iv, iv_len);
+	caam_gcm.iv_len = iv_len;
+	memcpy(caam_gcm.tag, tag, tag_len);
+	caam_gcm.tag_len = tag_len;
+	caam_gcm.init = true;
+
+	return 0;
+}
+
+/*
+ * Each chunk is a separate job: the first one initialises the GCM state with
+ * the IV, and all but the last one save it in caam_context for the next one
+ * to restore it. The last one also checks the tag.
+ */
+static int caam_gcm_decrypt(uintptr_t buffer, size_t len, bool last)
+{
+	uint32_t as;
+
+	assert(!caam_gcm.busy);
+	assert((len >> 32) == 0U);
+
+	if (caam_gcm.init)
+		as = last ? OP_AS_INITFINAL : OP_AS_INIT;
+	else
+		as = last ? OP_AS_FINALIZE : OP_AS_UPDATE;
+
+	caam_desc[0] = CMD_HEADER;
+
+	if (caam_gcm.black) {
+		desc_add_word(CMD_KEY_CLASS1 | KEY_ENC | caam_gcm.key_len);
+		desc_add_ptr((uintptr_t)caam_black_key);
+	} else {
+		desc_add_word(CMD_KEY_CLASS1 | KEY_IMM | caam_gcm.key_len);
+		desc_add_data(caam_gcm.key, caam_gcm.key_len);
+	}
+
+	if (!caam_gcm.init) {
+		desc_add_word(CMD_LOAD_CONTEXT1 | CONTEXT1_SIZE);
+		desc_add_ptr((uintptr_t)caam_context);
+	}
+
+	desc_add_word(CMD_OP_AES_GCM_DEC | as | (last ? OP_ICV_ON : 0U));
+
+	if (caam_gcm.init) {
+		desc_add_word(CMD_FIFO_LOAD_CLASS1 | FIFOLD_IMM |
+			      FIFOLD_TYPE_IV | FIFOLD_FLUSH1 | caam_gcm.iv_len);
+		desc_add_data(caam_gcm.iv, caam_gcm.iv_len);
+	}
+
+	/* Decrypt in place */
+	desc_add_word(CMD_FIFO_STORE_MSG_EXT);
+	desc_add_ptr(buffer);
+	desc_add_word((uint32_t)len);
+	desc_add_word(CMD_FIFO_LOAD_CLASS1 | FIFOLD_EXT | FIFOLD_TYPE_MSG |
+		      (last ? FIFOLD_LAST1 : 0U));
+	desc_add_ptr(buffer);
+	desc_add_word((uint32_t)len);
+
+	if (last) {
+		desc_add_word(CMD_FIFO_LOAD_CLASS1 | FIFOLD_IMM |
+			      FIFOLD_TYPE_ICV | FIFOLD_LAST1 |
+			      caam_gcm.tag_len);
+		desc_add_data(caam_gcm.tag, caam_gcm.tag_len);
+	} else {
+		desc_add_word(CMD_STORE_CONTEXT1 | CONTEXT1_SIZE);
+		desc_add_ptr((uintptr_t)caam_context);
+	}
+
+	caam_gcm.init = false;
+	caam_gcm.last = last;
+	caam_gcm.buffer = buffer;
+	caam_gcm.len = len;
+	caam_gcm.busy = true;
+
+	flush_dcache_range(buffer, len);
+	caam_jr_enqueue();
+
+	return 0;
+}
+
+static int caam_gcm_poll(void)
+{
+	int ret;
+
+	if (!caam_gcm.busy)
+		return 0;
+
+	ret = caam_jr_poll();
+	if (ret == -EAGAIN)
+		return ret;
+
+	caam_gcm.busy = false;
+
+	/* The lines were cleaned before the job, so none can be dirty */
+	flush_dcache_range(caam_gcm.buffer, caam_gcm.len);
+	inv_dcache_range((uintptr_t)caam_context, sizeof(caam_context));
+
+	/* Don't leave the key behind once the image is done with */
+	if (caam_gcm.last || (ret != 0)) {
+		zeromem(&caam_gcm.key, sizeof(caam_gcm.key));
+		zeromem(caam_desc, sizeof(caam_desc));
+		zeromem(caam_context, sizeof(caam_context));
+		zeromem(caam_black_key, sizeof(caam_black_key));
+		flush_dcache_range((uintptr_t)caam_desc, sizeof(caam_desc));
+		flush_dcache_range((uintptr_t)caam_context,
+				   sizeof(caam_context));
+		flush_dcache_range((uintptr_t)caam_black_key,
+				   sizeof(caam_black_key));
+	}
+
+	if (ret != 0)
+		return caam_gcm.last ? -EAUTH : -EIO;
+
+	return 0;
+}
+
+static const io_enc_engine_t caam_gcm_engine = {
+	.start = caam_gcm_start,
+	.decrypt = caam_gcm_decrypt,
+	.poll = caam_gcm_poll,
+};
+
+int imx_caam_gcm_init(uintptr_t base, unsigned int jr)
+{
+	uintptr_t jr_base = CAAM_JR_BASE(base, jr);
+	int ret;
+
+	caam_gcm.jr_base = jr_base;
+	caam_gcm.ptr_size = ((mmio_read_32(base + CAAM_MCFGR) & MCFGR_PS) != 0U) ?
+		8U : 4U;
+
+	ret = caam_jr_reset();
+	if (ret != 0) {
+		WARN("CAAM: job ring %u reset failed, using software decryption\n",
+		     jr);
+		return ret;
+	}
+
+	/*
+	 * One slot rings: the chunks depend on each other. In the 64-bit ring
+	 * base registers of the i.MX CAAM, the most significant word is at +0
+	 * and the least significant one at +4.
+	 */
+	mmio_write_32(jr_base + JR_IRBAR,
+		      (uint32_t)((uint64_t)(uintptr_t)&caam_in_ring >> 32));
+	mmio_write_32(jr_base + JR_IRBAR + 4U, (uint32_t)(uintptr_t)&caam_in_ring);
+	mmio_write_32(jr_base + JR_IRSR, 1U);
+	mmio_write_32(jr_base + JR_ORBAR,
+		      (uint32_t)((uint64_t)(uintptr_t)caam_out_ring >> 32));
+	mmio_write_32(jr_base + JR_ORBAR + 4U, (uint32_t)(uintptr_t)caam_out_ring);
+	mmio_write_32(jr_base + JR_ORSR, 1U);
+	mmio_write_32(jr_base + JR_JRCFGR_LS, JRCFGR_LS_IMSK);
+
+	io_enc_register_engine(&caam_gcm_engine);
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef IMX_CAAM_GCM_H
+#define IMX_CAAM_GCM_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/* Types of key identifiers */
+#define IMX_CAAM_KEY_BLACK_BLOB	U(1)
+
+/*
+ * Key identifier returned by plat_get_enc_key_info() along with the
+ * ENC_KEY_IS_IDENTIFIER flag, for a key held in a CAAM blob. The blob is
+ * decapsulated into a black key, which only the CAAM can use, so the key is
+ * never in clear in memory.
+ */
+typedef struct imx_caam_key_id {
+	uint32_t type;		/* IMX_CAAM_KEY_BLACK_BLOB */
+	uint32_t key_len;	/* Length of the key in the blob */
+	uint64_t blob_base;	/* Address of the blob */
+	uint8_t key_mod[16];	/* Key modifier the blob was created with */
+} imx_caam_key_id_t;
+
+/*
+ * Decrypt the encrypted images with the CAAM at 'base', using its job ring
+ * 'jr', which must be owned by the secure world.
+ */
+int imx_caam_gcm_init(uintptr_t base, unsigned int jr);
+
+#endif /* IMX_CAAM_GCM_H */
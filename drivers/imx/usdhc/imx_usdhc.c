@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <arch.h>
@@ -23,6 +24,8 @@ static int imx_usdhc_set_ios(unsigned int clk, unsigned int width);
 static int imx_usdhc_prepare(int lba, uintptr_t buf, size_t size);
 static int imx_usdhc_read(int lba, uintptr_t buf, size_t size);
 static int imx_usdhc_write(int lba, uintptr_t buf, size_t size);
+static int imx_usdhc_prepare_async(int lba, uintptr_t buf, size_t size);
+static int imx_usdhc_read_poll(int lba, uintptr_t buf, size_t size);
 
 static const struct mmc_ops imx_usdhc_ops = {
 	.init		= imx_usdhc_initialize,
@@ -31,10 +34,15 @@ static const struct mmc_ops imx_usdhc_ops = {
 	.prepare	= imx_usdhc_prepare,
 	.read		= imx_usdhc_read,
 	.write		= imx_usdhc_write,
+	.prepare_async	= imx_usdhc_prepare_async,
+	.read_poll	= imx_usdhc_read_poll,
 };
 
 static imx_usdhc_params_t imx_usdhc_params;
 
+/* Set when the next data command completes through imx_usdhc_read_poll() */
+static bool imx_usdhc_data_async;
+
 #define IMX7_MMC_SRC_CLK_RATE (200 * 1000 * 1000)
 static void imx_usdhc_set_clk(int clk)
 {
@@ -107,6 +115,21 @@ static void imx_usdhc_initialize(void)
 
 #define FSL_CMD_RETRIES	1000
 
+static void imx_usdhc_reset_lines(unsigned int data)
+{
+	uintptr_t reg_base = imx_usdhc_params.reg_base;
+
+	mmio_setbits32(reg_base + SYSCTRL, SYSCTRL_RSTC);
+	while (mmio_read_32(reg_base + SYSCTRL) & SYSCTRL_RSTC)
+		;
+
+	if (data) {
+		mmio_setbits32(reg_base + SYSCTRL, SYSCTRL_RSTD);
+		while (mmio_read_32(reg_base + SYSCTRL) & SYSCTRL_RSTD)
+			;
+	}
+}
+
 static int imx_usdhc_send_cmd(struct mmc_cmd *cmd)
 {
 	uintptr_t reg_base = imx_usdhc_params.reg_base;
@@ -215,6 +238,10 @@ static int imx_usdhc_send_cmd(struct mmc_cmd *cmd)
 		cmd->resp_data[0] = mmio_read_32(reg_base + CMDRSP0);
 	}
 
+	/* Leave the transfer running, imx_usdhc_read_poll() completes it */
+	if (data && imx_usdhc_data_async)
+		return 0;
+
 	/* Wait until all of the blocks are transferred */
 	if (data) {
 		flags = DATA_COMPLETE;
@@ -232,15 +259,8 @@ static int imx_usdhc_send_cmd(struct mmc_cmd *cmd)
 out:
 	/* Reset CMD and DATA on error */
 	if (err) {
-		mmio_setbits32(reg_base + SYSCTRL, SYSCTRL_RSTC);
-		while (mmio_read_32(reg_base + SYSCTRL) & SYSCTRL_RSTC)
-			;
-
-		if (data) {
-			mmio_setbits32(reg_base + SYSCTRL, SYSCTRL_RSTD);
-			while (mmio_read_32(reg_base + SYSCTRL) & SYSCTRL_RSTD)
-				;
-		}
+		imx_usdhc_data_async = false;
+		imx_usdhc_reset_lines(data);
 	}
 
 	/* clear all irq status */
@@ -276,11 +296,47 @@ static int imx_usdhc_prepare(int lba, uintptr_t buf, size_t size)
 	return 0;
 }
 
+static int imx_usdhc_prepare_async(int lba, uintptr_t buf, size_t size)
+{
+	/* The DMA engine needs a word aligned destination */
+	if ((buf & (sizeof(uint32_t) - 1U)) != 0U)
+		return -EINVAL;
+
+	imx_usdhc_data_async = true;
+
+	return imx_usdhc_prepare(lba, buf, size);
+}
+
 static int imx_usdhc_read(int lba, uintptr_t buf, size_t size)
 {
 	return 0;
 }
 
+static int imx_usdhc_read_poll(int lba, uintptr_t buf, size_t size)
+{
+	uintptr_t reg_base = imx_usdhc_params.reg_base;
+	unsigned int state;
+	int err = 0;
+
+	assert(imx_usdhc_data_async);
+
+	state = mmio_read_32(reg_base + INTSTAT);
+	if (state & (INTSTATEN_DTOE | DATA_ERR)) {
+		ERROR("imx_usdhc mmc data state 0x%x\n", state);
+		imx_usdhc_reset_lines(1);
+		err = -EIO;
+	} else if ((state & DATA_COMPLETE) != DATA_COMPLETE) {
+		return -EAGAIN;
+	}
+
+	imx_usdhc_data_async = false;
+
+	/* clear all irq status */
+	mmio_write_32(reg_base + INTSTAT, 0xffffffff);
+
+	return err;
+}
+
 static int imx_usdhc_write(int lba, uintptr_t buf, size_t size)
 {
 	return 0;
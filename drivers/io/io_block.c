@@ -21,6 +21,11 @@ typedef struct {
 	uintptr_t		base;
 	unsigned long long	file_pos;
 	unsigned long long	size;
+	/* Asynchronous read in progress */
+	uintptr_t		async_buffer;
+	size_t			async_length;	/* total bytes requested */
+	size_t			async_count;	/* bytes already read */
+	size_t			async_pending;	/* bytes in the block transfer */
 } block_dev_state_t;
 
 #define is_power_of_2(x)	(((x) != 0U) && (((x) & ((x) - 1U)) == 0U))
@@ -35,6 +40,9 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 static int block_write(io_entity_t *entity, const uintptr_t buffer,
 		       size_t length, size_t *length_written);
 static int block_close(io_entity_t *entity);
+static int block_read_async(io_entity_t *entity, uintptr_t buffer,
+			    size_t length);
+static int block_read_poll(io_entity_t *entity, size_t *length_read);
 static int block_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int block_dev_close(io_dev_info_t *dev_info);
 
@@ -52,6 +60,8 @@ static const io_dev_funcs_t block_dev_funcs = {
 	.close		= block_close,
 	.dev_init	= NULL,
 	.dev_close	= block_dev_close,
+	.read_async	= block_read_async,
+	.read_poll	= block_read_poll,
 };
 
 static block_dev_state_t state_pool[MAX_IO_BLOCK_DEVICES];
@@ -491,6 +501,114 @@ static int block_write(io_entity_t *entity, const uintptr_t buffer,
 	return 0;
 }
 
+/*
+ * Start an asynchronous read. The leading bytes up to the first block
+ * boundary are read synchronously through the block buffer, then the whole
+ * blocks are transferred by the low level driver straight into the caller's
+ * buffer. The trailing partial block, if any, is read once that transfer has
+ * completed, in block_read_poll(). If the low level driver doesn't support
+ * asynchronous reads or can't transfer into the caller's buffer, the read is
+ * completed synchronously here.
+ */
+static int block_read_async(io_entity_t *entity, uintptr_t buffer,
+			    size_t length)
+{
+	block_dev_state_t *cur;
+	io_block_ops_t *ops;
+	size_t block_size, skip, body, nbytes;
+	int lba;
+	int result;
+
+	assert(entity->info != (uintptr_t)NULL);
+	cur = (block_dev_state_t *)entity->info;
+	ops = &(cur->dev_spec->ops);
+	block_size = cur->dev_spec->block_size;
+	assert((length <= cur->size) && (length > 0U));
+
+	cur->async_buffer = buffer;
+	cur->async_length = length;
+	cur->async_count = 0U;
+	cur->async_pending = 0U;
+
+	if ((ops->read_async == NULL) || (ops->read_poll == NULL)) {
+		return block_read(entity, buffer, length, &cur->async_count);
+	}
+
+	skip = cur->file_pos & (block_size - 1U);
+	if (skip != 0U) {
+		nbytes = block_size - skip;
+		if (nbytes > length) {
+			nbytes = length;
+		}
+
+		result = block_read(entity, buffer, nbytes, &cur->async_count);
+		if (result != 0) {
+			return result;
+		}
+	}
+
+	body = (length - cur->async_count) & ~(block_size - 1U);
+	if (body == 0U) {
+		return 0;
+	}
+
+	lba = (cur->file_pos + cur->base) / block_size;
+	result = ops->read_async(lba, buffer + cur->async_count, body);
+	if (result == 0) {
+		cur->async_pending = body;
+	} else if (result == -EINVAL) {
+		/* Buffer not suitable for the driver, read it synchronously */
+		result = block_read(entity, buffer + cur->async_count,
+				    length - cur->async_count, &nbytes);
+		cur->async_count += nbytes;
+	}
+
+	return result;
+}
+
+static int block_read_poll(io_entity_t *entity, size_t *length_read)
+{
+	block_dev_state_t *cur;
+	io_block_ops_t *ops;
+	size_t nbytes;
+	int result;
+
+	assert(entity->info != (uintptr_t)NULL);
+	cur = (block_dev_state_t *)entity->info;
+	ops = &(cur->dev_spec->ops);
+
+	if (cur->async_pending != 0U) {
+		result = ops->read_poll(&nbytes);
+		if (result == -EAGAIN) {
+			return result;
+		}
+
+		if ((result != 0) || (nbytes != cur->async_pending)) {
+			cur->async_pending = 0U;
+			return -EIO;
+		}
+
+		cur->async_pending = 0U;
+		cur->file_pos += nbytes;
+		cur->async_count += nbytes;
+	}
+
+	if (cur->async_count < cur->async_length) {
+		result = block_read(entity, cur->async_buffer + cur->async_count,
+				    cur->async_length - cur->async_count,
+				    &nbytes);
+		if (result != 0) {
+			return result;
+		}
+
+		cur->async_count += nbytes;
+	}
+
+	*length_read = cur->async_count;
+
+	return 0;
+}
+
 static int block_close(io_entity_t *entity)
 {
 	entity->info = (uintptr_t)NULL;
@@ -7,6 +7,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -30,6 +31,9 @@ static uintptr_t backend_image_spec;
 
 static io_dev_info_t enc_dev_info;
 
+/* Optional decryption engine, NULL to always use crypto_mod_auth_decrypt() */
+static const io_enc_engine_t *enc_engine;
+
 /* Encrypted firmware driver functions */
 static int enc_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int enc_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
@@ -150,6 +154,89 @@ static int enc_file_len(io_entity_t *entity, size_t *length)
 	return result;
 }
 
+/* Wait for the decryption engine to complete the last request */
+static int enc_engine_wait(void)
+{
+	int result;
+
+	do {
+		result = enc_engine->poll();
+	} while (result == -EAGAIN);
+
+	return result;
+}
+
+/*
+ * Read the payload chunk by chunk and decrypt each chunk with the engine while
+ * the next one is read: the storage and the engine work in parallel, and the
+ * CPU only polls them.
+ */
+static int enc_read_decrypt(uintptr_t buffer, size_t length,
+			    size_t *length_read)
+{
+	size_t offset = 0U, next = 0U, chunk, bytes_read;
+	bool last;
+	int result;
+
+	chunk = MIN(length, (size_t)IO_ENC_CHUNK_SIZE);
+	result = io_read_async(backend_handle, buffer, chunk);
+
+	while (result == 0) {
+		do {
+			result = io_read_poll(backend_handle, &bytes_read);
+		} while (result == -EAGAIN);
+
+		if (result != 0) {
+			WARN("Failed to read encrypted payload (%i)\n",
+			     result);
+			break;
+		}
+
+		/* A short read means the end of the payload */
+		last = (bytes_read < chunk) || ((offset + chunk) == length);
+		if (!last) {
+			next = MIN(length - offset - chunk,
+				   (size_t)IO_ENC_CHUNK_SIZE);
+			result = io_read_async(backend_handle,
+					       buffer + offset + chunk, next);
+			if (result != 0) {
+				WARN("Failed to read encrypted payload (%i)\n",
+				     result);
+				break;
+			}
+		}
+
+		result = enc_engine->decrypt(buffer + offset, bytes_read, last);
+		if (result == 0)
+			result = enc_engine_wait();
+
+		offset += bytes_read;
+		if (last)
+			break;
+
+		if (result != 0) {
+			/* Let the read of the next chunk complete */
+			while (io_read_poll(backend_handle, &bytes_read) ==
+			       -EAGAIN) {
+			}
+			break;
+		}
+
+		chunk = next;
+	}
+
+	if (result != 0) {
+		/* Don't leave a partially decrypted image behind */
+		memset((void *)buffer, 0, offset);
+		ERROR("File decryption failed (%i)\n", result);
+		return -ENOENT;
+	}
+
+	*length_read = offset;
+
+	return 0;
+}
+
 static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			 size_t *length_read)
 {
@@ -186,22 +273,39 @@ static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		return -ENOENT;
 	}
 
-	result = io_read(backend_handle, buffer, length, &bytes_read);
+	result = plat_get_enc_key_info(fw_enc_status, key, &key_len, &key_flags,
+				       (uint8_t *)&uuid_spec->uuid,
+				       sizeof(uuid_t));
 	if (result != 0) {
-		WARN("Failed to read encrypted payload (%i)\n", result);
+		WARN("Failed to obtain encryption key (%i)\n", result);
 		return -ENOENT;
 	}
 
-	*length_read = bytes_read;
+	if (enc_engine != NULL) {
+		result = enc_engine->start(header.dec_algo, key, key_len,
+					   key_flags, header.iv, header.iv_len,
+					   header.tag, header.tag_len);
+		if (result == 0) {
+			memset(key, 0, key_len);
+			return enc_read_decrypt(buffer, length, length_read);
+		}
+
+		if (result != -ENOTSUP) {
+			memset(key, 0, key_len);
+			ERROR("File decryption failed (%i)\n", result);
+			return -ENOENT;
+		}
+	}
 
-	result = plat_get_enc_key_info(fw_enc_status, key, &key_len, &key_flags,
-				       (uint8_t *)&uuid_spec->uuid,
-				       sizeof(uuid_t));
+	result = io_read(backend_handle, buffer, length, &bytes_read);
 	if (result != 0) {
-		WARN("Failed to obtain encryption key (%i)\n", result);
+		memset(key, 0, key_len);
+		WARN("Failed to read encrypted payload (%i)\n", result);
 		return -ENOENT;
 	}
 
+	*length_read = bytes_read;
+
 	result = crypto_mod_auth_decrypt(header.dec_algo,
 					 (void *)buffer, *length_read, key,
 					 key_len, key_flags, header.iv,
@@ -229,6 +333,15 @@ static int enc_file_close(io_entity_t *entity)
 
 /* Exported functions */
 
+/* Register an engine to decrypt the payloads instead of the crypto module */
+void io_enc_register_engine(const io_enc_engine_t *engine)
+{
+	assert((engine == NULL) || ((engine->start != NULL) &&
+		(engine->decrypt != NULL) && (engine->poll != NULL)));
+
+	enc_engine = engine;
+}
+
 /* Register the Encrypted Firmware driver with the IO abstraction */
 int register_io_dev_enc(const io_dev_connector_t **dev_con)
 {
@@ -60,6 +60,9 @@ static fip_file_state_t current_fip_file = {0};
 static uintptr_t backend_dev_handle;
 static uintptr_t backend_image_spec;
 
+/* Backend handle kept open while an asynchronous read is in progress */
+static uintptr_t async_backend_handle;
+
 static fip_dev_state_t state_pool[MAX_FIP_DEVICES];
 static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
 
@@ -74,6 +77,9 @@ static int fip_file_len(io_entity_t *entity, size_t *length);
 static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			  size_t *length_read);
 static int fip_file_close(io_entity_t *entity);
+static int fip_file_read_async(io_entity_t *entity, uintptr_t buffer,
+			       size_t length);
+static int fip_file_read_poll(io_entity_t *entity, size_t *length_read);
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params);
 static int fip_dev_close(io_dev_info_t *dev_info);
 
@@ -117,6 +123,8 @@ static const io_dev_funcs_t fip_dev_funcs = {
 	.close = fip_file_close,
 	.dev_init = fip_dev_init,
 	.dev_close = fip_dev_close,
+	.read_async = fip_file_read_async,
+	.read_poll = fip_file_read_poll,
 };
 
 /* Locate a file state in the pool, specified by address */
@@ -431,6 +439,88 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 }
 
 
+/* Start an asynchronous read of a file in the package */
+static int fip_file_read_async(io_entity_t *entity, uintptr_t buffer,
+			       size_t length)
+{
+	int result;
+	fip_file_state_t *fp;
+	size_t file_offset;
+
+	assert(entity != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+	assert(async_backend_handle == (uintptr_t)NULL);
+
+	/* Open the backend, attempt to access the blob image */
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &async_backend_handle);
+	if (result != 0) {
+		WARN("Failed to open FIP (%i)\n", result);
+		async_backend_handle = (uintptr_t)NULL;
+		return -ENOENT;
+	}
+
+	fp = (fip_file_state_t *)entity->info;
+
+	/* Seek to the position in the FIP where the payload lives */
+	file_offset = fp->entry.offset_address + fp->file_pos;
+	result = io_seek(async_backend_handle, IO_SEEK_SET,
+			 (signed long long)file_offset);
+	if (result != 0) {
+		WARN("fip_file_read_async: failed to seek\n");
+		result = -ENOENT;
+	} else {
+		result = io_read_async(async_backend_handle, buffer, length);
+		if (result != 0) {
+			WARN("Failed to read payload (%i)\n", result);
+			result = -ENOENT;
+		}
+	}
+
+	if (result != 0) {
+		io_close(async_backend_handle);
+		async_backend_handle = (uintptr_t)NULL;
+	}
+
+	return result;
+}
+
+
+/* Check for completion of an asynchronous read of a file in the package */
+static int fip_file_read_poll(io_entity_t *entity, size_t *length_read)
+{
+	int result;
+	fip_file_state_t *fp;
+	size_t bytes_read;
+
+	assert(entity != NULL);
+	assert(length_read != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+	assert(async_backend_handle != (uintptr_t)NULL);
+
+	result = io_read_poll(async_backend_handle, &bytes_read);
+	if (result == -EAGAIN) {
+		return result;
+	}
+
+	if (result != 0) {
+		/* We cannot read our data. Fail. */
+		WARN("Failed to read payload (%i)\n", result);
+		result = -ENOENT;
+	} else {
+		/* Set caller length and new file position. */
+		fp = (fip_file_state_t *)entity->info;
+		*length_read = bytes_read;
+		fp->file_pos += bytes_read;
+	}
+
+	io_close(async_backend_handle);
+	async_backend_handle = (uintptr_t)NULL;
+
+	return result;
+}
+
+
 /* Close a file in package */
 static int fip_file_close(io_entity_t *entity)
 {
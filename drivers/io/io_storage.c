@@ -22,6 +22,13 @@ static io_entity_t *entity_map[MAX_IO_HANDLES];
 /* Track number of allocated entities */
 static unsigned int entity_count;
 
+/*
+ * Result of an asynchronous read emulated with a synchronous one, for devices
+ * which don't provide a non-blocking read operation.
+ */
+static int entity_async_result[MAX_IO_HANDLES];
+static size_t entity_async_length[MAX_IO_HANDLES];
+
 /* Array of fixed maximum of registered devices, definable by platform */
 static const io_dev_info_t *devices[MAX_IO_DEVICES];
 
@@ -326,3 +333,64 @@ int io_close(uintptr_t handle)
 
 	return result;
 }
+
+
+/* Asynchronous operations */
+
+
+/*
+ * Start reading data from an IO entity without waiting for the transfer to
+ * complete. Completion must be checked with io_read_poll() before the buffer
+ * is used or any other operation is issued on the same entity. Devices which
+ * don't support non-blocking reads complete the read synchronously here.
+ */
+int io_read_async(uintptr_t handle,
+		uintptr_t buffer,
+		size_t length)
+{
+	int result = -ENODEV;
+	assert(is_valid_entity(handle));
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->read_async != NULL) {
+		result = dev->funcs->read_async(entity, buffer, length);
+	} else if (dev->funcs->read != NULL) {
+		unsigned int index = entity - entity_pool;
+
+		entity_async_length[index] = 0U;
+		entity_async_result[index] = dev->funcs->read(entity, buffer,
+				length, &entity_async_length[index]);
+		result = 0;
+	}
+
+	return result;
+}
+
+
+/*
+ * Check for completion of a read started with io_read_async(). Returns -EAGAIN
+ * while the transfer is still in progress.
+ */
+int io_read_poll(uintptr_t handle, size_t *length_read)
+{
+	int result;
+	assert(is_valid_entity(handle) && (length_read != NULL));
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->read_poll != NULL) {
+		result = dev->funcs->read_poll(entity, length_read);
+	} else {
+		unsigned int index = entity - entity_pool;
+
+		*length_read = entity_async_length[index];
+		result = entity_async_result[index];
+	}
+
+	return result;
+}
@@ -31,6 +31,14 @@ static struct mmc_device_info *mmc_dev_info;
 static unsigned int rca;
 static unsigned int scr[2]__aligned(16) = { 0 };
 
+/* Block read started by mmc_read_blocks_async() */
+static struct {
+	int lba;
+	uintptr_t buf;
+	size_t size;
+	size_t done;
+} async_read;
+
 static const unsigned char tran_speed_base[16] = {
 	0, 10, 12, 13, 15, 20, 26, 30, 35, 40, 45, 52, 55, 60, 70, 80
 };
@@ -527,19 +535,16 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 	return mmc_fill_device_info();
 }
 
-size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
+static int mmc_read_blocks_start(int lba, uintptr_t buf, size_t size,
+				 int (*prepare)(int lba, uintptr_t buf,
+						size_t size))
 {
 	int ret;
 	unsigned int cmd_idx, cmd_arg;
 
-	assert((ops != NULL) &&
-	       (ops->read != NULL) &&
-	       (size != 0U) &&
-	       ((size & MMC_BLOCK_MASK) == 0U));
-
-	ret = ops->prepare(lba, buf, size);
+	ret = prepare(lba, buf, size);
 	if (ret != 0) {
-		return 0;
+		return ret;
 	}
 
 	if (is_cmd23_enabled()) {
@@ -547,7 +552,7 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 		ret = mmc_send_cmd(MMC_CMD(23), size / MMC_BLOCK_SIZE,
 				   MMC_RESPONSE_R1, NULL);
 		if (ret != 0) {
-			return 0;
+			return ret;
 		}
 
 		cmd_idx = MMC_CMD(18);
@@ -566,34 +571,125 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 		cmd_arg = lba;
 	}
 
-	ret = mmc_send_cmd(cmd_idx, cmd_arg, MMC_RESPONSE_R1, NULL);
-	if (ret != 0) {
-		return 0;
-	}
+	return mmc_send_cmd(cmd_idx, cmd_arg, MMC_RESPONSE_R1, NULL);
+}
 
-	ret = ops->read(lba, buf, size);
-	if (ret != 0) {
-		return 0;
-	}
+static int mmc_read_blocks_end(size_t size)
+{
+	int ret;
 
 	/* Wait buffer empty */
 	do {
 		ret = mmc_device_state();
 		if (ret < 0) {
-			return 0;
+			return ret;
 		}
 	} while ((ret != MMC_STATE_TRAN) && (ret != MMC_STATE_DATA));
 
 	if (!is_cmd23_enabled() && (size > MMC_BLOCK_SIZE)) {
 		ret = mmc_send_cmd(MMC_CMD(12), 0, MMC_RESPONSE_R1B, NULL);
 		if (ret != 0) {
-			return 0;
+			return ret;
 		}
 	}
 
+	return 0;
+}
+
+size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
+{
+	int ret;
+
+	assert((ops != NULL) &&
+	       (ops->read != NULL) &&
+	       (size != 0U) &&
+	       ((size & MMC_BLOCK_MASK) == 0U));
+
+	ret = mmc_read_blocks_start(lba, buf, size, ops->prepare);
+	if (ret != 0) {
+		return 0;
+	}
+
+	ret = ops->read(lba, buf, size);
+	if (ret != 0) {
+		return 0;
+	}
+
+	ret = mmc_read_blocks_end(size);
+	if (ret != 0) {
+		return 0;
+	}
+
 	return size;
 }
 
+/*
+ * Start a block read without waiting for the data transfer to complete. The
+ * driver must provide the prepare_async and read_poll operations, otherwise
+ * the read is performed synchronously and mmc_read_blocks_poll() only reports
+ * its result.
+ */
+int mmc_read_blocks_async(int lba, uintptr_t buf, size_t size)
+{
+	int ret;
+
+	assert((ops != NULL) &&
+	       (ops->read != NULL) &&
+	       (size != 0U) &&
+	       ((size & MMC_BLOCK_MASK) == 0U) &&
+	       (async_read.size == 0U));
+
+	async_read.lba = lba;
+	async_read.buf = buf;
+	async_read.size = size;
+
+	if ((ops->prepare_async == NULL) || (ops->read_poll == NULL)) {
+		async_read.done = mmc_read_blocks(lba, buf, size);
+		return 0;
+	}
+
+	async_read.done = 0U;
+	ret = mmc_read_blocks_start(lba, buf, size, ops->prepare_async);
+	if (ret != 0) {
+		async_read.size = 0U;
+	}
+
+	return ret;
+}
+
+/*
+ * Check for completion of a read started with mmc_read_blocks_async().
+ * Returns -EAGAIN while the data transfer is still in progress.
+ */
+int mmc_read_blocks_poll(size_t *size_read)
+{
+	int ret = 0;
+
+	assert((ops != NULL) && (size_read != NULL) &&
+	       (async_read.size != 0U));
+
+	if ((ops->prepare_async != NULL) && (ops->read_poll != NULL)) {
+		ret = ops->read_poll(async_read.lba, async_read.buf,
+				     async_read.size);
+		if (ret == -EAGAIN) {
+			return ret;
+		}
+
+		if (ret == 0) {
+			ret = mmc_read_blocks_end(async_read.size);
+		}
+
+		if (ret == 0) {
+			async_read.done = async_read.size;
+		}
+	}
+
+	*size_read = async_read.done;
+	async_read.size = 0U;
+
+	return ret;
+}
+
 size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size)
 {
 	int ret;
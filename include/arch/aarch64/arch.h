@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -221,6 +221,10 @@
 #define ID_AA64ISAR0_RNDR_SHIFT	U(60)
 #define ID_AA64ISAR0_RNDR_MASK	ULL(0xf)
 
+#define ID_AA64ISAR0_TLB_SHIFT	U(56)
+#define ID_AA64ISAR0_TLB_MASK	ULL(0xf)
+#define ID_AA64ISAR0_TLB_RANGE	ULL(0x2)
+
 /* ID_AA64ISAR1_EL1 definitions */
 #define ID_AA64ISAR1_EL1	S3_0_C0_C6_1
 #define ID_AA64ISAR1_GPI_SHIFT	U(28)
@@ -873,6 +877,23 @@
 #define TLBI_ADDR_MASK		ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)		(((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/*
+ * Operand of the TLBI range instructions (FEAT_TLBIRANGE) with a 4KB granule:
+ * they invalidate (NUM + 1) * 2^(5 * SCALE + 1) pages starting at BaseADDR.
+ */
+#define TLBI_RANGE_TG_4KB	(ULL(1) << 46)
+#define TLBI_RANGE_SCALE_SHIFT	U(44)
+#define TLBI_RANGE_SCALE_MAX	U(3)
+#define TLBI_RANGE_NUM_SHIFT	U(39)
+#define TLBI_RANGE_NUM_MAX	U(31)
+#define TLBI_RANGE_ADDR_MASK	ULL(0x0000001FFFFFFFFF)
+#define TLBI_RANGE_PAGES(scale, num)	\
+	(((num) + 1ULL) << ((5U * (scale)) + 1U))
+#define TLBI_RANGE(x, scale, num)	(TLBI_RANGE_TG_4KB |		\
+	((unsigned long long)(scale) << TLBI_RANGE_SCALE_SHIFT) |	\
+	((unsigned long long)(num) << TLBI_RANGE_NUM_SHIFT) |		\
+	(((x) >> TLBI_ADDR_SHIFT) & TLBI_RANGE_ADDR_MASK))
+
 /*******************************************************************************
  * Definitions of register offsets and fields in the CNTCTLBase Frame of the
  * system level implementation of the Generic Timer.
@@ -7,6 +7,7 @@
 #ifndef BL2_H
 #define BL2_H
 
+#include <cdefs.h>
 #include <stdint.h>
 
 void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
@@ -15,4 +16,15 @@ void bl2_el3_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 		   u_register_t arg3);
 void bl2_main(void);
 
+#if BL2_PARALLEL_AUTH
+/* Work handed to the secondary CPUs, returns 0 on success */
+typedef int (*bl2_work_fn_t)(void *arg);
+
+void bl2_el3_worker_entrypoint(void);
+void __dead2 bl2_worker_main(void);
+void bl2_workers_start(void);
+int bl2_work_queue(bl2_work_fn_t fn, void *arg);
+int bl2_workers_stop(void);
+#endif
+
 #endif /* BL2_H */
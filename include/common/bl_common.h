@@ -164,6 +164,11 @@ typedef struct meminfo {
  ******************************************************************************/
 int load_auth_image(unsigned int image_id, image_info_t *image_data);
 
+#if BL2_READ_AHEAD
+void load_image_read_ahead(unsigned int image_id);
+void load_image_read_ahead_wait(void);
+#endif
+
 #if TRUSTED_BOARD_BOOT && defined(DYN_DISABLE_AUTH)
 /*
  * API to dynamically disable authentication. Only meant for development
@@ -12,13 +12,24 @@
 
 struct image_info;
 
+/*
+ * A decompressor consumes input from *in_buf and writes output to *out_buf,
+ * advancing both to the end of the data processed.  The output is cleaned to
+ * the PoC by the decompressor itself.  The output window may overlap the end
+ * of the input (in-place decompression); the decompressor must then never
+ * write over input it has not consumed yet and fails with -ENOSPC instead.
+ */
 typedef int (decompressor_t)(uintptr_t *in_buf, size_t in_len,
 			     uintptr_t *out_buf, size_t out_len,
 			     uintptr_t work_buf, size_t work_len);
 
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *decompressor);
+void image_decompress_init_in_place(uintptr_t work_base, uint32_t work_size,
+				    decompressor_t *decompressor);
 void image_decompress_prepare(struct image_info *info);
+int image_decompress_prepare_in_place(unsigned int image_id,
+				      struct image_info *info);
 int image_decompress(struct image_info *info);
 
 #endif /* IMAGE_DECOMPRESS_H */
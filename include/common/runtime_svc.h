@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -97,6 +97,31 @@ CASSERT(RT_SVC_DESC_INIT == __builtin_offsetof(rt_svc_desc_t, init), \
 CASSERT(RT_SVC_DESC_HANDLE == __builtin_offsetof(rt_svc_desc_t, handle), \
 	assert_rt_svc_desc_handle_offset_mismatch);
 
+/*
+ * Descriptor of the handler of a single SMC function ID within a runtime
+ * service. When 'sub_cmd' is not RT_SVC_FID_ANY_SUB, the handler only takes
+ * calls with that sub-command in x1. The descriptors are collected at link time
+ * and indexed by rt_svc_fid_init() so that rt_svc_fid_lookup() can find the
+ * handler of a call without walking the function IDs of the service.
+ */
+#define RT_SVC_FID_ANY_SUB	U(0xffffffff)
+
+typedef struct rt_svc_fid_desc {
+	uint32_t smc_fid;
+	uint32_t sub_cmd;
+	const char *name;
+	rt_svc_handle_t handle;
+} rt_svc_fid_desc_t;
+
+#define DECLARE_RT_SVC_FID(_name, _smc_fid, _sub_cmd, _smch)		\
+	static const rt_svc_fid_desc_t __svc_fid_desc_ ## _name		\
+		__section("rt_svc_fid_descs") __used = {		\
+			.smc_fid = (_smc_fid),				\
+			.sub_cmd = (_sub_cmd),				\
+			.name = #_name,					\
+			.handle = (_smch)				\
+		}
+
 
 /*
  * This function combines the call type and the owning entity number
@@ -132,6 +157,12 @@ IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_START__,		RT_SVC_DESCS_START);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_END__,		RT_SVC_DESCS_END);
 void init_crash_reporting(void);
 
+void rt_svc_fid_init(void);
+const rt_svc_fid_desc_t *rt_svc_fid_lookup(uint32_t smc_fid, u_register_t x1);
+uint64_t rt_svc_fid_call_count(uint32_t smc_fid, uint32_t sub_cmd);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_DESCS_START__,	RT_SVC_FID_DESCS_START);
+IMPORT_SYM(uintptr_t, __RT_SVC_FID_DESCS_END__,	RT_SVC_FID_DESCS_END);
+
 extern uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
 
 #endif /*__ASSEMBLER__*/
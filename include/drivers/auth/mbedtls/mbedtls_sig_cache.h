@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MBEDTLS_SIG_CACHE_H
+#define MBEDTLS_SIG_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Size of the key identifying a signature check (SHA-256) */
+#define SIG_CACHE_DIGEST_SIZE		32U
+
+/* Number of signature checks remembered across boots */
+#define SIG_CACHE_ENTRIES		16U
+
+void sig_cache_init(void);
+int sig_cache_digest(const void *data_ptr, unsigned int data_len,
+		     const void *sig_ptr, unsigned int sig_len,
+		     const void *sig_alg, unsigned int sig_alg_len,
+		     const void *pk_ptr, unsigned int pk_len,
+		     uint8_t digest[SIG_CACHE_DIGEST_SIZE]);
+bool sig_cache_lookup(const uint8_t digest[SIG_CACHE_DIGEST_SIZE]);
+void sig_cache_insert(const uint8_t digest[SIG_CACHE_DIGEST_SIZE]);
+void sig_cache_flush(void);
+
+#endif /* MBEDTLS_SIG_CACHE_H */
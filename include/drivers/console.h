@@ -51,6 +51,9 @@ typedef struct console {
 /* offset macro assertions for console_t */
 #include <drivers/console_assertions.h>
 
+/* List of the registered consoles, most recently registered first */
+extern console_t *console_list;
+
 /*
  * Add a console_t instance to the console list. This should only be called by
  * console drivers after they have initialized all fields in the console
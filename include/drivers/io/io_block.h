@@ -13,6 +13,9 @@
 typedef struct io_block_ops {
 	size_t	(*read)(int lba, uintptr_t buf, size_t size);
 	size_t	(*write)(int lba, const uintptr_t buf, size_t size);
+	/* Optional non-blocking read, see io_read_async() */
+	int	(*read_async)(int lba, uintptr_t buf, size_t size);
+	int	(*read_poll)(size_t *size_read);
 } io_block_ops_t;
 
 typedef struct io_block_dev_spec {
@@ -48,6 +48,12 @@ typedef struct io_dev_funcs {
 	int (*close)(io_entity_t *entity);
 	int (*dev_init)(io_dev_info_t *dev_info, const uintptr_t init_params);
 	int (*dev_close)(io_dev_info_t *dev_info);
+	/*
+	 * Optional non-blocking read: read_async starts the transfer and
+	 * read_poll returns -EAGAIN until it has completed.
+	 */
+	int (*read_async)(io_entity_t *entity, uintptr_t buffer, size_t length);
+	int (*read_poll)(io_entity_t *entity, size_t *length_read);
 } io_dev_funcs_t;
 
 
@@ -8,8 +8,49 @@
 #ifndef IO_ENCRYPTED_H
 #define IO_ENCRYPTED_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <drivers/auth/crypto_mod.h>
+#include <lib/utils_def.h>
+
+/*
+ * Size of the chunks in which a decryption engine is fed the payload, must
+ * be a multiple of the AES block size.
+ */
+#ifndef IO_ENC_CHUNK_SIZE
+#define IO_ENC_CHUNK_SIZE	U(0x40000)
+#endif
+
 struct io_dev_connector;
 
+/*
+ * Optional decryption engine, e.g. a crypto accelerator, used instead of
+ * crypto_mod_auth_decrypt(). The payload is decrypted in place, chunk by
+ * chunk, each chunk while the next one is read from the backend device.
+ *
+ * start() is called once per image. It returns -ENOTSUP when the engine
+ * can't handle the algorithm or key, in which case the image is decrypted
+ * with crypto_mod_auth_decrypt().
+ *
+ * decrypt() starts decrypting a chunk without waiting for it to complete, and
+ * poll() returns -EAGAIN until it has. Chunks are submitted in order, after
+ * the previous one has completed, and all but the last one are
+ * IO_ENC_CHUNK_SIZE long. After the last chunk, poll() returns the result of
+ * the tag check.
+ */
+typedef struct io_enc_engine {
+	int (*start)(enum crypto_dec_algo dec_algo, const void *key,
+		     unsigned int key_len, unsigned int key_flags,
+		     const void *iv, unsigned int iv_len, const void *tag,
+		     unsigned int tag_len);
+	int (*decrypt)(uintptr_t buffer, size_t len, bool last);
+	int (*poll)(void);
+} io_enc_engine_t;
+
 int register_io_dev_enc(const struct io_dev_connector **dev_con);
 
+void io_enc_register_engine(const io_enc_engine_t *engine);
+
 #endif /* IO_ENCRYPTED_H */
@@ -101,4 +101,10 @@ int io_write(uintptr_t handle, const uintptr_t buffer, size_t length,
 int io_close(uintptr_t handle);
 
 
+/* Asynchronous operations */
+int io_read_async(uintptr_t handle, uintptr_t buffer, size_t length);
+
+int io_read_poll(uintptr_t handle, size_t *length_read);
+
+
 #endif /* IO_STORAGE_H */
@@ -131,6 +131,13 @@ struct mmc_ops {
 	int (*prepare)(int lba, uintptr_t buf, size_t size);
 	int (*read)(int lba, uintptr_t buf, size_t size);
 	int (*write)(int lba, const uintptr_t buf, size_t size);
+	/*
+	 * Optional: same as prepare, but the data transfer of the following
+	 * read command must not be waited for. read_poll then returns -EAGAIN
+	 * until it has completed.
+	 */
+	int (*prepare_async)(int lba, uintptr_t buf, size_t size);
+	int (*read_poll)(int lba, uintptr_t buf, size_t size);
 };
 
 struct mmc_csd_emmc {
@@ -231,6 +238,8 @@ struct mmc_device_info {
 };
 
 size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size);
+int mmc_read_blocks_async(int lba, uintptr_t buf, size_t size);
+int mmc_read_blocks_poll(size_t *size_read);
 size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size);
 size_t mmc_erase_blocks(int lba, size_t size);
 size_t mmc_rpmb_read_blocks(int lba, uintptr_t buf, size_t size);
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef RING_CONSOLE_H
+#define RING_CONSOLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <drivers/console.h>
+
+/* Size of the ring of each CPU, must be a power of two */
+#ifndef CONSOLE_RING_SIZE
+#define CONSOLE_RING_SIZE	U(1024)
+#endif
+
+/*
+ * Register the in-memory ring console. It is only active in the runtime
+ * console state, where it replaces the slow consoles: each CPU appends its
+ * output to its own ring without waiting for any device or lock. The rings
+ * can be read with console_ring_read() and are written out to the crash
+ * console by console_ring_drain(), which is also called by console_flush().
+ */
+int console_ring_register(void);
+
+/*
+ * Copy to 'buf' up to 'len' characters of the ring of 'cpu', starting at the
+ * stream position '*pos' (the number of characters written to the ring before
+ * them). If these were overwritten, the copy starts at the oldest character
+ * still in the ring. '*pos' is updated to the position following the last
+ * character copied. Returns the number of characters copied.
+ */
+size_t console_ring_read(unsigned int cpu, uint64_t *pos, char *buf,
+			 size_t len);
+
+/* Write out to the crash console what was not drained yet from the rings */
+void console_ring_drain(void);
+
+#endif /* RING_CONSOLE_H */
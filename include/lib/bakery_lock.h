@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -18,6 +18,10 @@
 
 #include <lib/utils_def.h>
 
+#if BAKERY_LOCK_STATS
+#include <arch_helpers.h>
+#endif
+
 /*****************************************************************************
  * Internal helpers used by the bakery lock implementation.
  ****************************************************************************/
@@ -48,6 +52,44 @@ static inline uint16_t make_bakery_data(unsigned int choosing, unsigned int num)
 	return (uint16_t) val;
 }
 
+#if BAKERY_LOCK_STATS
+/*
+ * Statistics kept by each CPU for each bakery lock. Times are in system
+ * counter ticks.
+ */
+typedef struct bakery_lock_stats {
+	/* Number of times the lock was acquired */
+	uint32_t acquires;
+	/* Number of acquisitions that waited for another CPU to release it */
+	uint32_t contended;
+	/* Longest time the lock was held */
+	uint32_t max_hold_ticks;
+	uint32_t reserved;
+	/* Total time the lock was held */
+	uint64_t hold_ticks;
+	/* Counter value when the lock was last acquired */
+	uint64_t acquired_at;
+} bakery_lock_stats_t;
+
+static inline void bakery_stats_acquired(bakery_lock_stats_t *stats,
+					 bool contended)
+{
+	stats->acquires++;
+	if (contended)
+		stats->contended++;
+	stats->acquired_at = read_cntpct_el0();
+}
+
+static inline void bakery_stats_released(bakery_lock_stats_t *stats)
+{
+	uint64_t hold = read_cntpct_el0() - stats->acquired_at;
+
+	stats->hold_ticks += hold;
+	if (hold > stats->max_hold_ticks)
+		stats->max_hold_ticks = (uint32_t)MIN(hold, (uint64_t)UINT32_MAX);
+}
+#endif /* BAKERY_LOCK_STATS */
+
 /*****************************************************************************
  * External bakery lock interface.
  ****************************************************************************/
@@ -66,6 +108,9 @@ typedef struct bakery_lock {
 	 * Bits[1 - 15] : number. This is the bakery number allocated.
 	 */
 	volatile uint16_t lock_data[BAKERY_LOCK_MAX_CPUS];
+#if BAKERY_LOCK_STATS
+	bakery_lock_stats_t stats[BAKERY_LOCK_MAX_CPUS];
+#endif
 } bakery_lock_t;
 
 #else
@@ -78,6 +123,16 @@ typedef struct bakery_lock {
  * the remaining cache lines are allocated by the linker script
  */
 
+#if BAKERY_LOCK_STATS
+/*
+ * The statistics of a CPU are kept in the same cache line as its lock_data, to
+ * be maintained with the same cache operations.
+ */
+#define BAKERY_INFO_ALIGN	CACHE_WRITEBACK_GRANULE
+#else
+#define BAKERY_INFO_ALIGN	sizeof(uint16_t)
+#endif
+
 typedef struct bakery_info {
 	/*
 	 * The lock_data is a bit-field of 2 members:
@@ -86,7 +141,10 @@ typedef struct bakery_info {
 	 * Bits[1 - 15] : number. This is the bakery number allocated.
 	 */
 	volatile uint16_t lock_data;
-} bakery_info_t;
+#if BAKERY_LOCK_STATS
+	bakery_lock_stats_t stats;
+#endif
+} __aligned(BAKERY_INFO_ALIGN) bakery_info_t;
 
 typedef bakery_info_t bakery_lock_t;
 
@@ -96,6 +154,16 @@ static inline void bakery_lock_init(bakery_lock_t *bakery) {}
 void bakery_lock_get(bakery_lock_t *bakery);
 void bakery_lock_release(bakery_lock_t *bakery);
 
+#if BAKERY_LOCK_STATS
+/*
+ * Copy the statistics kept by the CPU 'cpu' for the bakery lock 'index', the
+ * locks being numbered in the order of the bakery lock section. Returns -1 if
+ * there is no such lock or CPU, 0 otherwise.
+ */
+int bakery_lock_get_stats(unsigned int index, unsigned int cpu,
+			  bakery_lock_stats_t *stats);
+#endif
+
 #define DEFINE_BAKERY_LOCK(_name) bakery_lock_t _name __section("bakery_lock")
 
 #define DECLARE_BAKERY_LOCK(_name) extern bakery_lock_t _name
@@ -511,6 +511,12 @@ CASSERT(CTX_PAUTH_REGS_OFFSET == __builtin_offsetof(cpu_context_t, pauth_ctx), \
 void el1_sysregs_context_save(el1_sysregs_t *regs);
 void el1_sysregs_context_restore(el1_sysregs_t *regs);
 
+#if CTX_EL1_LAZY_SWITCH
+void el1_sysregs_context_save_core(el1_sysregs_t *regs);
+void el1_sysregs_context_restore_core(el1_sysregs_t *regs);
+void el1_sysregs_context_save_aux(el1_sysregs_t *regs);
+#endif
+
 #if CTX_INCLUDE_EL2_REGS
 void el2_sysregs_context_save(el2_sysregs_t *regs);
 void el2_sysregs_context_restore(el2_sysregs_t *regs);
@@ -43,6 +43,8 @@ void cm_el2_sysregs_context_restore(uint32_t security_state);
 
 void cm_el1_sysregs_context_save(uint32_t security_state);
 void cm_el1_sysregs_context_restore(uint32_t security_state);
+void cm_el1_sysregs_context_save_lazy(uint32_t security_state);
+void cm_el1_sysregs_context_restore_lazy(uint32_t security_state);
 void cm_set_elr_el3(uint32_t security_state, uintptr_t entrypoint);
 void cm_set_elr_spsr_el3(uint32_t security_state,
 			uintptr_t entrypoint, uint32_t spsr);
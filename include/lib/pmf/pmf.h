@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -40,7 +40,12 @@
  */
 #define PMF_SMC_GET_TIMESTAMP_32	U(0x82000010)
 #define PMF_SMC_GET_TIMESTAMP_64	U(0xC2000010)
-#define PMF_NUM_SMC_CALLS		2
+#define PMF_SMC_GET_TIMELINE_32		U(0x82000011)
+#define PMF_SMC_GET_TIMELINE_64		U(0xC2000011)
+#define PMF_SMC_GET_SMC_LAT_32		U(0x82000012)
+#define PMF_SMC_GET_SMC_LAT_64		U(0xC2000012)
+#define PMF_NUM_SMC_CALLS		(2 + (2 * ENABLE_BOOT_TIMELINE) + \
+					 (2 * ENABLE_SMC_LATENCY_STATS))
 
 /*
  * The macros below are used to identify
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PMF_SMC_LAT_H
+#define PMF_SMC_LAT_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * SMC latency statistics.
+ *
+ * With ENABLE_SMC_LATENCY_STATS, the time every SMC spends in its runtime
+ * service handler is measured with the system counter and accounted per CPU
+ * and per SMC function ID, without any lock: the number of calls, the minimum
+ * and maximum latencies and a histogram with log2-scaled buckets, bucket 'n'
+ * counting the calls that took [2^n, 2^(n+1)) counter ticks. The last bucket
+ * also counts all the longer calls.
+ *
+ * The statistics are read with PMF_SMC_GET_SMC_LAT:
+ *   x1: SMC function ID, or 0 to list the function IDs seen by a CPU
+ *   x2: CPU index, or PMF_SMC_LAT_ALL_CPUS for the sum over all CPUs
+ *   x3: page
+ * returning in x0 an error code and, for a function ID:
+ *   page 0: x1 = number of calls, x2 = minimum, x3 = maximum latency
+ *   page n: x1-x7 = histogram buckets 7 * (n - 1) to 7 * (n - 1) + 6
+ * or, when listing the function IDs of a CPU, x1-x7 = the function IDs in
+ * entries 7 * page to 7 * page + 6, 0 for unused entries.
+ */
+#define PMF_SMC_LAT_BUCKETS	U(16)
+#define PMF_SMC_LAT_FIDS	U(32)
+#define PMF_SMC_LAT_PAGE_WORDS	U(7)
+#define PMF_SMC_LAT_ALL_CPUS	U(0xffffffff)
+
+void pmf_smc_lat_record(uint32_t smc_fid, uint64_t start);
+int pmf_smc_lat_get(uint32_t smc_fid, unsigned int cpu, unsigned int page,
+		    uint64_t out[PMF_SMC_LAT_PAGE_WORDS]);
+
+#endif /* PMF_SMC_LAT_H */
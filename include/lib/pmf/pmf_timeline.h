@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PMF_TIMELINE_H
+#define PMF_TIMELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+
+/*
+ * Boot timeline.
+ *
+ * The timeline is a list of named spans and events, time-stamped with the
+ * system counter, kept in a memory region that BL2 initializes and that BL31
+ * keeps appending to. It is left in place for the Normal world, which can find
+ * it with PMF_SMC_GET_TIMELINE. The layout below is the interface with the
+ * Normal world, so it only changes with PMF_TL_VERSION.
+ */
+#define PMF_TL_MAGIC		U(0x4C544D50)	/* "PMTL" */
+#define PMF_TL_VERSION		U(1)
+#define PMF_TL_NAME_LEN		U(24)
+
+/* Image that recorded an entry */
+#define PMF_TL_BL2		U(2)
+#define PMF_TL_BL31		U(31)
+
+/* Entry flags */
+#define PMF_TL_FLAG_EVENT	(U(1) << 0)	/* Instant, 'end' is unused */
+#define PMF_TL_FLAG_OPEN	(U(1) << 1)	/* Span never closed */
+
+typedef struct pmf_tl_header {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t entry_size;
+	uint32_t count;		/* Entries recorded */
+	uint32_t capacity;	/* Entries that fit in the region */
+	uint64_t cntfrq;	/* Frequency of the time-stamps, in Hz */
+	uint32_t depth;		/* Spans currently open */
+	uint32_t dropped;	/* Entries lost because the region was full */
+} pmf_tl_header_t;
+
+typedef struct pmf_tl_entry {
+	uint64_t start;		/* System counter value */
+	uint64_t end;
+	uint32_t arg;		/* Caller defined, e.g. an image id */
+	uint8_t image;		/* PMF_TL_BLx */
+	uint8_t depth;		/* Nesting level of the span */
+	uint16_t flags;
+	char name[PMF_TL_NAME_LEN];
+} pmf_tl_entry_t;
+
+CASSERT(sizeof(pmf_tl_header_t) == 32U, assert_pmf_tl_header_size);
+CASSERT(sizeof(pmf_tl_entry_t) == 48U, assert_pmf_tl_entry_size);
+
+#if ENABLE_BOOT_TIMELINE && (defined(IMAGE_BL2) || defined(IMAGE_BL31))
+/*
+ * Convenience macros for recording the boot timeline. They compile to nothing
+ * when ENABLE_BOOT_TIMELINE is not set and in images which do not record the
+ * timeline. PMF_TL_BEGIN() returns a handle to be passed to PMF_TL_END() once
+ * the span is over.
+ */
+#define PMF_TL_BEGIN(_name, _arg)	pmf_tl_begin((_name), (uint32_t)(_arg))
+#define PMF_TL_END(_handle)		pmf_tl_end(_handle)
+#define PMF_TL_EVENT(_name, _arg)	pmf_tl_event((_name), (uint32_t)(_arg))
+#else
+#define PMF_TL_BEGIN(_name, _arg)	(-1)
+#define PMF_TL_END(_handle)		((void)(_handle))
+#define PMF_TL_EVENT(_name, _arg)	((void)0)
+#endif /* ENABLE_BOOT_TIMELINE */
+
+/*******************************************************************************
+ * Function & variable prototypes
+ ******************************************************************************/
+void pmf_tl_init(void);
+int pmf_tl_begin(const char *name, uint32_t arg);
+void pmf_tl_end(int handle);
+void pmf_tl_event(const char *name, uint32_t arg);
+void pmf_tl_flush(void);
+int pmf_tl_get_region(uintptr_t *base, size_t *size);
+
+#endif /* PMF_TIMELINE_H */
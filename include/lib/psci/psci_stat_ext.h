@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PSCI_STAT_EXT_H
+#define PSCI_STAT_EXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Extended PSCI statistics.
+ *
+ * With ENABLE_PSCI_STAT_EXT, each CPU keeps, for each power state it suspends
+ * to, a record of its transitions. A power state is identified by the highest
+ * power level it affects and by the index of the local state at that level
+ * (see the `get_pwr_lvl_state_idx` PM hook), the same way as for
+ * PSCI_STAT_RESIDENCY and PSCI_STAT_COUNT. All times are in system counter
+ * ticks:
+ *  - entry latency: from the start of the suspend request to the WFI.
+ *  - sleep time: from the WFI to the first instruction run by BL31 on
+ *    wake-up, i.e. the residency in the state plus the hardware wake-up time.
+ *  - exit latency: from there to the point where the PSCI statistics are
+ *    updated, just before the CPU returns to the caller.
+ * Histogram bucket 'n' counts the transitions that took [2^n, 2^(n+1)) ticks,
+ * the last bucket also counts all the longer ones.
+ *
+ * Aborted entries are suspend requests that found a wake-up interrupt pending
+ * before the WFI. They are accounted against the requested state.
+ *
+ * psci_stat_ext_snapshot() copies the statistics of all the CPUs to a buffer,
+ * as a psci_stat_ext_hdr_t followed by the records, indexed by
+ * [cpu][power level][state index].
+ */
+#define PSCI_STAT_EXT_MAGIC		U(0x54535350)	/* "PSST" */
+#define PSCI_STAT_EXT_VERSION		U(1)
+#define PSCI_STAT_EXT_BUCKETS		U(16)
+
+typedef struct psci_stat_ext_hdr {
+	uint32_t magic;
+	uint32_t version;
+	/* Size of the snapshot, header included */
+	uint32_t size;
+	uint32_t cpu_count;
+	uint32_t lvl_count;
+	uint32_t state_count;
+	uint32_t bucket_count;
+	uint32_t rec_size;
+	/* System counter frequency and value when the snapshot was taken */
+	uint64_t cntfrq;
+	uint64_t timestamp;
+} psci_stat_ext_hdr_t;
+
+typedef struct psci_stat_ext_rec {
+	uint64_t wakeups;
+	uint64_t aborts;
+	uint64_t sleep_time;
+	uint64_t entry_lat_max;
+	uint64_t exit_lat_max;
+	uint32_t entry_lat[PSCI_STAT_EXT_BUCKETS];
+	uint32_t exit_lat[PSCI_STAT_EXT_BUCKETS];
+} psci_stat_ext_rec_t;
+
+/*
+ * Copy a snapshot of the statistics to 'buf'. Returns the size of the
+ * snapshot, or 0 if it does not fit in 'size' bytes.
+ */
+size_t psci_stat_ext_snapshot(void *buf, size_t size);
+
+#endif /* PSCI_STAT_EXT_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -337,6 +337,24 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx,
 				uintptr_t base_va,
 				size_t size);
 
+/*
+ * Start and end a batch of dynamic region changes. Between the two calls, the
+ * regions added and removed are only guaranteed to be visible by the system
+ * once the batch is ended: the data cache clean of the base translation table
+ * is done once for the whole batch, and the TLB entries of the removed regions
+ * are invalidated all at once, by range or for the whole translation regime
+ * depending on the size of the VA range they cover. Adding a region completes
+ * the invalidations pending before it, so that the translation table entries
+ * freed by the regions removed can be reused.
+ *
+ * The memory of a region removed in the batch mustn't be reused for anything
+ * else before the batch is ended. Batches can't be nested.
+ */
+void xlat_batch_begin(void);
+void xlat_batch_begin_ctx(xlat_ctx_t *ctx);
+void xlat_batch_end(void);
+void xlat_batch_end_ctx(xlat_ctx_t *ctx);
+
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
 /*
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -80,6 +80,15 @@ struct xlat_ctx {
 	 */
 #if PLAT_XLAT_TABLES_DYNAMIC
 	int *tables_mapped_regions;
+
+	/*
+	 * Set between xlat_batch_begin_ctx() and xlat_batch_end_ctx(), when the
+	 * TLB invalidations are deferred. The VA range left to invalidate is
+	 * [tlbi_va, tlbi_va + tlbi_size).
+	 */
+	bool batch;
+	uintptr_t tlbi_va;
+	size_t tlbi_size;
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
 	int next_table;
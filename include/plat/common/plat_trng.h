@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, ARM Limited. All rights reserved.
+ * Copyright (c) 2021-2022, ARM Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,5 +14,6 @@
 extern uuid_t plat_trng_uuid;
 void plat_entropy_setup(void);
 bool plat_get_entropy(uint64_t *out);
+unsigned int plat_get_entropy_bulk(uint64_t *out, unsigned int nwords);
 
 #endif /* PLAT_TRNG_H */
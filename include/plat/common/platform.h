@@ -7,6 +7,7 @@
 #ifndef PLATFORM_H
 #define PLATFORM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <lib/psci/psci.h>
@@ -246,6 +247,17 @@ void bl2_el3_plat_arch_setup(void);
  ******************************************************************************/
 void bl2_el3_plat_prepare_exit(void);
 
+/*******************************************************************************
+ * Mandatory BL2 at EL3 functions when BL2_PARALLEL_AUTH is enabled
+ ******************************************************************************/
+#if BL2_PARALLEL_AUTH
+int bl2_plat_worker_release(unsigned int core_pos, uintptr_t entrypoint);
+void bl2_plat_worker_setup(void);
+void bl2_plat_worker_park(void);
+void __dead2 bl2_plat_worker_pwr_down(void);
+bool bl2_plat_defer_image_auth(unsigned int image_id);
+#endif
+
 /*******************************************************************************
  * Mandatory BL2U functions.
  ******************************************************************************/
@@ -315,6 +327,11 @@ int get_mbedtls_heap_helper(void **heap_addr, size_t *heap_size);
 int plat_get_enc_key_info(enum fw_enc_status_t fw_enc_status, uint8_t *key,
 			  size_t *key_len, unsigned int *flags,
 			  const uint8_t *img_id, size_t img_id_len);
+#if AUTH_SIG_CACHE
+int plat_get_sig_cache_key(uint8_t **key, size_t *key_len);
+int plat_sig_cache_read(void *buf, size_t len);
+int plat_sig_cache_write(const void *buf, size_t len);
+#endif
 
 /*******************************************************************************
  * Secure Partitions functions
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -73,9 +73,21 @@
 #define SDEI_EXPLICIT_EVENT(_event, _pri) \
 	SDEI_EVENT_MAP((_event), 0, (_pri) | SDEI_MAPF_EXPLICIT | SDEI_MAPF_PRIVATE)
 
+/*
+ * Number of slots of the SDEI map hash tables for '_n' mappings: the smallest
+ * power of two that is at least twice '_n', so that the tables are never more
+ * than half full.
+ */
+#define SDEI_HASH_OR_SHIFT_(_x, _s)	((_x) | ((_x) >> (_s)))
+#define SDEI_HASH_SIZE_(_n) \
+	(SDEI_HASH_OR_SHIFT_(SDEI_HASH_OR_SHIFT_(SDEI_HASH_OR_SHIFT_( \
+	 SDEI_HASH_OR_SHIFT_(SDEI_HASH_OR_SHIFT_((2U * (_n)) - 1U, \
+	 1), 2), 4), 8), 16) + 1U)
+
 /*
  * Declare shared and private entries for each core. Also declare a global
- * structure containing private and share entries.
+ * structure containing private and share entries, and the hash tables used to
+ * look the mappings up by event number and by interrupt.
  *
  * This macro must be used in the same file as the platform SDEI mappings are
  * declared. Only then would ARRAY_SIZE() yield a meaningful value.
@@ -84,6 +96,12 @@
 	sdei_entry_t sdei_private_event_table \
 		[PLATFORM_CORE_COUNT * ARRAY_SIZE(_private)]; \
 	sdei_entry_t sdei_shared_event_table[ARRAY_SIZE(_shared)]; \
+	sdei_ev_map_t *sdei_event_hash[SDEI_HASH_SIZE_(ARRAY_SIZE(_private) + \
+			ARRAY_SIZE(_shared))]; \
+	sdei_ev_map_t *sdei_intr_hash[SDEI_HASH_SIZE_(ARRAY_SIZE(_private) + \
+			ARRAY_SIZE(_shared))]; \
+	const unsigned int sdei_hash_size = \
+		SDEI_HASH_SIZE_(ARRAY_SIZE(_private) + ARRAY_SIZE(_shared)); \
 	const sdei_mapping_t sdei_global_mappings[] = { \
 		[SDEI_MAP_IDX_PRIV_] = { \
 			.map = (_private), \
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -35,7 +35,8 @@ enum {
 	DEV_ROOT_QFIP,
 	DEV_ROOT_QBLOBS,
 	DEV_ROOT_QBLOBCTL,
-	DEV_ROOT_QPSCI
+	DEV_ROOT_QPSCI,
+	DEV_ROOT_QBAKERY
 };
 
 /*******************************************************************************
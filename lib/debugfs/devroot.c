@@ -1,12 +1,14 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 #include <common/debug.h>
+#include <lib/bakery_lock.h>
 #include <lib/debugfs.h>
+#include <string.h>
 
 #include "blobs.h"
 #include "dev.h"
@@ -21,8 +23,43 @@ static const dirtab_t dirtab[] = {
 };
 
 static const dirtab_t devfstab[] = {
+#if BAKERY_LOCK_STATS
+	{"bakery", DEV_ROOT_QBAKERY, 0, O_READ},
+#endif
 };
 
+#if BAKERY_LOCK_STATS
+/*******************************************************************************
+ * This function copies at most size bytes of the bakery lock statistics into
+ * buf. The file is an array of bakery_lock_stats_t, PLATFORM_CORE_COUNT for
+ * each lock in the order of the bakery lock section.
+ ******************************************************************************/
+static int bakeryread(chan_t *channel, void *buf, int size)
+{
+	bakery_lock_stats_t stats;
+	unsigned long idx;
+	int off, n, done = 0;
+
+	while (done < size) {
+		idx = (unsigned long)channel->offset / sizeof(stats);
+		off = (int)((unsigned long)channel->offset % sizeof(stats));
+
+		if (bakery_lock_get_stats(idx / PLATFORM_CORE_COUNT,
+					  idx % PLATFORM_CORE_COUNT,
+					  &stats) != 0) {
+			break;
+		}
+
+		n = MIN(size - done, (int)sizeof(stats) - off);
+		memcpy((char *)buf + done, (char *)&stats + off, n);
+		channel->offset += n;
+		done += n;
+	}
+
+	return done;
+}
+#endif /* BAKERY_LOCK_STATS */
+
 /*******************************************************************************
  * This function exposes the elements of the root directory.
  * It also exposes the content of the dev and blobs directories.
@@ -72,6 +109,12 @@ static int rootread(chan_t *channel, void *buf, int size)
 		return dirread(channel, dir, NULL, 0, rootgen);
 	}
 
+#if BAKERY_LOCK_STATS
+	if (channel->qid == DEV_ROOT_QBAKERY) {
+		return bakeryread(channel, buf, size);
+	}
+#endif
+
 	/* Only makes sense when using debug language */
 	assert(channel->qid != DEV_ROOT_QBLOBCTL);
 
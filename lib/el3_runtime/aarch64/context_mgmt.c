@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,6 +15,7 @@
 #include <arch_features.h>
 #include <bl31/interrupt_mgmt.h>
 #include <common/bl_common.h>
+#include <common/debug.h>
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/pubsub_events.h>
@@ -28,9 +29,49 @@
 #include <lib/extensions/trf.h>
 #include <lib/extensions/twed.h>
 #include <lib/utils.h>
+#include <plat/common/platform.h>
 
 static void manage_extensions_secure(cpu_context_t *ctx);
 
+#if CTX_EL1_LAZY_SWITCH
+/*
+ * Per-CPU state of the lazy EL1 context switch:
+ * - el1_hw_is_ns: the auxiliary EL1 registers in hardware hold the
+ *   non-secure values.
+ * - el1_ns_stale: the auxiliary registers in the non-secure context are
+ *   out of date and must be read back from hardware before use.
+ */
+static bool el1_hw_is_ns[PLATFORM_CORE_COUNT];
+static bool el1_ns_stale[PLATFORM_CORE_COUNT];
+
+#if ENABLE_ASSERTIONS
+static el1_sysregs_t el1_aux_snapshot[PLATFORM_CORE_COUNT];
+static el1_sysregs_t el1_aux_check[PLATFORM_CORE_COUNT];
+#endif
+
+static void cm_el1_lazy_reset(unsigned int cpu_idx)
+{
+	el1_hw_is_ns[cpu_idx] = false;
+	el1_ns_stale[cpu_idx] = false;
+}
+
+/*
+ * Write the auxiliary EL1 registers still live in hardware back to the
+ * non-secure context, before they are overwritten or the context is read.
+ */
+static void cm_el1_lazy_sync(void)
+{
+	unsigned int cpu_idx = plat_my_core_pos();
+
+	if (el1_ns_stale[cpu_idx]) {
+		assert(el1_hw_is_ns[cpu_idx]);
+		el1_sysregs_context_save_aux(
+			get_el1_sysregs_ctx(cm_get_context(NON_SECURE)));
+		el1_ns_stale[cpu_idx] = false;
+	}
+}
+#endif /* CTX_EL1_LAZY_SWITCH */
+
 /*******************************************************************************
  * Context management library initialisation routine. This library is used by
  * runtime services to share pointers to 'cpu_context' structures for the secure
@@ -452,6 +493,10 @@ void cm_init_context_by_index(unsigned int cpu_idx,
 	cpu_context_t *ctx;
 	ctx = cm_get_context_by_index(cpu_idx, GET_SECURITY_STATE(ep->h.attr));
 	cm_setup_context(ctx, ep);
+#if CTX_EL1_LAZY_SWITCH
+	if (GET_SECURITY_STATE(ep->h.attr) == NON_SECURE)
+		cm_el1_lazy_reset(cpu_idx);
+#endif
 }
 
 /*******************************************************************************
@@ -464,6 +509,10 @@ void cm_init_my_context(const entry_point_info_t *ep)
 	cpu_context_t *ctx;
 	ctx = cm_get_context(GET_SECURITY_STATE(ep->h.attr));
 	cm_setup_context(ctx, ep);
+#if CTX_EL1_LAZY_SWITCH
+	if (GET_SECURITY_STATE(ep->h.attr) == NON_SECURE)
+		cm_el1_lazy_reset(plat_my_core_pos());
+#endif
 }
 
 /*******************************************************************************
@@ -751,6 +800,11 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 
 	el1_sysregs_context_save(get_el1_sysregs_ctx(ctx));
 
+#if CTX_EL1_LAZY_SWITCH
+	if (security_state == NON_SECURE)
+		el1_ns_stale[plat_my_core_pos()] = false;
+#endif
+
 #if IMAGE_BL31
 	if (security_state == SECURE)
 		PUBLISH_EVENT(cm_exited_secure_world);
@@ -766,6 +820,11 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
 
+#if CTX_EL1_LAZY_SWITCH
+	cm_el1_lazy_sync();
+	el1_hw_is_ns[plat_my_core_pos()] = (security_state == NON_SECURE);
+#endif
+
 	el1_sysregs_context_restore(get_el1_sysregs_ctx(ctx));
 
 #if IMAGE_BL31
@@ -776,6 +835,85 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 #endif
 }
 
+/*******************************************************************************
+ * Lazy variants of cm_el1_sysregs_context_save/restore for use by SPDs on the
+ * world switch path. With CTX_EL1_LAZY_SWITCH, only the EL1 registers that the
+ * secure payload uses are switched and the auxiliary ones (see context.S) keep
+ * their non-secure values while the secure world runs. Otherwise they are the
+ * same as the full versions.
+ ******************************************************************************/
+void cm_el1_sysregs_context_save_lazy(uint32_t security_state)
+{
+#if CTX_EL1_LAZY_SWITCH
+	cpu_context_t *ctx;
+	unsigned int cpu_idx = plat_my_core_pos();
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+	el1_sysregs_context_save_core(get_el1_sysregs_ctx(ctx));
+
+	if (security_state == NON_SECURE) {
+		el1_hw_is_ns[cpu_idx] = true;
+		el1_ns_stale[cpu_idx] = true;
+#if ENABLE_ASSERTIONS
+		zeromem(&el1_aux_snapshot[cpu_idx], sizeof(el1_sysregs_t));
+		el1_sysregs_context_save_aux(&el1_aux_snapshot[cpu_idx]);
+#endif
+	}
+
+#if IMAGE_BL31
+	if (security_state == SECURE)
+		PUBLISH_EVENT(cm_exited_secure_world);
+	else
+		PUBLISH_EVENT(cm_exited_normal_world);
+#endif
+#else
+	cm_el1_sysregs_context_save(security_state);
+#endif /* CTX_EL1_LAZY_SWITCH */
+}
+
+void cm_el1_sysregs_context_restore_lazy(uint32_t security_state)
+{
+#if CTX_EL1_LAZY_SWITCH
+	cpu_context_t *ctx;
+	unsigned int cpu_idx = plat_my_core_pos();
+
+	/* The auxiliary registers only need restoring if they were replaced */
+	if ((security_state == NON_SECURE) && !el1_hw_is_ns[cpu_idx]) {
+		cm_el1_sysregs_context_restore(NON_SECURE);
+		return;
+	}
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+#if ENABLE_ASSERTIONS
+	/* Check that the secure payload left the auxiliary registers alone */
+	if (security_state == NON_SECURE) {
+		zeromem(&el1_aux_check[cpu_idx], sizeof(el1_sysregs_t));
+		el1_sysregs_context_save_aux(&el1_aux_check[cpu_idx]);
+		if (memcmp(&el1_aux_check[cpu_idx], &el1_aux_snapshot[cpu_idx],
+			   sizeof(el1_sysregs_t)) != 0) {
+			ERROR("EL1 registers modified by the secure world\n");
+			panic();
+		}
+	}
+#endif
+
+	el1_sysregs_context_restore_core(get_el1_sysregs_ctx(ctx));
+
+#if IMAGE_BL31
+	if (security_state == SECURE)
+		PUBLISH_EVENT(cm_entering_secure_world);
+	else
+		PUBLISH_EVENT(cm_entering_normal_world);
+#endif
+#else
+	cm_el1_sysregs_context_restore(security_state);
+#endif /* CTX_EL1_LAZY_SWITCH */
+}
+
 /*******************************************************************************
  * This function populates ELR_EL3 member of 'cpu_context' pertaining to the
  * given security state with the given entrypoint
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -94,6 +94,7 @@ void bakery_lock_get(bakery_lock_t *bakery)
 	unsigned int they, me;
 	unsigned int my_ticket, my_prio, their_ticket;
 	unsigned int their_bakery_data;
+	__unused bool contended = false;
 
 	me = plat_my_core_pos();
 
@@ -129,6 +130,7 @@ void bakery_lock_get(bakery_lock_t *bakery)
 			 * to have it dropped to 0; or drop and probably content
 			 * again for the same lock to have an even higher value)
 			 */
+			contended = true;
 			do {
 				wfe();
 			} while (their_ticket ==
@@ -136,6 +138,10 @@ void bakery_lock_get(bakery_lock_t *bakery)
 		}
 	}
 
+#if BAKERY_LOCK_STATS
+	bakery_stats_acquired(&bakery->stats[me], contended);
+#endif
+
 	/*
 	 * Lock acquired. Ensure that any reads and writes from a shared
 	 * resource in the critical section read/write values after the lock is
@@ -153,6 +159,10 @@ void bakery_lock_release(bakery_lock_t *bakery)
 	assert_bakery_entry_valid(me, bakery);
 	assert(bakery_ticket_number(bakery->lock_data[me]) != 0U);
 
+#if BAKERY_LOCK_STATS
+	bakery_stats_released(&bakery->stats[me]);
+#endif
+
 	/*
 	 * Ensure that other observers see any stores in the critical section
 	 * before releasing the lock. Also ensure all loads in the critical
@@ -166,3 +176,24 @@ void bakery_lock_release(bakery_lock_t *bakery)
 	dsb();
 	sev();
 }
+
+#if BAKERY_LOCK_STATS
+IMPORT_SYM(uintptr_t, __BAKERY_LOCK_START__, BAKERY_LOCK_START);
+IMPORT_SYM(uintptr_t, __BAKERY_LOCK_END__, BAKERY_LOCK_END);
+
+int bakery_lock_get_stats(unsigned int index, unsigned int cpu,
+			  bakery_lock_stats_t *stats)
+{
+	const bakery_lock_t *bakery;
+
+	if ((cpu >= BAKERY_LOCK_MAX_CPUS) ||
+	    ((BAKERY_LOCK_START + ((index + 1U) * sizeof(bakery_lock_t))) >
+	     BAKERY_LOCK_END))
+		return -1;
+
+	bakery = (const bakery_lock_t *)BAKERY_LOCK_START + index;
+	*stats = bakery->stats[cpu];
+
+	return 0;
+}
+#endif /* BAKERY_LOCK_STATS */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -35,6 +35,9 @@
  * accesses regardless of status of address translation.
  */
 
+/* Bakery locks of the first CPU */
+IMPORT_SYM(uintptr_t, __PERCPU_BAKERY_LOCK_START__, BAKERY_LOCK_START);
+
 #ifdef PLAT_PERCPU_BAKERY_LOCK_SIZE
 /*
  * Verify that the platform defined value for the per-cpu space for bakery locks is
@@ -52,11 +55,15 @@ CASSERT((PLAT_PERCPU_BAKERY_LOCK_SIZE & (CACHE_WRITEBACK_GRANULE - 1)) == 0, \
  * Use the linker defined symbol which has evaluated the size reqiurement.
  * This is not as efficient as using a platform defined constant
  */
-IMPORT_SYM(uintptr_t, __PERCPU_BAKERY_LOCK_START__, BAKERY_LOCK_START);
 IMPORT_SYM(uintptr_t, __PERCPU_BAKERY_LOCK_END__, BAKERY_LOCK_END);
 #define PERCPU_BAKERY_LOCK_SIZE (BAKERY_LOCK_END - BAKERY_LOCK_START)
 #endif
 
+#if BAKERY_LOCK_STATS
+CASSERT(sizeof(bakery_info_t) == CACHE_WRITEBACK_GRANULE,
+	assert_bakery_info_one_cache_line);
+#endif
+
 static inline bakery_lock_t *get_bakery_info(unsigned int cpu_ix,
 					     bakery_lock_t *lock)
 {
@@ -82,6 +89,25 @@ static inline void read_cache_op(uintptr_t addr, bool cached)
 	dmbish();
 }
 
+/*
+ * Same as read_cache_op() for the bakery information of all the CPUs but 'me',
+ * with a single barrier.
+ */
+static inline void read_cache_op_others(bakery_lock_t *lock, unsigned int me,
+					bool cached)
+{
+	unsigned int they;
+
+	if (cached) {
+		for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+			if (me != they)
+				dccivac((uintptr_t)get_bakery_info(they, lock));
+		}
+	}
+
+	dmbish();
+}
+
 /* Helper function to check if the lock is acquired */
 static inline bool is_lock_acquired(const bakery_info_t *my_bakery_info,
 				    bool is_cached)
@@ -126,21 +152,19 @@ static unsigned int bakery_get_ticket(bakery_lock_t *lock,
 
 	/*
 	 * Iterate through the bakery information of each contender to allocate
-	 * the highest ticket number for this cpu.
+	 * the highest ticket number for this cpu, after ensuring that stale
+	 * copies of them are not read.
 	 */
+	read_cache_op_others(lock, me, is_cached);
+
 	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
 		if (me == they)
 			continue;
 
-		/*
-		 * Get a reference to the other contender's bakery info and
-		 * ensure that a stale copy is not read.
-		 */
+		/* Get a reference to the other contender's bakery info */
 		their_bakery_info = get_bakery_info(they, lock);
 		assert(their_bakery_info != NULL);
 
-		read_cache_op((uintptr_t)their_bakery_info, is_cached);
-
 		/*
 		 * Update this cpu's ticket number if a higher ticket number is
 		 * seen
@@ -169,6 +193,7 @@ void bakery_lock_get(bakery_lock_t *lock)
 	bakery_info_t *their_bakery_info;
 	unsigned int their_bakery_data;
 	bool is_cached;
+	__unused bool contended = false;
 
 	me = plat_my_core_pos();
 	is_cached = is_dcache_enabled();
@@ -181,22 +206,28 @@ void bakery_lock_get(bakery_lock_t *lock)
 	 * with that of others, and proceed to acquire the lock
 	 */
 	my_prio = bakery_get_priority(my_ticket, me);
+
+	/*
+	 * Ensure that stale copies of the other contenders' bakery info are not
+	 * read. Reading them later than this is fine: any change made after
+	 * our ticket was chosen can only give them a lower priority.
+	 */
+	read_cache_op_others(lock, me, is_cached);
+
 	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
 		if (me == they)
 			continue;
 
-		/*
-		 * Get a reference to the other contender's bakery info and
-		 * ensure that a stale copy is not read.
-		 */
+		/* Get a reference to the other contender's bakery info */
 		their_bakery_info = get_bakery_info(they, lock);
 		assert(their_bakery_info != NULL);
 
 		/* Wait for the contender to get their ticket */
-		do {
+		their_bakery_data = their_bakery_info->lock_data;
+		while (bakery_is_choosing(their_bakery_data)) {
 			read_cache_op((uintptr_t)their_bakery_info, is_cached);
 			their_bakery_data = their_bakery_info->lock_data;
-		} while (bakery_is_choosing(their_bakery_data));
+		}
 
 		/*
 		 * If the other party is a contender, they'll have non-zero
@@ -210,6 +241,7 @@ void bakery_lock_get(bakery_lock_t *lock)
 			 * to have it dropped to 0; or drop and probably content
 			 * again for the same lock to have an even higher value)
 			 */
+			contended = true;
 			do {
 				wfe();
 				read_cache_op((uintptr_t)their_bakery_info, is_cached);
@@ -218,6 +250,11 @@ void bakery_lock_get(bakery_lock_t *lock)
 		}
 	}
 
+#if BAKERY_LOCK_STATS
+	bakery_stats_acquired(&get_bakery_info(me, lock)->stats, contended);
+	write_cache_op((uintptr_t)get_bakery_info(me, lock), is_cached);
+#endif
+
 	/*
 	 * Lock acquired. Ensure that any reads and writes from a shared
 	 * resource in the critical section read/write values after the lock is
@@ -235,6 +272,11 @@ void bakery_lock_release(bakery_lock_t *lock)
 
 	assert(is_lock_acquired(my_bakery_info, is_cached));
 
+#if BAKERY_LOCK_STATS
+	read_cache_op((uintptr_t)my_bakery_info, is_cached);
+	bakery_stats_released(&my_bakery_info->stats);
+#endif
+
 	/*
 	 * Ensure that other observers see any stores in the critical section
 	 * before releasing the lock. Also ensure all loads in the critical
@@ -248,3 +290,21 @@ void bakery_lock_release(bakery_lock_t *lock)
 	/* This sev is ordered by the dsbish in write_cahce_op */
 	sev();
 }
+
+#if BAKERY_LOCK_STATS
+int bakery_lock_get_stats(unsigned int index, unsigned int cpu,
+			  bakery_lock_stats_t *stats)
+{
+	bakery_info_t *info;
+
+	if ((cpu >= BAKERY_LOCK_MAX_CPUS) ||
+	    (((index + 1U) * sizeof(bakery_info_t)) > PERCPU_BAKERY_LOCK_SIZE))
+		return -1;
+
+	info = get_bakery_info(cpu, (bakery_lock_t *)BAKERY_LOCK_START + index);
+	read_cache_op((uintptr_t)info, is_dcache_enabled());
+	*stats = info->stats;
+
+	return 0;
+}
+#endif /* BAKERY_LOCK_STATS */
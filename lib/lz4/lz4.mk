@@ -0,0 +1,13 @@
+#
+# Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+LZ4_PATH	:=	lib/lz4
+
+# Implemented for TF
+LZ4_SOURCES	:=	$(addprefix $(LZ4_PATH)/,	\
+					tf_lz4.c)
+
+INCLUDES	+=	-Iinclude/lib/lz4
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/utils_def.h>
+#include <tf_lz4.h>
+
+/*
+ * Decoder for the LZ4 frame format (as produced by the lz4 command line
+ * tool).  LZ4 trades some compression ratio for a decoder that does little
+ * more than copy bytes around, which makes it several times faster than
+ * inflate.  No workspace is needed: back-references are resolved directly
+ * against the output buffer, so linked blocks are supported as well.
+ */
+
+#define LZ4_FRAME_MAGIC		U(0x184D2204)
+
+#define LZ4_FLG_VERSION_SHIFT	6
+#define LZ4_FLG_VERSION		U(1)
+#define LZ4_FLG_BLOCK_CHECKSUM	BIT_32(4)
+#define LZ4_FLG_CONTENT_SIZE	BIT_32(3)
+#define LZ4_FLG_CONTENT_CHECKSUM	BIT_32(2)
+#define LZ4_FLG_DICT_ID		BIT_32(0)
+
+#define LZ4_BLOCK_UNCOMPRESSED	BIT_32(31)
+
+#define LZ4_MIN_MATCH		4U
+#define LZ4_RUN_MASK		U(0xf)
+
+/* The output is cleaned to the PoC in chunks of this size. */
+#define LZ4_CHUNK_SIZE		U(0x40000)
+
+#define XXH_PRIME32_1		U(2654435761)
+#define XXH_PRIME32_2		U(2246822519)
+#define XXH_PRIME32_3		U(3266489917)
+#define XXH_PRIME32_4		U(668265263)
+#define XXH_PRIME32_5		U(374761393)
+
+struct lz4_out {
+	uint8_t *start;
+	uint8_t *pos;
+	uint8_t *end;
+	uintptr_t flushed;
+};
+
+static inline uint32_t get_le16(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static inline uint32_t get_le32(const uint8_t *p)
+{
+	return get_le16(p) | (get_le16(p + 2) << 16);
+}
+
+static inline uint32_t rotl32(uint32_t x, unsigned int r)
+{
+	return (x << r) | (x >> (32U - r));
+}
+
+static inline uint32_t xxh32_round(uint32_t acc, uint32_t input)
+{
+	acc += input * XXH_PRIME32_2;
+	return rotl32(acc, 13U) * XXH_PRIME32_1;
+}
+
+/* xxHash32, which LZ4 frames use for all their checksums */
+static uint32_t xxh32(const uint8_t *p, size_t len)
+{
+	const uint8_t *end = p + len;
+	uint32_t h;
+
+	if (len >= 16U) {
+		uint32_t v1 = XXH_PRIME32_1 + XXH_PRIME32_2;
+		uint32_t v2 = XXH_PRIME32_2;
+		uint32_t v3 = 0U;
+		uint32_t v4 = 0U - XXH_PRIME32_1;
+
+		do {
+			v1 = xxh32_round(v1, get_le32(p));
+			v2 = xxh32_round(v2, get_le32(p + 4));
+			v3 = xxh32_round(v3, get_le32(p + 8));
+			v4 = xxh32_round(v4, get_le32(p + 12));
+			p += 16;
+		} while ((size_t)(end - p) >= 16U);
+
+		h = rotl32(v1, 1U) + rotl32(v2, 7U) +
+		    rotl32(v3, 12U) + rotl32(v4, 18U);
+	} else {
+		h = XXH_PRIME32_5;
+	}
+
+	h += (uint32_t)len;
+
+	for (; (size_t)(end - p) >= 4U; p += 4) {
+		h += get_le32(p) * XXH_PRIME32_3;
+		h = rotl32(h, 17U) * XXH_PRIME32_4;
+	}
+
+	for (; p < end; p++) {
+		h += *p * XXH_PRIME32_5;
+		h = rotl32(h, 11U) * XXH_PRIME32_1;
+	}
+
+	h ^= h >> 15;
+	h *= XXH_PRIME32_2;
+	h ^= h >> 13;
+	h *= XXH_PRIME32_3;
+	h ^= h >> 16;
+
+	return h;
+}
+
+/*
+ * Room left for output.  When decompressing in place, the output must not run
+ * into the input which has not been consumed yet, starting at @in.
+ */
+static size_t lz4_out_space(const struct lz4_out *out, const uint8_t *in,
+			    const uint8_t *in_end)
+{
+	const uint8_t *end = out->end;
+
+	if ((in < end) && (in_end > out->pos))
+		end = (in > out->pos) ? in : out->pos;
+
+	return (size_t)(end - out->pos);
+}
+
+/* Clean the output produced so far to the PoC, one chunk at a time */
+static void lz4_flush(struct lz4_out *out, bool all)
+{
+	uintptr_t pos = (uintptr_t)out->pos;
+
+	if (all || ((pos - out->flushed) >= LZ4_CHUNK_SIZE)) {
+		flush_dcache_range(out->flushed, pos - out->flushed);
+		out->flushed = pos;
+	}
+}
+
+static int lz4_get_length(const uint8_t **ip, const uint8_t *ip_end,
+			  size_t *length)
+{
+	uint8_t b;
+
+	if (*length != LZ4_RUN_MASK)
+		return 0;
+
+	do {
+		if (*ip >= ip_end)
+			return -EIO;
+		b = *(*ip)++;
+		*length += b;
+	} while (b == 0xffU);
+
+	return 0;
+}
+
+static int lz4_decode_block(const uint8_t *ip, const uint8_t *ip_end,
+			    const uint8_t *in_end, struct lz4_out *out)
+{
+	const uint8_t *match;
+	size_t length, offset;
+	uint8_t token;
+
+	while (ip < ip_end) {
+		token = *ip++;
+
+		/* Literals, copied forward so they may overlap the input */
+		length = token >> 4;
+		if (lz4_get_length(&ip, ip_end, &length) != 0)
+			return -EIO;
+		if (length > (size_t)(ip_end - ip))
+			return -EIO;
+		if (length > lz4_out_space(out, ip + length, in_end))
+			return -ENOSPC;
+
+		(void)memmove(out->pos, ip, length);
+		out->pos += length;
+		ip += length;
+
+		/* The last sequence of a block only has literals */
+		if (ip == ip_end)
+			break;
+
+		if ((size_t)(ip_end - ip) < 2U)
+			return -EIO;
+		offset = get_le16(ip);
+		ip += 2;
+		if ((offset == 0U) ||
+		    (offset > (size_t)(out->pos - out->start)))
+			return -EIO;
+
+		length = token & LZ4_RUN_MASK;
+		if (lz4_get_length(&ip, ip_end, &length) != 0)
+			return -EIO;
+		length += LZ4_MIN_MATCH;
+		if (length > lz4_out_space(out, ip, in_end))
+			return -ENOSPC;
+
+		/* A match may overlap its own output */
+		match = out->pos - offset;
+		if (offset >= length) {
+			(void)memcpy(out->pos, match, length);
+			out->pos += length;
+		} else {
+			while (length-- > 0U)
+				*out->pos++ = *match++;
+		}
+
+		lz4_flush(out, false);
+	}
+
+	return 0;
+}
+
+/*
+ * unlz4 - decompress an LZ4 frame
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace (unused)
+ * @work_len: length of workspace (unused)
+ */
+int unlz4(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+	  size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	const uint8_t *ip = (const uint8_t *)*in_buf;
+	const uint8_t *in_end = ip + in_len;
+	const uint8_t *desc;
+	struct lz4_out out;
+	uint64_t content_size = 0ULL;
+	size_t desc_len, block_size;
+	uint32_t block;
+	uint8_t flg;
+	int ret;
+
+	out.start = (uint8_t *)*out_buf;
+	out.pos = out.start;
+	out.end = out.start + out_len;
+	out.flushed = *out_buf;
+
+	/* Magic, FLG, BD and header checksum */
+	if ((in_len < 7U) || (get_le32(ip) != LZ4_FRAME_MAGIC)) {
+		ERROR("lz4: not an LZ4 frame\n");
+		return -EINVAL;
+	}
+
+	desc = ip + 4;
+	flg = desc[0];
+	if ((flg >> LZ4_FLG_VERSION_SHIFT) != LZ4_FLG_VERSION) {
+		ERROR("lz4: unsupported frame version\n");
+		return -EINVAL;
+	}
+
+	if ((flg & LZ4_FLG_DICT_ID) != 0U) {
+		ERROR("lz4: dictionaries are not supported\n");
+		return -ENOTSUP;
+	}
+
+	desc_len = ((flg & LZ4_FLG_CONTENT_SIZE) != 0U) ? 10U : 2U;
+	if ((size_t)(in_end - desc) < (desc_len + 1U))
+		return -EIO;
+
+	if (((xxh32(desc, desc_len) >> 8) & 0xffU) != desc[desc_len]) {
+		ERROR("lz4: bad frame header checksum\n");
+		return -EIO;
+	}
+
+	if ((flg & LZ4_FLG_CONTENT_SIZE) != 0U) {
+		content_size = (uint64_t)get_le32(desc + 2) |
+			       ((uint64_t)get_le32(desc + 6) << 32);
+		if (content_size > out_len) {
+			ERROR("lz4: no room for output\n");
+			return -ENOSPC;
+		}
+	}
+
+	ip = desc + desc_len + 1U;
+
+	for (;;) {
+		if ((size_t)(in_end - ip) < 4U)
+			return -EIO;
+
+		block = get_le32(ip);
+		ip += 4;
+
+		/* EndMark */
+		if (block == 0U)
+			break;
+
+		block_size = block & ~LZ4_BLOCK_UNCOMPRESSED;
+		if (block_size > (size_t)(in_end - ip))
+			return -EIO;
+
+		/*
+		 * Check the block before decoding it: in place, decoding
+		 * overwrites the block as it goes.
+		 */
+		if ((flg & LZ4_FLG_BLOCK_CHECKSUM) != 0U) {
+			if ((size_t)(in_end - ip) < (block_size + 4U))
+				return -EIO;
+			if (xxh32(ip, block_size) != get_le32(ip + block_size)) {
+				ERROR("lz4: bad block checksum\n");
+				return -EIO;
+			}
+		}
+
+		if ((block & LZ4_BLOCK_UNCOMPRESSED) != 0U) {
+			if (block_size >
+			    lz4_out_space(&out, ip + block_size, in_end))
+				return -ENOSPC;
+			(void)memmove(out.pos, ip, block_size);
+			out.pos += block_size;
+			lz4_flush(&out, false);
+		} else {
+			ret = lz4_decode_block(ip, ip + block_size, in_end,
+					       &out);
+			if (ret != 0) {
+				ERROR("lz4: %s\n", (ret == -ENOSPC) ?
+				      "no room for output" : "corrupted block");
+				return ret;
+			}
+		}
+
+		ip += block_size;
+		if ((flg & LZ4_FLG_BLOCK_CHECKSUM) != 0U)
+			ip += 4;
+	}
+
+	lz4_flush(&out, true);
+
+	if (((flg & LZ4_FLG_CONTENT_SIZE) != 0U) &&
+	    (content_size != (uint64_t)(out.pos - out.start))) {
+		ERROR("lz4: unexpected content size\n");
+		return -EIO;
+	}
+
+	if ((flg & LZ4_FLG_CONTENT_CHECKSUM) != 0U) {
+		if ((size_t)(in_end - ip) < 4U)
+			return -EIO;
+		if (xxh32(out.start, out.pos - out.start) != get_le32(ip)) {
+			ERROR("lz4: bad content checksum\n");
+			return -EIO;
+		}
+		ip += 4;
+	}
+
+	VERBOSE("lz4: %lu byte input\n",
+		(unsigned long)(ip - (const uint8_t *)*in_buf));
+	VERBOSE("lz4: %lu byte output\n",
+		(unsigned long)(out.pos - out.start));
+
+	*in_buf = (uintptr_t)ip;
+	*out_buf = (uintptr_t)out.pos;
+
+	return 0;
+}
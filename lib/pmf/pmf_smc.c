@@ -1,13 +1,16 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <errno.h>
 
 #include <common/debug.h>
 #include <lib/pmf/pmf.h>
+#include <lib/pmf/pmf_smc_lat.h>
+#include <lib/pmf/pmf_timeline.h>
 #include <plat/common/platform.h>
 #include <smccc_helpers.h>
 
@@ -25,6 +28,44 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 {
 	int rc;
 	unsigned long long ts_value;
+#if ENABLE_BOOT_TIMELINE
+	uintptr_t tl_base;
+	size_t tl_size;
+#endif
+#if ENABLE_SMC_LATENCY_STATS
+	uint64_t lat[PMF_SMC_LAT_PAGE_WORDS];
+#endif
+
+#if ENABLE_BOOT_TIMELINE
+	if ((smc_fid == PMF_SMC_GET_TIMELINE_32) ||
+	    (smc_fid == PMF_SMC_GET_TIMELINE_64)) {
+		/*
+		 * Return error code and the location of the boot timeline.
+		 * x0 --> error code.
+		 * x1 --> base address of the timeline.
+		 * x2 --> size of the timeline region.
+		 */
+		if (pmf_tl_get_region(&tl_base, &tl_size) != 0) {
+			SMC_RET1(handle, -ENOENT);
+		}
+		SMC_RET3(handle, 0, tl_base, tl_size);
+	}
+#endif
+#if ENABLE_SMC_LATENCY_STATS
+	if ((smc_fid == PMF_SMC_GET_SMC_LAT_32) ||
+	    (smc_fid == PMF_SMC_GET_SMC_LAT_64)) {
+		/*
+		 * Return error code and a page of the SMC latency statistics,
+		 * see pmf_smc_lat.h.
+		 * x0 --> error code.
+		 * x1 - x7 --> statistics.
+		 */
+		rc = pmf_smc_lat_get((uint32_t)x1, (unsigned int)x2,
+				     (unsigned int)x3, lat);
+		SMC_RET8(handle, rc, lat[0], lat[1], lat[2], lat[3], lat[4],
+			 lat[5], lat[6]);
+	}
+#endif
 
 	if (((smc_fid >> FUNCID_CC_SHIFT) & FUNCID_CC_MASK) == SMC_32) {
 
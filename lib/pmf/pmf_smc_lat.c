@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <lib/cassert.h>
+#include <lib/pmf/pmf_smc_lat.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+typedef struct pmf_smc_lat_entry {
+	uint32_t smc_fid;
+	uint32_t count;
+	uint64_t min;
+	uint64_t max;
+	uint32_t buckets[PMF_SMC_LAT_BUCKETS];
+} pmf_smc_lat_entry_t;
+
+/*
+ * Each CPU only ever updates its own statistics, from the SMC exit path, so
+ * no lock is needed. Readers may see a partially updated entry of another CPU.
+ */
+typedef struct pmf_smc_lat_cpu {
+	pmf_smc_lat_entry_t entries[PMF_SMC_LAT_FIDS];
+	/* Calls not accounted because all the entries are in use */
+	uint32_t dropped;
+} __aligned(CACHE_WRITEBACK_GRANULE) pmf_smc_lat_cpu_t;
+
+static pmf_smc_lat_cpu_t pmf_smc_lat[PLATFORM_CORE_COUNT];
+
+CASSERT(IS_POWER_OF_TWO(PMF_SMC_LAT_FIDS), assert_pmf_smc_lat_fids_pow2);
+
+static unsigned int pmf_smc_lat_hash(uint32_t smc_fid)
+{
+	return ((smc_fid ^ (smc_fid >> 16)) * U(0x9e3779b1)) >>
+		(32 - __builtin_ctz(PMF_SMC_LAT_FIDS));
+}
+
+/*
+ * Find the entry of 'smc_fid' in the statistics of a CPU, allocating one if
+ * 'alloc' is true. Function ID 0 is never used by an SMC and marks free
+ * entries.
+ */
+static pmf_smc_lat_entry_t *pmf_smc_lat_find(pmf_smc_lat_cpu_t *cpu,
+					     uint32_t smc_fid, bool alloc)
+{
+	unsigned int i, idx = pmf_smc_lat_hash(smc_fid);
+
+	for (i = 0U; i < PMF_SMC_LAT_FIDS; i++) {
+		pmf_smc_lat_entry_t *entry = &cpu->entries[idx];
+
+		if (entry->smc_fid == smc_fid) {
+			return entry;
+		}
+		if (entry->smc_fid == 0U) {
+			if (!alloc) {
+				return NULL;
+			}
+			entry->min = UINT64_MAX;
+			entry->smc_fid = smc_fid;
+			return entry;
+		}
+		idx = (idx + 1U) & (PMF_SMC_LAT_FIDS - 1U);
+	}
+
+	return NULL;
+}
+
+/*
+ * Account an SMC that entered EL3 at counter value 'start'. Called from the
+ * SMC exit path once the runtime service handler has returned.
+ */
+void pmf_smc_lat_record(uint32_t smc_fid, uint64_t start)
+{
+	uint64_t delta = read_cntpct_el0() - start;
+	pmf_smc_lat_cpu_t *cpu = &pmf_smc_lat[plat_my_core_pos()];
+	pmf_smc_lat_entry_t *entry;
+	unsigned int bucket = 0U;
+
+	if (smc_fid == 0U) {
+		return;
+	}
+
+	entry = pmf_smc_lat_find(cpu, smc_fid, true);
+	if (entry == NULL) {
+		cpu->dropped++;
+		return;
+	}
+
+	if (delta != 0U) {
+		bucket = 63U - (unsigned int)__builtin_clzll(delta);
+		if (bucket >= PMF_SMC_LAT_BUCKETS) {
+			bucket = PMF_SMC_LAT_BUCKETS - 1U;
+		}
+	}
+
+	entry->count++;
+	entry->buckets[bucket]++;
+	if (delta < entry->min) {
+		entry->min = delta;
+	}
+	if (delta > entry->max) {
+		entry->max = delta;
+	}
+}
+
+static void pmf_smc_lat_page(const pmf_smc_lat_entry_t *entry,
+			     unsigned int page,
+			     uint64_t out[PMF_SMC_LAT_PAGE_WORDS], bool first)
+{
+	unsigned int i, b;
+
+	if (page == 0U) {
+		if (first || (entry->min < out[1])) {
+			out[1] = entry->min;
+		}
+		out[0] += entry->count;
+		out[2] = MAX(out[2], entry->max);
+		return;
+	}
+
+	for (i = 0U; i < PMF_SMC_LAT_PAGE_WORDS; i++) {
+		b = ((page - 1U) * PMF_SMC_LAT_PAGE_WORDS) + i;
+		if (b < PMF_SMC_LAT_BUCKETS) {
+			out[i] += entry->buckets[b];
+		}
+	}
+}
+
+/*
+ * Read a page of the statistics of 'smc_fid' on 'cpu', or of the list of the
+ * function IDs seen by 'cpu' if 'smc_fid' is 0. See pmf_smc_lat.h for the
+ * layout of the pages. Returns 0 on success, -EINVAL for an invalid CPU index
+ * and -ENOENT if 'smc_fid' was never called.
+ */
+int pmf_smc_lat_get(uint32_t smc_fid, unsigned int cpu, unsigned int page,
+		    uint64_t out[PMF_SMC_LAT_PAGE_WORDS])
+{
+	const pmf_smc_lat_entry_t *entry;
+	unsigned int i, first, last;
+	bool found = false;
+
+	zeromem(out, PMF_SMC_LAT_PAGE_WORDS * sizeof(uint64_t));
+
+	if (cpu == PMF_SMC_LAT_ALL_CPUS) {
+		if (smc_fid == 0U) {
+			return -EINVAL;
+		}
+		first = 0U;
+		last = PLATFORM_CORE_COUNT - 1U;
+	} else if (cpu < PLATFORM_CORE_COUNT) {
+		first = cpu;
+		last = cpu;
+	} else {
+		return -EINVAL;
+	}
+
+	if (smc_fid == 0U) {
+		for (i = 0U; i < PMF_SMC_LAT_PAGE_WORDS; i++) {
+			unsigned int idx = (page * PMF_SMC_LAT_PAGE_WORDS) + i;
+
+			if (idx < PMF_SMC_LAT_FIDS) {
+				out[i] = pmf_smc_lat[cpu].entries[idx].smc_fid;
+			}
+		}
+		return 0;
+	}
+
+	for (i = first; i <= last; i++) {
+		entry = pmf_smc_lat_find(&pmf_smc_lat[i], smc_fid, false);
+		if (entry != NULL) {
+			pmf_smc_lat_page(entry, page, out, !found);
+			found = true;
+		}
+	}
+
+	return found ? 0 : -ENOENT;
+}
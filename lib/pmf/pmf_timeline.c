@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/pmf/pmf_timeline.h>
+#include <plat/common/platform.h>
+#include <platform_def.h>
+
+#if !defined(PLAT_BOOT_TIMELINE_BASE) || !defined(PLAT_BOOT_TIMELINE_SIZE)
+#error "ENABLE_BOOT_TIMELINE requires PLAT_BOOT_TIMELINE_BASE/SIZE to be defined"
+#endif
+
+CASSERT(PLAT_BOOT_TIMELINE_SIZE >= (sizeof(pmf_tl_header_t) +
+				    sizeof(pmf_tl_entry_t)),
+	assert_pmf_tl_region_too_small);
+
+#define PMF_TL_CAPACITY		((PLAT_BOOT_TIMELINE_SIZE -		\
+				  sizeof(pmf_tl_header_t)) /		\
+				 sizeof(pmf_tl_entry_t))
+
+#ifdef IMAGE_BL2
+#define PMF_TL_IMAGE		PMF_TL_BL2
+#else
+#define PMF_TL_IMAGE		PMF_TL_BL31
+#endif
+
+/*
+ * The timeline is only recorded by the primary CPU during cold boot, so it
+ * needs no locking. Entries and header are written field by field with
+ * naturally aligned accesses, which also works with the MMU off.
+ */
+static pmf_tl_header_t *tl_hdr;
+static pmf_tl_entry_t *tl_entries;
+
+static bool pmf_tl_valid(const pmf_tl_header_t *hdr)
+{
+	return (hdr->magic == PMF_TL_MAGIC) &&
+	       (hdr->version == PMF_TL_VERSION) &&
+	       (hdr->entry_size == sizeof(pmf_tl_entry_t)) &&
+	       (hdr->capacity == PMF_TL_CAPACITY) &&
+	       (hdr->count <= hdr->capacity);
+}
+
+/*
+ * Start a new timeline in BL2, or carry on with the one BL2 handed over in
+ * later images. Must be called once the timeline region is accessible.
+ */
+void pmf_tl_init(void)
+{
+	pmf_tl_header_t *hdr = (pmf_tl_header_t *)PLAT_BOOT_TIMELINE_BASE;
+
+#ifndef IMAGE_BL2
+	/* Discard any stale line, the previous image wrote to memory */
+	inv_dcache_range(PLAT_BOOT_TIMELINE_BASE, PLAT_BOOT_TIMELINE_SIZE);
+
+	if (pmf_tl_valid(hdr)) {
+		/* Spans left open by the previous image stay flagged */
+		hdr->depth = 0U;
+		tl_hdr = hdr;
+		tl_entries = (pmf_tl_entry_t *)(hdr + 1);
+		return;
+	}
+
+	WARN("Boot timeline: no valid timeline handed over, starting anew\n");
+#endif
+
+	hdr->magic = PMF_TL_MAGIC;
+	hdr->version = PMF_TL_VERSION;
+	hdr->entry_size = sizeof(pmf_tl_entry_t);
+	hdr->count = 0U;
+	hdr->capacity = PMF_TL_CAPACITY;
+	hdr->cntfrq = plat_get_syscnt_freq2();
+	hdr->depth = 0U;
+	hdr->dropped = 0U;
+
+	tl_hdr = hdr;
+	tl_entries = (pmf_tl_entry_t *)(hdr + 1);
+}
+
+static int pmf_tl_add(const char *name, uint32_t arg, uint16_t flags)
+{
+	uint64_t now = read_cntpct_el0();
+	pmf_tl_entry_t *entry;
+	unsigned int i;
+
+	if (tl_hdr == NULL) {
+		return -1;
+	}
+
+	if (tl_hdr->count >= tl_hdr->capacity) {
+		tl_hdr->dropped++;
+		return -1;
+	}
+
+	entry = &tl_entries[tl_hdr->count];
+	entry->start = now;
+	entry->end = 0ULL;
+	entry->arg = arg;
+	entry->image = (uint8_t)PMF_TL_IMAGE;
+	entry->depth = (uint8_t)tl_hdr->depth;
+	entry->flags = flags;
+
+	for (i = 0U; (i < (PMF_TL_NAME_LEN - 1U)) && (name[i] != '\0'); i++) {
+		entry->name[i] = name[i];
+	}
+	for (; i < PMF_TL_NAME_LEN; i++) {
+		entry->name[i] = '\0';
+	}
+
+	return (int)tl_hdr->count++;
+}
+
+/*
+ * Open a span. Spans opened before the current one is closed are nested in
+ * it. Returns the handle to pass to pmf_tl_end(), or -1 if the span is not
+ * recorded.
+ */
+int pmf_tl_begin(const char *name, uint32_t arg)
+{
+	int handle = pmf_tl_add(name, arg, PMF_TL_FLAG_OPEN);
+
+	if (handle >= 0) {
+		tl_hdr->depth++;
+	}
+
+	return handle;
+}
+
+void pmf_tl_end(int handle)
+{
+	uint64_t now = read_cntpct_el0();
+	pmf_tl_entry_t *entry;
+
+	if ((tl_hdr == NULL) || (handle < 0) ||
+	    ((uint32_t)handle >= tl_hdr->count)) {
+		return;
+	}
+
+	entry = &tl_entries[handle];
+	if ((entry->flags & PMF_TL_FLAG_OPEN) == 0U) {
+		return;
+	}
+
+	entry->end = now;
+	entry->flags &= (uint16_t)~PMF_TL_FLAG_OPEN;
+	if (tl_hdr->depth > 0U) {
+		tl_hdr->depth--;
+	}
+}
+
+void pmf_tl_event(const char *name, uint32_t arg)
+{
+	(void)pmf_tl_add(name, arg, PMF_TL_FLAG_EVENT);
+}
+
+/*
+ * Write the timeline back to memory so that the next image finds it whatever
+ * its cache and MMU state.
+ */
+void pmf_tl_flush(void)
+{
+	if (tl_hdr != NULL) {
+		flush_dcache_range(PLAT_BOOT_TIMELINE_BASE,
+				   PLAT_BOOT_TIMELINE_SIZE);
+	}
+}
+
+/*
+ * Return the location of the timeline for the Normal world. Returns 0 on
+ * success, -1 if there is no timeline.
+ */
+int pmf_tl_get_region(uintptr_t *base, size_t *size)
+{
+	if (tl_hdr == NULL) {
+		return -1;
+	}
+
+	*base = PLAT_BOOT_TIMELINE_BASE;
+	*size = PLAT_BOOT_TIMELINE_SIZE;
+
+	return 0;
+}
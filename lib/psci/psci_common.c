@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -46,6 +46,11 @@ static plat_local_state_t
 
 unsigned int psci_plat_core_count;
 
+#if PSCI_OS_INIT_MODE
+/* The current suspend mode, set with PSCI_SET_SUSPEND_MODE */
+suspend_mode_t psci_suspend_mode = PLAT_COORD;
+#endif
+
 /*******************************************************************************
  * Arrays that hold the platform's power domain tree information for state
  * management of power domains.
@@ -64,6 +69,35 @@ DEFINE_PSCI_LOCK(psci_locks[PSCI_NUM_NON_CPU_PWR_DOMAINS]);
 
 cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
 
+#if PSCI_LOCK_ELISION
+/*
+ * Lock-free tracking of the CPUs that keep their parent power domains ON, used
+ * to skip the coordination and the locks of the parent power domains for
+ * CPU-only transitions.
+ *
+ * psci_cpu_running[] is set while a CPU runs and cleared once it has requested
+ * a low power state for its parent power domains. psci_pd_coord[] is set for a
+ * non-CPU power domain by the CPU that coordinates its state, holding its
+ * lock, and stays set until the power domain is back to RUN. A CPU writes its
+ * psci_cpu_running[] entry before reading psci_pd_coord[], a coordinator
+ * writes psci_pd_coord[] before reading psci_cpu_running[], with a barrier in
+ * between: at least one of them sees the write of the other.
+ *
+ * Both are accessed with the data cache disabled on the warm boot path.
+ */
+static volatile uint8_t psci_cpu_running[PLATFORM_CORE_COUNT]
+#if USE_COHERENT_MEM
+__section("tzfw_coherent_mem")
+#endif
+;
+
+static volatile uint8_t psci_pd_coord[PSCI_NUM_NON_CPU_PWR_DOMAINS]
+#if USE_COHERENT_MEM
+__section("tzfw_coherent_mem")
+#endif
+;
+#endif
+
 /*******************************************************************************
  * Pointer to functions exported by the platform to complete power mgmt. ops
  ******************************************************************************/
@@ -177,6 +211,23 @@ unsigned int psci_is_last_on_cpu(void)
 	return 1;
 }
 
+#if PSCI_OS_INIT_MODE
+/*******************************************************************************
+ * This function returns true if all the CPUs in the system are ON.
+ ******************************************************************************/
+bool psci_are_all_cpus_on(void)
+{
+	unsigned int cpu_idx;
+
+	for (cpu_idx = 0U; cpu_idx < psci_plat_core_count; cpu_idx++) {
+		if (psci_get_aff_info_state_by_idx(cpu_idx) == AFF_STATE_OFF)
+			return false;
+	}
+
+	return true;
+}
+#endif
+
 /*******************************************************************************
  * Routine to return the maximum power level to traverse to after a cpu has
  * been physically powered up. It is expected to be called immediately after
@@ -223,6 +274,9 @@ void __init psci_init_req_local_pwr_states(void)
 	/* Initialize the requested state of all non CPU power domains as OFF */
 	unsigned int pwrlvl;
 	unsigned int core;
+#if PSCI_LOCK_ELISION
+	unsigned int node;
+#endif
 
 	for (pwrlvl = 0U; pwrlvl < PLAT_MAX_PWR_LVL; pwrlvl++) {
 		for (core = 0; core < psci_plat_core_count; core++) {
@@ -230,6 +284,15 @@ void __init psci_init_req_local_pwr_states(void)
 				PLAT_MAX_OFF_STATE;
 		}
 	}
+
+#if PSCI_LOCK_ELISION
+	/*
+	 * The non CPU power domains are OFF until a CPU sets them to RUN, so
+	 * the CPUs that are turned on must coordinate them.
+	 */
+	for (node = 0U; node < PSCI_NUM_NON_CPU_PWR_DOMAINS; node++)
+		psci_pd_coord[node] = 1U;
+#endif
 }
 
 /******************************************************************************
@@ -387,9 +450,16 @@ void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
 		psci_set_req_local_pwr_state(lvl,
 					     cpu_idx,
 					     PSCI_LOCAL_STATE_RUN);
+#if PSCI_LOCK_ELISION
+		psci_pd_coord[parent_idx] = 0U;
+#endif
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 
+#if PSCI_LOCK_ELISION
+	psci_cpu_running[cpu_idx] = 1U;
+#endif
+
 	/* Set the affinity info state to ON */
 	psci_set_aff_info_state(AFF_STATE_ON);
 
@@ -397,6 +467,99 @@ void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
 	psci_flush_cpu_data(psci_svc_cpu_data);
 }
 
+#if PSCI_LOCK_ELISION
+/*
+ * Return true if a CPU other than `cpu_idx` in the power domain `parent_idx`
+ * is running.
+ */
+static bool psci_other_cpu_running(unsigned int parent_idx,
+				   unsigned int cpu_idx)
+{
+	unsigned int i, start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
+	unsigned int end_idx = start_idx + psci_non_cpu_pd_nodes[parent_idx].ncpus;
+
+	for (i = start_idx; i < end_idx; i++) {
+		if ((i != cpu_idx) && (psci_cpu_running[i] != 0U))
+			return true;
+	}
+
+	return false;
+}
+
+/*******************************************************************************
+ * This function is called by a CPU about to suspend to the states in
+ * `state_info` up to `end_pwrlvl`, without holding any lock. It publishes the
+ * states requested for the parent power domains and, if another CPU of the
+ * parent power domain at level 1 is running and no coordination of that
+ * power domain is in progress, sets the parent power domains to RUN in
+ * `state_info` and returns true. The suspend is then a CPU-only transition,
+ * that needs neither the coordination nor the locks of the parent power
+ * domains. A CPU that coordinates them later on takes the requested states of
+ * this CPU into account.
+ ******************************************************************************/
+bool psci_suspend_skip_coordination(unsigned int end_pwrlvl,
+				    psci_power_state_t *state_info)
+{
+	unsigned int lvl, cpu_idx = plat_my_core_pos();
+	unsigned int parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+	if (end_pwrlvl == PSCI_CPU_PWR_LVL)
+		return false;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++)
+		psci_set_req_local_pwr_state(lvl, cpu_idx,
+					     state_info->pwr_domain_state[lvl]);
+
+	/* Publish the requested states before the CPU stops keeping them ON */
+	dmbishst();
+	psci_cpu_running[cpu_idx] = 0U;
+	dsbish();
+
+	if ((psci_pd_coord[parent_idx] != 0U) ||
+	    !psci_other_cpu_running(parent_idx, cpu_idx))
+		return false;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++)
+		state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
+
+	psci_set_target_local_pwr_states(PSCI_CPU_PWR_LVL, state_info);
+
+	return true;
+}
+
+/*******************************************************************************
+ * This function is called by a CPU that wakes up from a suspend to
+ * `end_pwrlvl`, or abandons it, possibly with the data cache disabled. It
+ * marks the CPU as running and returns true if none of its parent power
+ * domains up to `end_pwrlvl` has been coordinated to a low power state or is
+ * being coordinated. The parent power domains are then known to be ON, and
+ * the CPU does not need to take their locks.
+ ******************************************************************************/
+bool psci_wakeup_skip_coordination(unsigned int end_pwrlvl)
+{
+	unsigned int lvl, cpu_idx = plat_my_core_pos();
+	unsigned int parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+	psci_cpu_running[cpu_idx] = 1U;
+	dsbish();
+
+	/*
+	 * In OS-initiated mode, the last CPU checks the states of the other
+	 * CPUs with the locks held, so the locks cannot be skipped.
+	 */
+	if (psci_is_os_init_mode())
+		return false;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		if (psci_pd_coord[parent_idx] != 0U)
+			return false;
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+	return true;
+}
+#endif /* PSCI_LOCK_ELISION */
+
 /******************************************************************************
  * This function is passed the local power states requested for each power
  * domain (state_info) between the current CPU domain and its ancestors until
@@ -424,10 +587,17 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	unsigned int start_idx;
 	unsigned int ncpus;
 	plat_local_state_t target_state, *req_states;
+#if PSCI_LOCK_ELISION
+	bool others_running;
+#endif
 
 	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
 	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
 
+#if PSCI_LOCK_ELISION
+	psci_cpu_running[cpu_idx] = 0U;
+#endif
+
 	/* For level 0, the requested state will be equivalent
 	   to target state */
 	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
@@ -436,6 +606,22 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 		psci_set_req_local_pwr_state(lvl, cpu_idx,
 					     state_info->pwr_domain_state[lvl]);
 
+#if PSCI_LOCK_ELISION
+		psci_pd_coord[parent_idx] = 1U;
+		dsbish();
+#endif
+
+#if PSCI_LOCK_ELISION
+		/*
+		 * Read the running CPUs before their requested states, so that
+		 * the requested states of the CPUs seen idle are up to date.
+		 * The requested states of the running CPUs may be stale, but
+		 * they keep the power domain ON anyway.
+		 */
+		others_running = psci_other_cpu_running(parent_idx, cpu_idx);
+		dmbishld();
+#endif
+
 		/* Get the requested power states for this power level */
 		start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
 		req_states = psci_get_req_local_pwr_states(lvl, start_idx);
@@ -449,6 +635,14 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 							 req_states,
 							 ncpus);
 
+#if PSCI_LOCK_ELISION
+		if (others_running)
+			target_state = PSCI_LOCAL_STATE_RUN;
+
+		if (is_local_state_run(target_state) != 0)
+			psci_pd_coord[parent_idx] = 0U;
+#endif
+
 		state_info->pwr_domain_state[lvl] = target_state;
 
 		/* Break early if the negotiated target power state is RUN */
@@ -475,6 +669,160 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	psci_set_target_local_pwr_states(end_pwrlvl, state_info);
 }
 
+#if PSCI_OS_INIT_MODE
+/******************************************************************************
+ * This function saves in 'prev' the local power states requested by the
+ * current CPU for each non CPU power level and replaces them with the ones in
+ * 'state_info'. The levels above 'end_pwrlvl' are given the state requested at
+ * 'end_pwrlvl', so that the CPU does not prevent the other CPUs from putting
+ * them in a low power state in OS-initiated mode.
+ *****************************************************************************/
+void psci_update_req_local_pwr_states(unsigned int end_pwrlvl,
+				      const psci_power_state_t *state_info,
+				      plat_local_state_t *prev)
+{
+	unsigned int lvl, cpu_idx = plat_my_core_pos();
+	plat_local_state_t req_state;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		prev[lvl - 1U] = *psci_get_req_local_pwr_states(lvl, cpu_idx);
+
+		if (lvl <= end_pwrlvl)
+			req_state = state_info->pwr_domain_state[lvl];
+		else
+			req_state = state_info->pwr_domain_state[end_pwrlvl];
+
+		psci_set_req_local_pwr_state(lvl, cpu_idx, req_state);
+	}
+}
+
+/******************************************************************************
+ * This function restores the local power states requested by the current CPU
+ * for each non CPU power level from 'prev'.
+ *****************************************************************************/
+void psci_restore_req_local_pwr_states(const plat_local_state_t *prev)
+{
+	unsigned int lvl, cpu_idx = plat_my_core_pos();
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL; lvl++)
+		psci_set_req_local_pwr_state(lvl, cpu_idx, prev[lvl - 1U]);
+}
+
+/******************************************************************************
+ * This function returns true if the CPUs other than the current one in the
+ * power domain at level 'pwrlvl' of the current CPU are all OFF or suspended.
+ *****************************************************************************/
+static bool psci_is_last_cpu_to_idle_at_pwrlvl(unsigned int pwrlvl)
+{
+	unsigned int lvl, parent_idx, cpu_start_idx, ncpus, idx;
+	unsigned int my_idx = plat_my_core_pos();
+
+	if (pwrlvl == PSCI_CPU_PWR_LVL)
+		return true;
+
+	parent_idx = psci_cpu_pd_nodes[my_idx].parent_node;
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl < pwrlvl; lvl++)
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+
+	cpu_start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
+	ncpus = psci_non_cpu_pd_nodes[parent_idx].ncpus;
+
+	for (idx = cpu_start_idx; idx < cpu_start_idx + ncpus; idx++) {
+		if (idx == my_idx)
+			continue;
+
+		if (is_local_state_run(psci_get_cpu_local_state_by_idx(idx)) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+/******************************************************************************
+ * This function is the OS-initiated mode counterpart of
+ * psci_do_state_coordination(). The OS has already chosen the local power
+ * state of each power domain between the current CPU and its ancestor at
+ * 'end_pwrlvl', so instead of coordinating them, it checks that:
+ *  - the state requested at each power level is the one the requests of all
+ *    the CPUs of the power domain coordinate to.
+ *  - the current CPU is the last running CPU at the power level specified by
+ *    the OS, and this level is not lower than 'end_pwrlvl'.
+ * On success, the target power states of the power domains are updated. On
+ * failure, the requested power states of the CPU are left unchanged and the
+ * PSCI error code is returned.
+ *
+ * This function is called with the locks of the power domains up to
+ * 'end_pwrlvl' held.
+ *****************************************************************************/
+int psci_validate_state_coordination(unsigned int end_pwrlvl,
+				     psci_power_state_t *state_info)
+{
+	unsigned int lvl, parent_idx, cpu_idx = plat_my_core_pos();
+	unsigned int start_idx, ncpus;
+	plat_local_state_t target_state, *req_states;
+	plat_local_state_t prev[PLAT_MAX_PWR_LVL];
+	int rc = PSCI_E_SUCCESS;
+
+	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+
+	if (state_info->last_at_pwrlvl < end_pwrlvl)
+		return PSCI_E_INVALID_PARAMS;
+
+	psci_update_req_local_pwr_states(end_pwrlvl, state_info, prev);
+
+	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		/* Get the requested power states for this power level */
+		start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
+		req_states = psci_get_req_local_pwr_states(lvl, start_idx);
+
+		/*
+		 * Let the platform coordinate amongst the requested states at
+		 * this power level and check the result against the state
+		 * requested by the OS.
+		 */
+		ncpus = psci_non_cpu_pd_nodes[parent_idx].ncpus;
+		target_state = plat_get_target_pwr_state(lvl, req_states,
+							 ncpus);
+
+		if (state_info->pwr_domain_state[lvl] != target_state) {
+			if (is_local_state_run(target_state) != 0)
+				rc = PSCI_E_DENIED;
+			else
+				rc = PSCI_E_INVALID_PARAMS;
+			break;
+		}
+
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+	if ((rc == PSCI_E_SUCCESS) &&
+	    !psci_is_last_cpu_to_idle_at_pwrlvl(state_info->last_at_pwrlvl))
+		rc = PSCI_E_DENIED;
+
+	if (rc != PSCI_E_SUCCESS) {
+		psci_restore_req_local_pwr_states(prev);
+		return rc;
+	}
+
+#if PSCI_LOCK_ELISION
+	/* The CPUs waking up from now on must coordinate these power domains */
+	psci_cpu_running[cpu_idx] = 0U;
+	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		psci_pd_coord[parent_idx] = 1U;
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+#endif
+
+	/* Update the target state in the power domain nodes */
+	psci_set_target_local_pwr_states(end_pwrlvl, state_info);
+
+	return PSCI_E_SUCCESS;
+}
+#endif /* PSCI_OS_INIT_MODE */
+
 /******************************************************************************
  * This function validates a suspend request by making sure that if a standby
  * state is requested then no power level is turned off and the highest power
@@ -773,6 +1121,10 @@ void psci_warmboot_entrypoint(void)
 	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
 	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
 
+#if ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_wakeup();
+#endif
+
 	/*
 	 * Verify that we have been explicitly turned ON or resumed from
 	 * suspend.
@@ -788,6 +1140,15 @@ void psci_warmboot_entrypoint(void)
 	 */
 	end_pwrlvl = get_power_on_target_pwrlvl();
 
+#if PSCI_LOCK_ELISION
+	/*
+	 * If the parent power domains have stayed ON, only the CPU power
+	 * domain needs to be restored.
+	 */
+	if (psci_wakeup_skip_coordination(end_pwrlvl))
+		end_pwrlvl = PSCI_CPU_PWR_LVL;
+#endif
+
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(cpu_idx, end_pwrlvl, parent_nodes);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -51,6 +51,70 @@ unsigned int psci_version(void)
 	return PSCI_MAJOR_VER | PSCI_MINOR_VER;
 }
 
+#if PSCI_STANDBY_FAST_PATH
+/*
+ * Enter one of the CPU retention states listed in PLAT_PSCI_FAST_STANDBY_IDS.
+ * The parent power domains stay running, so neither the validation of the
+ * request by the platform nor the coordination with the other CPUs is needed.
+ */
+static int psci_cpu_fast_standby(void)
+{
+#if PSCI_STANDBY_FAST_PATH_STAT && ENABLE_PSCI_STAT
+	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
+
+	state_info.pwr_domain_state[PSCI_CPU_PWR_LVL] = PLAT_MAX_RET_STATE;
+#endif
+
+	if (psci_plat_pm_ops->cpu_standby == NULL)
+		return PSCI_E_INVALID_PARAMS;
+
+#if PSCI_STANDBY_FAST_PATH_STAT && ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_suspend_begin();
+#endif
+
+	psci_set_cpu_local_state(PLAT_MAX_RET_STATE);
+
+#if PSCI_STANDBY_FAST_PATH_STAT
+#if ENABLE_PSCI_STAT
+	plat_psci_stat_accounting_start(&state_info);
+#endif
+
+#if ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_wfi(&state_info);
+#endif
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_HW_LOW_PWR,
+	    PMF_NO_CACHE_MAINT);
+#endif
+#endif /* PSCI_STANDBY_FAST_PATH_STAT */
+
+	psci_plat_pm_ops->cpu_standby(PLAT_MAX_RET_STATE);
+
+#if PSCI_STANDBY_FAST_PATH_STAT && ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_wakeup();
+#endif
+
+	psci_set_cpu_local_state(PSCI_LOCAL_STATE_RUN);
+
+#if PSCI_STANDBY_FAST_PATH_STAT
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_HW_LOW_PWR,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+#if ENABLE_PSCI_STAT
+	plat_psci_stat_accounting_stop(&state_info);
+	psci_stats_update_pwr_up(PSCI_CPU_PWR_LVL, &state_info);
+#endif
+#endif /* PSCI_STANDBY_FAST_PATH_STAT */
+
+	return PSCI_E_SUCCESS;
+}
+#endif /* PSCI_STANDBY_FAST_PATH */
+
 int psci_cpu_suspend(unsigned int power_state,
 		     uintptr_t entrypoint,
 		     u_register_t context_id)
@@ -60,6 +124,14 @@ int psci_cpu_suspend(unsigned int power_state,
 	entry_point_info_t ep;
 	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
 	plat_local_state_t cpu_pd_state;
+#if PSCI_OS_INIT_MODE
+	plat_local_state_t prev[PLAT_MAX_PWR_LVL];
+#endif
+
+#if PSCI_STANDBY_FAST_PATH
+	if (is_cpu_fast_standby_req(power_state))
+		return psci_cpu_fast_standby();
+#endif
 
 	/* Validate the power_state parameter */
 	rc = psci_validate_power_state(power_state, &state_info);
@@ -88,6 +160,10 @@ int psci_cpu_suspend(unsigned int power_state,
 		if  (psci_plat_pm_ops->cpu_standby == NULL)
 			return PSCI_E_INVALID_PARAMS;
 
+#if ENABLE_PSCI_STAT_EXT
+		psci_stats_ext_suspend_begin();
+#endif
+
 		/*
 		 * Set the state of the CPU power domain to the platform
 		 * specific retention state and enter the standby state.
@@ -95,10 +171,25 @@ int psci_cpu_suspend(unsigned int power_state,
 		cpu_pd_state = state_info.pwr_domain_state[PSCI_CPU_PWR_LVL];
 		psci_set_cpu_local_state(cpu_pd_state);
 
+#if PSCI_OS_INIT_MODE
+		/*
+		 * In OS-initiated mode, let the other CPUs put the parent
+		 * power domains in a low power state while this CPU is in
+		 * standby.
+		 */
+		if (psci_suspend_mode == OS_INIT)
+			psci_update_req_local_pwr_states(target_pwrlvl,
+							 &state_info, prev);
+#endif
+
 #if ENABLE_PSCI_STAT
 		plat_psci_stat_accounting_start(&state_info);
 #endif
 
+#if ENABLE_PSCI_STAT_EXT
+		psci_stats_ext_wfi(&state_info);
+#endif
+
 #if ENABLE_RUNTIME_INSTRUMENTATION
 		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
 		    RT_INSTR_ENTER_HW_LOW_PWR,
@@ -107,9 +198,18 @@ int psci_cpu_suspend(unsigned int power_state,
 
 		psci_plat_pm_ops->cpu_standby(cpu_pd_state);
 
+#if ENABLE_PSCI_STAT_EXT
+		psci_stats_ext_wakeup();
+#endif
+
 		/* Upon exit from standby, set the state back to RUN. */
 		psci_set_cpu_local_state(PSCI_LOCAL_STATE_RUN);
 
+#if PSCI_OS_INIT_MODE
+		if (psci_suspend_mode == OS_INIT)
+			psci_restore_req_local_pwr_states(prev);
+#endif
+
 #if ENABLE_RUNTIME_INSTRUMENTATION
 		PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
 		    RT_INSTR_EXIT_HW_LOW_PWR,
@@ -142,12 +242,10 @@ int psci_cpu_suspend(unsigned int power_state,
 	 * might return if the power down was abandoned for any reason, e.g.
 	 * arrival of an interrupt
 	 */
-	psci_cpu_suspend_start(&ep,
-			    target_pwrlvl,
-			    &state_info,
-			    is_power_down_state);
-
-	return PSCI_E_SUCCESS;
+	return psci_cpu_suspend_start(&ep,
+				      target_pwrlvl,
+				      &state_info,
+				      is_power_down_state);
 }
 
 
@@ -169,6 +267,11 @@ int psci_system_suspend(uintptr_t entrypoint, u_register_t context_id)
 	/* Query the psci_power_state for system suspend */
 	psci_query_sys_suspend_pwrstate(&state_info);
 
+#if PSCI_OS_INIT_MODE
+	/* This CPU is the last one running in the system */
+	state_info.last_at_pwrlvl = PLAT_MAX_PWR_LVL;
+#endif
+
 	/*
 	 * Check if platform allows suspend to Highest power level
 	 * (System level)
@@ -187,12 +290,10 @@ int psci_system_suspend(uintptr_t entrypoint, u_register_t context_id)
 	 * might return if the power down was abandoned for any reason, e.g.
 	 * arrival of an interrupt
 	 */
-	psci_cpu_suspend_start(&ep,
-			    PLAT_MAX_PWR_LVL,
-			    &state_info,
-			    PSTATE_TYPE_POWERDOWN);
-
-	return PSCI_E_SUCCESS;
+	return psci_cpu_suspend_start(&ep,
+				      PLAT_MAX_PWR_LVL,
+				      &state_info,
+				      PSTATE_TYPE_POWERDOWN);
 }
 
 int psci_cpu_off(void)
@@ -333,6 +434,40 @@ int psci_node_hw_state(u_register_t target_cpu,
 	return rc;
 }
 
+#if PSCI_OS_INIT_MODE
+int psci_set_suspend_mode(unsigned int mode)
+{
+	if (psci_suspend_mode == mode)
+		return PSCI_E_SUCCESS;
+
+	if (mode == PLAT_COORD) {
+		/* Check if the current CPU is the last ON CPU in the system */
+		if (psci_is_last_on_cpu() == 0U)
+			return PSCI_E_DENIED;
+	} else if (mode == OS_INIT) {
+		/*
+		 * Check if all the CPUs in the system are ON or if the current
+		 * CPU is the last ON CPU in the system.
+		 */
+		if (!psci_are_all_cpus_on() && (psci_is_last_on_cpu() == 0U))
+			return PSCI_E_DENIED;
+	} else {
+		return PSCI_E_INVALID_PARAMS;
+	}
+
+	psci_suspend_mode = (suspend_mode_t)mode;
+	psci_flush_dcache_range((uintptr_t)&psci_suspend_mode,
+				sizeof(psci_suspend_mode));
+
+	return PSCI_E_SUCCESS;
+}
+
+suspend_mode_t psci_get_suspend_mode(void)
+{
+	return psci_suspend_mode;
+}
+#endif
+
 int psci_features(unsigned int psci_fid)
 {
 	unsigned int local_caps = psci_caps;
@@ -357,12 +492,8 @@ int psci_features(unsigned int psci_fid)
 	/* Format the feature flags */
 	if ((psci_fid == PSCI_CPU_SUSPEND_AARCH32) ||
 	    (psci_fid == PSCI_CPU_SUSPEND_AARCH64)) {
-		/*
-		 * The trusted firmware does not support OS Initiated Mode.
-		 */
 		unsigned int ret = ((FF_PSTATE << FF_PSTATE_SHIFT) |
-			(((FF_SUPPORTS_OS_INIT_MODE == 1U) ? 0U : 1U)
-				<< FF_MODE_SUPPORT_SHIFT));
+			(FF_SUPPORTS_OS_INIT_MODE << FF_MODE_SUPPORT_SHIFT));
 		return (int) ret;
 	}
 
@@ -453,6 +584,12 @@ u_register_t psci_smc_handler(uint32_t smc_fid,
 			ret = (u_register_t)psci_features(r1);
 			break;
 
+#if PSCI_OS_INIT_MODE
+		case PSCI_SET_SUSPEND_MODE:
+			ret = (u_register_t)psci_set_suspend_mode(r1);
+			break;
+#endif
+
 #if ENABLE_PSCI_STAT
 		case PSCI_STAT_RESIDENCY_AARCH32:
 			ret = psci_stat_residency(r1, r2);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -257,6 +257,42 @@ extern non_cpu_pd_node_t psci_non_cpu_pd_nodes[PSCI_NUM_NON_CPU_PWR_DOMAINS];
 extern cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
 extern unsigned int psci_caps;
 extern unsigned int psci_plat_core_count;
+#if PSCI_OS_INIT_MODE
+extern suspend_mode_t psci_suspend_mode;
+#endif
+
+/* Helper function to check whether the OS-initiated suspend mode is in use */
+static inline bool psci_is_os_init_mode(void)
+{
+#if PSCI_OS_INIT_MODE
+	return psci_suspend_mode == OS_INIT;
+#else
+	return false;
+#endif
+}
+
+#if PSCI_STANDBY_FAST_PATH
+#ifndef PLAT_PSCI_FAST_STANDBY_IDS
+#error "PSCI_STANDBY_FAST_PATH requires PLAT_PSCI_FAST_STANDBY_IDS"
+#endif
+
+/*
+ * Helper function to check whether a CPU_SUSPEND request is for one of the
+ * CPU retention states the platform lists as not needing any coordination.
+ */
+static inline bool is_cpu_fast_standby_req(unsigned int power_state)
+{
+	unsigned int state_id = psci_get_pstate_id(power_state);
+
+	/* Standby at power level 0, with no reserved bit set */
+	if ((power_state & ~(PSTATE_ID_MASK << PSTATE_ID_SHIFT)) != 0U)
+		return false;
+
+	return (state_id < 32U) &&
+	       ((PLAT_PSCI_FAST_STANDBY_IDS & BIT_32(state_id)) != 0U) &&
+	       !psci_is_os_init_mode();
+}
+#endif
 
 /*******************************************************************************
  * SPD's power management hooks registered with PSCI
@@ -281,6 +317,19 @@ void psci_get_parent_pwr_domain_nodes(unsigned int cpu_idx,
 				      unsigned int *node_index);
 void psci_do_state_coordination(unsigned int end_pwrlvl,
 				psci_power_state_t *state_info);
+#if PSCI_LOCK_ELISION
+bool psci_suspend_skip_coordination(unsigned int end_pwrlvl,
+				    psci_power_state_t *state_info);
+bool psci_wakeup_skip_coordination(unsigned int end_pwrlvl);
+#endif
+#if PSCI_OS_INIT_MODE
+int psci_validate_state_coordination(unsigned int end_pwrlvl,
+				     psci_power_state_t *state_info);
+void psci_update_req_local_pwr_states(unsigned int end_pwrlvl,
+				      const psci_power_state_t *state_info,
+				      plat_local_state_t *prev);
+void psci_restore_req_local_pwr_states(const plat_local_state_t *prev);
+#endif
 void psci_acquire_pwr_domain_locks(unsigned int end_pwrlvl,
 				   const unsigned int *parent_nodes);
 void psci_release_pwr_domain_locks(unsigned int end_pwrlvl,
@@ -292,6 +341,9 @@ unsigned int psci_find_target_suspend_lvl(const psci_power_state_t *state_info);
 void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl);
 void psci_print_power_domain_map(void);
 unsigned int psci_is_last_on_cpu(void);
+#if PSCI_OS_INIT_MODE
+bool psci_are_all_cpus_on(void);
+#endif
 int psci_spd_migrate_info(u_register_t *mpidr);
 void psci_do_pwrdown_sequence(unsigned int power_level);
 
@@ -312,10 +364,10 @@ void psci_cpu_on_finish(unsigned int cpu_idx, const psci_power_state_t *state_in
 int psci_do_cpu_off(unsigned int end_pwrlvl);
 
 /* Private exported functions from psci_suspend.c */
-void psci_cpu_suspend_start(const entry_point_info_t *ep,
-			unsigned int end_pwrlvl,
-			psci_power_state_t *state_info,
-			unsigned int is_power_down_state);
+int psci_cpu_suspend_start(const entry_point_info_t *ep,
+			   unsigned int end_pwrlvl,
+			   psci_power_state_t *state_info,
+			   unsigned int is_power_down_state);
 
 void psci_cpu_suspend_finish(unsigned int cpu_idx, const psci_power_state_t *state_info);
 
@@ -337,6 +389,12 @@ u_register_t psci_stat_residency(u_register_t target_cpu,
 			unsigned int power_state);
 u_register_t psci_stat_count(u_register_t target_cpu,
 			unsigned int power_state);
+#if ENABLE_PSCI_STAT_EXT
+void psci_stats_ext_suspend_begin(void);
+void psci_stats_ext_wfi(const psci_power_state_t *state_info);
+void psci_stats_ext_wakeup(void);
+void psci_stats_ext_abort(const psci_power_state_t *state_info);
+#endif
 
 /* Private exported functions from psci_mem_protect.c */
 u_register_t psci_mem_protect(unsigned int enable);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -269,6 +269,11 @@ int __init psci_setup(const psci_lib_args_t *lib_args)
 	if (psci_plat_pm_ops->system_reset2 != NULL)
 		psci_caps |= define_psci_cap(PSCI_SYSTEM_RESET2_AARCH64);
 
+#if PSCI_OS_INIT_MODE
+	if ((psci_caps & define_psci_cap(PSCI_CPU_SUSPEND_AARCH64)) != 0U)
+		psci_caps |= define_psci_cap(PSCI_SET_SUSPEND_MODE);
+#endif
+
 #if ENABLE_PSCI_STAT
 	psci_caps |=  define_psci_cap(PSCI_STAT_RESIDENCY_AARCH64);
 	psci_caps |=  define_psci_cap(PSCI_STAT_COUNT_AARCH64);
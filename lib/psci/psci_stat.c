@@ -1,14 +1,18 @@
 /*
- * Copyright (c) 2016-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include <platform_def.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/psci/psci_stat_ext.h>
+#include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
 #include "psci_private.h"
@@ -39,6 +43,36 @@ static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
+#if ENABLE_PSCI_STAT_EXT
+/*
+ * Time-stamps of the suspend in progress on a CPU. They are also written with
+ * the data cache disabled, on the power down and warm boot paths, so each CPU
+ * has a cache line of its own that is cleaned and invalidated after every
+ * write and invalidated before being read, the same way as PMF time-stamps.
+ */
+typedef struct psci_stat_ext_ts {
+	/* Start of the suspend request, 0 if no suspend is in progress */
+	uint64_t begin;
+	uint64_t wfi;
+	uint64_t wake;
+	unsigned int lvl;
+	int idx;
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_stat_ext_ts_t;
+
+/*
+ * The records of a CPU are only updated by that CPU, with the data cache
+ * enabled. The sequence count is odd while an update is in progress, so that
+ * readers retry instead of taking a lock.
+ */
+typedef struct psci_stat_ext_cpu {
+	volatile unsigned int seq;
+	psci_stat_ext_rec_t rec[PLAT_MAX_PWR_LVL + 1U][PLAT_MAX_PWR_LVL_STATES];
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_stat_ext_cpu_t;
+
+static psci_stat_ext_ts_t psci_stat_ext_ts[PLATFORM_CORE_COUNT];
+static psci_stat_ext_cpu_t psci_stat_ext_cpu[PLATFORM_CORE_COUNT];
+#endif
+
 /*
  * This functions returns the index into the `psci_stat_t` array given the
  * local power state and power domain level. If the platform implements the
@@ -62,6 +96,189 @@ static int get_stat_idx(plat_local_state_t local_state, unsigned int pwr_lvl)
 	return idx;
 }
 
+#if ENABLE_PSCI_STAT_EXT
+static void psci_stat_ext_ts_flush(const psci_stat_ext_ts_t *ts)
+{
+	flush_dcache_range((uintptr_t)ts, sizeof(*ts));
+}
+
+static unsigned int psci_stat_ext_bucket(uint64_t ticks)
+{
+	unsigned int bucket = 0U;
+
+	if (ticks != 0U) {
+		bucket = 63U - (unsigned int)__builtin_clzll(ticks);
+		if (bucket >= PSCI_STAT_EXT_BUCKETS)
+			bucket = PSCI_STAT_EXT_BUCKETS - 1U;
+	}
+
+	return bucket;
+}
+
+/* Get the record of a CPU for the state `idx` of power level `lvl` */
+static psci_stat_ext_rec_t *psci_stat_ext_rec(unsigned int cpu_idx,
+					      unsigned int lvl, int idx)
+{
+	assert(lvl <= PLAT_MAX_PWR_LVL);
+	assert((idx >= 0) && (idx < (int) PLAT_MAX_PWR_LVL_STATES));
+
+	return &psci_stat_ext_cpu[cpu_idx].rec[lvl][idx];
+}
+
+static void psci_stat_ext_key(const psci_power_state_t *state_info,
+			      unsigned int *lvl, int *idx)
+{
+	*lvl = psci_find_target_suspend_lvl(state_info);
+	assert(*lvl != PSCI_INVALID_PWR_LVL);
+	*idx = get_stat_idx(state_info->pwr_domain_state[*lvl], *lvl);
+}
+
+static void psci_stat_ext_write_begin(psci_stat_ext_cpu_t *cpu)
+{
+	cpu->seq++;
+	dmbst();
+}
+
+static void psci_stat_ext_write_end(psci_stat_ext_cpu_t *cpu)
+{
+	dmbst();
+	cpu->seq++;
+}
+
+/*******************************************************************************
+ * The following functions record the time-stamps of a suspend on the calling
+ * CPU: at the start of the request, just before the WFI and at the first
+ * opportunity after the wake-up. The last two may run with the data cache
+ * disabled.
+ ******************************************************************************/
+void psci_stats_ext_suspend_begin(void)
+{
+	psci_stat_ext_ts_t *ts = &psci_stat_ext_ts[plat_my_core_pos()];
+
+	ts->begin = read_cntpct_el0();
+	psci_stat_ext_ts_flush(ts);
+}
+
+void psci_stats_ext_wfi(const psci_power_state_t *state_info)
+{
+	psci_stat_ext_ts_t *ts = &psci_stat_ext_ts[plat_my_core_pos()];
+
+	psci_stat_ext_key(state_info, &ts->lvl, &ts->idx);
+	ts->wfi = read_cntpct_el0();
+	psci_stat_ext_ts_flush(ts);
+}
+
+void psci_stats_ext_wakeup(void)
+{
+	psci_stat_ext_ts_t *ts = &psci_stat_ext_ts[plat_my_core_pos()];
+
+	ts->wake = read_cntpct_el0();
+	psci_stat_ext_ts_flush(ts);
+}
+
+/*******************************************************************************
+ * This function accounts a suspend request abandoned because a wake-up
+ * interrupt was pending, against the requested state in `state_info`. It is
+ * called with the data cache enabled.
+ ******************************************************************************/
+void psci_stats_ext_abort(const psci_power_state_t *state_info)
+{
+	unsigned int cpu_idx = plat_my_core_pos();
+	psci_stat_ext_cpu_t *cpu = &psci_stat_ext_cpu[cpu_idx];
+	psci_stat_ext_ts_t *ts = &psci_stat_ext_ts[cpu_idx];
+	unsigned int lvl;
+	int idx;
+
+	psci_stat_ext_key(state_info, &lvl, &idx);
+
+	psci_stat_ext_write_begin(cpu);
+	psci_stat_ext_rec(cpu_idx, lvl, idx)->aborts++;
+	psci_stat_ext_write_end(cpu);
+
+	ts->begin = 0U;
+	psci_stat_ext_ts_flush(ts);
+}
+
+/*******************************************************************************
+ * This function accounts the suspend that the calling CPU has just woken up
+ * from, if any. It is called with the data cache enabled, as the last step of
+ * the wake-up.
+ ******************************************************************************/
+static void psci_stats_ext_update(unsigned int cpu_idx)
+{
+	psci_stat_ext_cpu_t *cpu = &psci_stat_ext_cpu[cpu_idx];
+	psci_stat_ext_ts_t *ts = &psci_stat_ext_ts[cpu_idx];
+	psci_stat_ext_rec_t *rec;
+	uint64_t entry_lat, exit_lat;
+
+	inv_dcache_range((uintptr_t)ts, sizeof(*ts));
+
+	/* Not waking up from a suspend, e.g. first power up after CPU_ON */
+	if (ts->begin == 0U)
+		return;
+
+	entry_lat = ts->wfi - ts->begin;
+	exit_lat = read_cntpct_el0() - ts->wake;
+	rec = psci_stat_ext_rec(cpu_idx, ts->lvl, ts->idx);
+
+	psci_stat_ext_write_begin(cpu);
+	rec->wakeups++;
+	rec->sleep_time += ts->wake - ts->wfi;
+	rec->entry_lat[psci_stat_ext_bucket(entry_lat)]++;
+	rec->exit_lat[psci_stat_ext_bucket(exit_lat)]++;
+	rec->entry_lat_max = MAX(rec->entry_lat_max, entry_lat);
+	rec->exit_lat_max = MAX(rec->exit_lat_max, exit_lat);
+	psci_stat_ext_write_end(cpu);
+
+	ts->begin = 0U;
+	psci_stat_ext_ts_flush(ts);
+}
+
+/*
+ * Copy the statistics of all the CPUs to `buf`, see psci_stat_ext.h. The
+ * records of each CPU are copied again if that CPU updated them meanwhile.
+ */
+size_t psci_stat_ext_snapshot(void *buf, size_t size)
+{
+	psci_stat_ext_hdr_t *hdr = buf;
+	uint8_t *out = (uint8_t *)(hdr + 1);
+	size_t len = sizeof(*hdr) +
+		     (PLATFORM_CORE_COUNT * sizeof(psci_stat_ext_cpu[0].rec));
+	unsigned int i, seq;
+
+	assert(((uintptr_t)buf & (sizeof(uint64_t) - 1U)) == 0U);
+
+	if (size < len)
+		return 0U;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		const psci_stat_ext_cpu_t *cpu = &psci_stat_ext_cpu[i];
+
+		do {
+			seq = cpu->seq;
+			dmbld();
+			(void)memcpy(out, cpu->rec, sizeof(cpu->rec));
+			dmbld();
+		} while (((seq & 1U) != 0U) || (seq != cpu->seq));
+
+		out += sizeof(cpu->rec);
+	}
+
+	hdr->magic = PSCI_STAT_EXT_MAGIC;
+	hdr->version = PSCI_STAT_EXT_VERSION;
+	hdr->size = (uint32_t)len;
+	hdr->cpu_count = PLATFORM_CORE_COUNT;
+	hdr->lvl_count = PLAT_MAX_PWR_LVL + 1U;
+	hdr->state_count = PLAT_MAX_PWR_LVL_STATES;
+	hdr->bucket_count = PSCI_STAT_EXT_BUCKETS;
+	hdr->rec_size = sizeof(psci_stat_ext_rec_t);
+	hdr->cntfrq = read_cntfrq_el0();
+	hdr->timestamp = read_cntpct_el0();
+
+	return len;
+}
+#endif /* ENABLE_PSCI_STAT_EXT */
+
 /*******************************************************************************
  * This function is passed the target local power states for each power
  * domain (state_info) between the current CPU domain and its ancestors until
@@ -118,6 +335,10 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
 	assert(state_info != NULL);
 
+#if ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_update(cpu_idx);
+#endif
+
 	/* Get the index into the stats array */
 	local_state = state_info->pwr_domain_state[PSCI_CPU_PWR_LVL];
 	stat_idx = get_stat_idx(local_state, PSCI_CPU_PWR_LVL);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -31,6 +31,15 @@ static void psci_suspend_to_standby_finisher(unsigned int cpu_idx,
 	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
 	psci_power_state_t state_info;
 
+#if PSCI_LOCK_ELISION
+	/*
+	 * If the parent power domains have stayed ON, only the CPU power
+	 * domain needs to be restored.
+	 */
+	if (psci_wakeup_skip_coordination(end_pwrlvl))
+		end_pwrlvl = PSCI_CPU_PWR_LVL;
+#endif
+
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(cpu_idx, end_pwrlvl, parent_nodes);
 
@@ -63,6 +72,34 @@ static void psci_suspend_to_standby_finisher(unsigned int cpu_idx,
 	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
 }
 
+/*******************************************************************************
+ * This function is called with the locks of the parent power domains up to
+ * `end_pwrlvl` held, before the coordination or the validation of their
+ * states. It returns true
+ * if a wake-up interrupt is pending and the suspend request can be abandoned.
+ ******************************************************************************/
+static bool psci_suspend_abandon(unsigned int end_pwrlvl)
+{
+	if (read_isr_el1() == 0U)
+		return false;
+
+	/* Nothing has been requested yet in OS-initiated mode */
+	if (psci_is_os_init_mode())
+		return true;
+
+#if PSCI_LOCK_ELISION
+	/*
+	 * The requested states of this CPU have been published already. If a
+	 * parent power domain has been coordinated to a low power state with
+	 * them in the meantime, carry on with the suspend: the pending
+	 * interrupt will wake up the CPU straight away.
+	 */
+	return psci_wakeup_skip_coordination(end_pwrlvl);
+#else
+	return true;
+#endif
+}
+
 /*******************************************************************************
  * This function does generic and platform specific suspend to power down
  * operations.
@@ -151,14 +188,17 @@ static void psci_suspend_to_pwrdown_start(unsigned int end_pwrlvl,
  * the state transition has been done, no further error is expected and it is
  * not possible to undo any of the actions taken beyond that point.
  ******************************************************************************/
-void psci_cpu_suspend_start(const entry_point_info_t *ep,
-			    unsigned int end_pwrlvl,
-			    psci_power_state_t *state_info,
-			    unsigned int is_power_down_state)
+int psci_cpu_suspend_start(const entry_point_info_t *ep,
+			   unsigned int end_pwrlvl,
+			   psci_power_state_t *state_info,
+			   unsigned int is_power_down_state)
 {
+	int rc = PSCI_E_SUCCESS;
 	int skip_wfi = 0;
 	unsigned int idx = plat_my_core_pos();
 	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
+	unsigned int lock_lvl = end_pwrlvl;
+	bool coordinate = true;
 
 	/*
 	 * This function must only be called on platforms where the
@@ -167,33 +207,73 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	assert((psci_plat_pm_ops->pwr_domain_suspend != NULL) &&
 	       (psci_plat_pm_ops->pwr_domain_suspend_finish != NULL));
 
+#if ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_suspend_begin();
+#endif
+
+#if PSCI_LOCK_ELISION
+	/*
+	 * If another CPU keeps the parent power domains ON, this is a CPU-only
+	 * transition that needs neither their coordination nor their locks.
+	 * In OS-initiated mode, the OS has chosen the states of the parent
+	 * power domains, which must be validated.
+	 */
+	if (!psci_is_os_init_mode() && (read_isr_el1() == 0U) &&
+	    psci_suspend_skip_coordination(end_pwrlvl, state_info)) {
+		coordinate = false;
+		lock_lvl = PSCI_CPU_PWR_LVL;
+	}
+#endif
+
 	/* Get the parent nodes */
-	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
+	psci_get_parent_pwr_domain_nodes(idx, lock_lvl, parent_nodes);
 
 	/*
 	 * This function acquires the lock corresponding to each power
 	 * level so that by the time all locks are taken, the system topology
 	 * is snapshot and state management can be done safely.
 	 */
-	psci_acquire_pwr_domain_locks(end_pwrlvl, parent_nodes);
+	psci_acquire_pwr_domain_locks(lock_lvl, parent_nodes);
 
-	/*
-	 * We check if there are any pending interrupts after the delay
-	 * introduced by lock contention to increase the chances of early
-	 * detection that a wake-up interrupt has fired.
-	 */
-	if (read_isr_el1() != 0U) {
-		skip_wfi = 1;
-		goto exit;
+	if (coordinate) {
+		/*
+		 * We check if there are any pending interrupts after the delay
+		 * introduced by lock contention to increase the chances of
+		 * early detection that a wake-up interrupt has fired.
+		 */
+		if (psci_suspend_abandon(end_pwrlvl)) {
+			skip_wfi = 1;
+#if ENABLE_PSCI_STAT_EXT
+			psci_stats_ext_abort(state_info);
+#endif
+			goto exit;
+		}
+
+#if PSCI_OS_INIT_MODE
+		if (psci_suspend_mode == OS_INIT) {
+			/*
+			 * This function validates the state info requested by
+			 * the OS for each power level upto the end level
+			 * specified.
+			 */
+			rc = psci_validate_state_coordination(end_pwrlvl,
+							      state_info);
+			if (rc != PSCI_E_SUCCESS) {
+				skip_wfi = 1;
+				goto exit;
+			}
+		} else
+#endif
+		{
+			/*
+			 * This function is passed the requested state info and
+			 * it returns the negotiated state info for each power
+			 * level upto the end level specified.
+			 */
+			psci_do_state_coordination(end_pwrlvl, state_info);
+		}
 	}
 
-	/*
-	 * This function is passed the requested state info and
-	 * it returns the negotiated state info for each power level upto
-	 * the end level specified.
-	 */
-	psci_do_state_coordination(end_pwrlvl, state_info);
-
 #if ENABLE_PSCI_STAT
 	/* Update the last cpu for each level till end_pwrlvl */
 	psci_stats_update_pwr_down(end_pwrlvl, state_info);
@@ -219,10 +299,10 @@ exit:
 	 * Release the locks corresponding to each power level in the
 	 * reverse order to which they were acquired.
 	 */
-	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+	psci_release_pwr_domain_locks(lock_lvl, parent_nodes);
 
 	if (skip_wfi == 1)
-		return;
+		return rc;
 
 	if (is_power_down_state != 0U) {
 #if ENABLE_RUNTIME_INSTRUMENTATION
@@ -238,6 +318,10 @@ exit:
 		    PMF_NO_CACHE_MAINT);
 #endif
 
+#if ENABLE_PSCI_STAT_EXT
+		psci_stats_ext_wfi(state_info);
+#endif
+
 		/* The function calls below must not return */
 		if (psci_plat_pm_ops->pwr_domain_pwr_down_wfi != NULL)
 			psci_plat_pm_ops->pwr_domain_pwr_down_wfi(state_info);
@@ -256,8 +340,16 @@ exit:
 	 * requested at multiple power levels. This means that the cpu
 	 * context will be preserved.
 	 */
+#if ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_wfi(state_info);
+#endif
+
 	wfi();
 
+#if ENABLE_PSCI_STAT_EXT
+	psci_stats_ext_wakeup();
+#endif
+
 #if ENABLE_RUNTIME_INSTRUMENTATION
 	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
 	    RT_INSTR_EXIT_HW_LOW_PWR,
@@ -269,6 +361,8 @@ exit:
 	 * context retaining suspend finisher.
 	 */
 	psci_suspend_to_standby_finisher(idx, end_pwrlvl);
+
+	return rc;
 }
 
 /*******************************************************************************
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -119,6 +119,41 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	size_t pages = size >> PAGE_SIZE_SHIFT;
+
+	assert(IS_PAGE_ALIGNED(va) && IS_PAGE_ALIGNED(size));
+	assert((xlat_regime == EL1_EL0_REGIME) ||
+	       (xlat_regime == EL2_REGIME));
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	/*
+	 * There are no TLBI range operations in AArch32, so the pages are
+	 * invalidated one by one, or all the entries of the regime at once.
+	 */
+	if (pages > XLAT_TLBI_VA_MAX_PAGES) {
+		if (xlat_regime == EL1_EL0_REGIME)
+			tlbiallis();
+		else
+			tlbiallhis();
+		return;
+	}
+
+	for (; pages != 0U; pages--) {
+		if (xlat_regime == EL1_EL0_REGIME)
+			tlbimvaais(TLBI_ADDR(va));
+		else
+			tlbimvahis(TLBI_ADDR(va));
+		va += PAGE_SIZE;
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/* Invalidate all entries from branch predictors. */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -184,6 +184,40 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
 	}
 }
 
+/*
+ * Invalidate the TLB entries of the given translation regime that match the
+ * TLBI operand 'addr': a VA or, if 'range' is true, a range of VAs.
+ *
+ * This function only supports invalidation of TLB entries for the EL3, EL2 and
+ * EL1&0 translation regimes.
+ *
+ * Also, it is architecturally UNDEFINED to invalidate TLBs of a higher
+ * exception level (see section D4.9.2 of the ARM ARM rev B.a).
+ */
+static void xlat_arch_tlbi_op(uint64_t addr, bool range, int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+		if (range)
+			tlbirvaae1is(addr);
+		else
+			tlbivaae1is(addr);
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+		if (range)
+			tlbirvae2is(addr);
+		else
+			tlbivae2is(addr);
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+		if (range)
+			tlbirvae3is(addr);
+		else
+			tlbivae3is(addr);
+	}
+}
+
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 {
 	/*
@@ -192,23 +226,65 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	 */
 	dsbishst();
 
+	xlat_arch_tlbi_op(TLBI_ADDR(va), false, xlat_regime);
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	unsigned long long pages = (unsigned long long)size >> PAGE_SIZE_SHIFT;
+	unsigned long long num;
+	unsigned int scale;
+
+	assert(IS_PAGE_ALIGNED(va) && IS_PAGE_ALIGNED(size));
+
 	/*
-	 * This function only supports invalidation of TLB entries for the EL3
-	 * and EL1&0 translation regimes.
-	 *
-	 * Also, it is architecturally UNDEFINED to invalidate TLBs of a higher
-	 * exception level (see section D4.9.2 of the ARM ARM rev B.a).
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
 	 */
-	if (xlat_regime == EL1_EL0_REGIME) {
+	dsbishst();
+
+	if (is_armv8_4_tlbi_range_present() &&
+	    (pages < TLBI_RANGE_PAGES(TLBI_RANGE_SCALE_MAX,
+				      TLBI_RANGE_NUM_MAX))) {
+		/*
+		 * Each range covers an even number of pages, so invalidate an
+		 * odd one first. Then, for each scale, one range invalidates
+		 * the pages given by the bits of 'pages' at this scale.
+		 */
+		if ((pages & 1ULL) != 0ULL) {
+			xlat_arch_tlbi_op(TLBI_ADDR(va), false, xlat_regime);
+			va += PAGE_SIZE;
+			pages--;
+		}
+
+		for (scale = 0U; pages != 0ULL; scale++) {
+			assert(scale <= TLBI_RANGE_SCALE_MAX);
+
+			num = (pages >> ((5U * scale) + 1U)) &
+			      TLBI_RANGE_NUM_MAX;
+			if (num == 0ULL)
+				continue;
+
+			xlat_arch_tlbi_op(TLBI_RANGE(va, scale, num - 1ULL),
+					  true, xlat_regime);
+			va += TLBI_RANGE_PAGES(scale, num - 1ULL) * PAGE_SIZE;
+			pages -= TLBI_RANGE_PAGES(scale, num - 1ULL);
+		}
+	} else if (pages <= XLAT_TLBI_VA_MAX_PAGES) {
+		for (; pages != 0ULL; pages--) {
+			xlat_arch_tlbi_op(TLBI_ADDR(va), false, xlat_regime);
+			va += PAGE_SIZE;
+		}
+	} else if (xlat_regime == EL1_EL0_REGIME) {
 		assert(xlat_arch_current_el() >= 1U);
-		tlbivaae1is(TLBI_ADDR(va));
+		tlbivmalle1is();
 	} else if (xlat_regime == EL2_REGIME) {
 		assert(xlat_arch_current_el() >= 2U);
-		tlbivae2is(TLBI_ADDR(va));
+		tlbialle2is();
 	} else {
 		assert(xlat_regime == EL3_REGIME);
 		assert(xlat_arch_current_el() >= 3U);
-		tlbivae3is(TLBI_ADDR(va));
+		tlbialle3is();
 	}
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -352,7 +352,8 @@ static action_t xlat_tables_unmap_region_action(const mmap_region_t *mm,
 }
 /*
  * Recursive function that writes to the translation tables and unmaps the
- * specified region.
+ * specified region. The TLB entries of the region have to be invalidated by
+ * the caller afterwards, all at once.
  */
 static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				     const uintptr_t table_base_va,
@@ -389,7 +390,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
 			table_base[table_idx] = INVALID_DESC;
-			xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
 
 		} else if (action == ACTION_RECURSE_INTO_TABLE) {
 
@@ -406,11 +406,8 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			/*
 			 * If the subtable is now empty, remove its reference.
 			 */
-			if (xlat_table_is_empty(ctx, subtable)) {
+			if (xlat_table_is_empty(ctx, subtable))
 				table_base[table_idx] = INVALID_DESC;
-				xlat_arch_tlbi_va(table_idx_va,
-						  ctx->xlat_regime);
-			}
 
 		} else {
 			assert(action == ACTION_NONE);
@@ -949,6 +946,67 @@ void mmap_add_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 
 #if PLAT_XLAT_TABLES_DYNAMIC
 
+/*
+ * Add the pages of [va, va + size) to the VA range whose TLB entries have to be
+ * invalidated by xlat_tables_sync().
+ */
+static void xlat_tables_tlbi_defer(xlat_ctx_t *ctx, uintptr_t va, size_t size)
+{
+	uintptr_t end_va = round_up(va + size, PAGE_SIZE) - 1U;
+
+	va = round_down(va, PAGE_SIZE);
+
+	if (ctx->tlbi_size != 0U) {
+		end_va = MAX(end_va, ctx->tlbi_va + ctx->tlbi_size - 1U);
+		va = MIN(va, ctx->tlbi_va);
+	}
+
+	ctx->tlbi_va = va;
+	ctx->tlbi_size = end_va - va + 1U;
+}
+
+/*
+ * Make the changes done to the translation tables visible to the system: clean
+ * the base table from the data cache and invalidate the deferred TLB entries.
+ */
+static void xlat_tables_sync(xlat_ctx_t *ctx)
+{
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)ctx->base_table,
+			   ctx->base_table_entries * sizeof(uint64_t));
+#endif
+	if (ctx->tlbi_size == 0U) {
+		/* Make sure that all entries are written to the memory. */
+		dsbishst();
+		return;
+	}
+
+	xlat_arch_tlbi_va_range(ctx->tlbi_va, ctx->tlbi_size,
+				ctx->xlat_regime);
+	xlat_arch_tlbi_va_sync();
+
+	ctx->tlbi_size = 0U;
+}
+
+void xlat_batch_begin_ctx(xlat_ctx_t *ctx)
+{
+	assert(ctx != NULL);
+	assert(!ctx->batch);
+
+	ctx->batch = true;
+}
+
+void xlat_batch_end_ctx(xlat_ctx_t *ctx)
+{
+	assert(ctx != NULL);
+	assert(ctx->batch);
+
+	ctx->batch = false;
+
+	if (ctx->initialized)
+		xlat_tables_sync(ctx);
+}
+
 int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 {
 	mmap_region_t *mm_cursor = ctx->mmap;
@@ -1001,13 +1059,18 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 	 * not, this region will be mapped when they are initialized.
 	 */
 	if (ctx->initialized) {
+		/*
+		 * The translation tables freed by the regions removed earlier
+		 * in the batch can only be reused once their TLB entries are
+		 * invalidated.
+		 */
+		if (ctx->tlbi_size != 0U)
+			xlat_tables_sync(ctx);
+
 		end_va = xlat_tables_map_region(ctx, mm_cursor,
 				0U, ctx->base_table, ctx->base_table_entries,
 				ctx->base_level);
-#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-				   ctx->base_table_entries * sizeof(uint64_t));
-#endif
+
 		/* Failed to map, remove mmap entry, unmap and return error. */
 		if (end_va != (mm_cursor->base_va + mm_cursor->size - 1U)) {
 			(void)memmove(mm_cursor, mm_cursor + 1U,
@@ -1015,38 +1078,38 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 
 			/*
 			 * Check if the mapping function actually managed to map
-			 * anything. If not, just return now.
+			 * anything. If so, something went wrong after mapping
+			 * some table entries, undo every change done up to this
+			 * point.
 			 */
-			if (mm->base_va >= end_va)
-				return -ENOMEM;
+			if (mm->base_va < end_va) {
+				mmap_region_t unmap_mm = {
+						.base_pa = 0U,
+						.base_va = mm->base_va,
+						.size = end_va - mm->base_va,
+						.attr = 0U
+				};
+				xlat_tables_unmap_region(ctx, &unmap_mm, 0U,
+					ctx->base_table,
+					ctx->base_table_entries,
+					ctx->base_level);
+				xlat_tables_tlbi_defer(ctx, unmap_mm.base_va,
+						       unmap_mm.size);
+			}
 
-			/*
-			 * Something went wrong after mapping some table
-			 * entries, undo every change done up to this point.
-			 */
-			mmap_region_t unmap_mm = {
-					.base_pa = 0U,
-					.base_va = mm->base_va,
-					.size = end_va - mm->base_va,
-					.attr = 0U
-			};
-			xlat_tables_unmap_region(ctx, &unmap_mm, 0U,
-				ctx->base_table, ctx->base_table_entries,
-				ctx->base_level);
-#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-			xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-				ctx->base_table_entries * sizeof(uint64_t));
-#endif
+			xlat_tables_sync(ctx);
 			return -ENOMEM;
 		}
 
 		/*
-		 * Make sure that all entries are written to the memory. There
-		 * is no need to invalidate entries when mapping dynamic regions
-		 * because new table/block/page descriptors only replace old
-		 * invalid descriptors, that aren't TLB cached.
+		 * Make sure that all entries are written to the memory, unless
+		 * this is deferred to the end of the batch. There is no need to
+		 * invalidate entries when mapping dynamic regions because new
+		 * table/block/page descriptors only replace old invalid
+		 * descriptors, that aren't TLB cached.
 		 */
-		dsbishst();
+		if (!ctx->batch)
+			xlat_tables_sync(ctx);
 	}
 
 	if (end_pa > ctx->max_pa)
@@ -1119,11 +1182,10 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 		xlat_tables_unmap_region(ctx, mm, 0U, ctx->base_table,
 					 ctx->base_table_entries,
 					 ctx->base_level);
-#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-			ctx->base_table_entries * sizeof(uint64_t));
-#endif
-		xlat_arch_tlbi_va_sync();
+		xlat_tables_tlbi_defer(ctx, mm->base_va, mm->size);
+
+		if (!ctx->batch)
+			xlat_tables_sync(ctx);
 	}
 
 	/* Remove this region by moving the rest down by one place. */
@@ -1177,6 +1239,8 @@ void xlat_setup_dynamic_ctx(xlat_ctx_t *ctx, unsigned long long pa_max,
 	ctx->base_table_entries = GET_NUM_BASE_LEVEL_ENTRIES(va_space_size);
 
 	ctx->tables_mapped_regions = mapped_regions;
+	ctx->batch = false;
+	ctx->tlbi_size = 0U;
 
 	ctx->max_pa = 0;
 	ctx->max_va = 0;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,6 +8,7 @@
 #define XLAT_TABLES_PRIVATE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include <platform_def.h>
 
@@ -62,9 +63,28 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime);
  */
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
 
+/*
+ * Maximum number of pages invalidated one by one by xlat_arch_tlbi_va_range()
+ * when the TLBI range instructions can't be used. Larger ranges are handled by
+ * invalidating all the TLB entries of the translation regime.
+ */
+#ifndef XLAT_TLBI_VA_MAX_PAGES
+#define XLAT_TLBI_VA_MAX_PAGES	U(64)
+#endif
+
+/*
+ * Invalidate all TLB entries that match a virtual address in the page aligned
+ * range [va, va + size) in the same way as xlat_arch_tlbi_va(). It only has to
+ * be called once after modifying all the translation table entries of the
+ * range, and uses the TLBI range instructions (FEAT_TLBIRANGE) if available,
+ * per-page invalidations or an invalidation of the whole translation regime,
+ * depending on the size of the range.
+ */
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime);
+
 /*
  * This function has to be called at the end of any code that uses the function
- * xlat_arch_tlbi_va().
+ * xlat_arch_tlbi_va() or xlat_arch_tlbi_va_range().
  */
 void xlat_arch_tlbi_va_sync(void);
 
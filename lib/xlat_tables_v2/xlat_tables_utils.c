@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -536,6 +536,11 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	/* Restore original value. */
 	base_va = base_va_original;
 
+	/*
+	 * Each page gets its own break-before-make sequence, so that only one
+	 * page at a time is unmapped. The pages changed may be used by this
+	 * code, e.g. its stack or the translation tables themselves.
+	 */
 	for (unsigned int i = 0U; i < pages_count; ++i) {
 
 		uint32_t old_attr = 0U, new_attr;
@@ -8,9 +8,11 @@
 #include <errno.h>
 #include <string.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <common/tf_crc32.h>
 #include <lib/utils.h>
+#include <lib/utils_def.h>
 #include <tf_gunzip.h>
 
 #include "zutil.h"
@@ -20,6 +22,14 @@
  */
 #define ZALLOC_ALIGNMENT	sizeof(void *)
 
+/*
+ * The output is inflated and cleaned to the PoC in chunks of this size, so
+ * that the cache maintenance hits lines that are still in the cache.  Each
+ * inflate() call ends by copying up to 32KB into the sliding window, so the
+ * chunks should not be much smaller than this.
+ */
+#define GUNZIP_CHUNK_SIZE	U(0x40000)
+
 static uintptr_t zalloc_start;
 static uintptr_t zalloc_end;
 static uintptr_t zalloc_current;
@@ -37,7 +47,10 @@ static void * ZLIB_INTERNAL zcalloc(void *opaque, unsigned int items,
 	if (p_end > zalloc_end)
 		return NULL;
 
-	memset((void *)p, 0, size);
+	/*
+	 * zlib initializes everything it allocates before use (its own
+	 * zcalloc() is a plain malloc()), so there is no need to clear it.
+	 */
 
 	zalloc_current = p_end;
 
@@ -48,6 +61,22 @@ static void ZLIB_INTERNAL zfree(void *opaque, void *ptr)
 {
 }
 
+/*
+ * Room left for output at @out.  When decompressing in place, the output must
+ * not run into the input which has not been consumed yet.
+ */
+static size_t gunzip_out_space(const z_stream *stream, uintptr_t out_end)
+{
+	uintptr_t out = (uintptr_t)stream->next_out;
+	uintptr_t in = (uintptr_t)stream->next_in;
+	uintptr_t in_end = in + stream->avail_in;
+
+	if ((in < out_end) && (in_end > out))
+		out_end = (in > out) ? in : out;
+
+	return MIN(out_end - out, (uintptr_t)GUNZIP_CHUNK_SIZE);
+}
+
 /*
  * gunzip - decompress gzip data
  * @in_buf: source of compressed input. Upon exit, the end of input.
@@ -61,6 +90,7 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	   size_t out_len, uintptr_t work_buf, size_t work_len)
 {
 	z_stream stream;
+	uintptr_t out, out_end;
 	int zret, ret;
 
 	zalloc_start = work_buf;
@@ -70,7 +100,7 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	stream.next_in = (typeof(stream.next_in))*in_buf;
 	stream.avail_in = in_len;
 	stream.next_out = (typeof(stream.next_out))*out_buf;
-	stream.avail_out = out_len;
+	stream.avail_out = 0;
 	stream.zalloc = zcalloc;
 	stream.zfree = zfree;
 	stream.opaque = (voidpf)0;
@@ -81,9 +111,20 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
 	}
 
-	zret = inflate(&stream, Z_NO_FLUSH);
+	out_end = *out_buf + out_len;
+
+	do {
+		out = (uintptr_t)stream.next_out;
+		stream.avail_out = gunzip_out_space(&stream, out_end);
+		zret = inflate(&stream, Z_NO_FLUSH);
+		flush_dcache_range(out, (uintptr_t)stream.next_out - out);
+	} while (zret == Z_OK);
+
 	if (zret == Z_STREAM_END) {
 		ret = 0;
+	} else if ((zret == Z_BUF_ERROR) && (stream.avail_out == 0U)) {
+		ERROR("zlib: no room for output\n");
+		ret = -ENOSPC;
 	} else {
 		if (stream.msg)
 			ERROR("%s\n", stream.msg);
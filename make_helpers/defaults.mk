@@ -26,6 +26,12 @@ ARM_ARCH_FEATURE		:= none
 ARM_ARCH_MAJOR			:= 8
 ARM_ARCH_MINOR			:= 0
 
+# Remember successful signature checks across boots (needs TRUSTED_BOARD_BOOT)
+AUTH_SIG_CACHE			:= 0
+
+# Keep per-lock acquire, contention and hold time statistics of bakery locks
+BAKERY_LOCK_STATS		:= 0
+
 # Base commit to perform code check on
 BASE_COMMIT			:= origin/master
 
@@ -42,6 +48,12 @@ BL2_IN_XIP_MEM			:= 0
 # Do dcache invalidate upon BL2 entry at EL3
 BL2_INV_DCACHE			:= 1
 
+# Let secondary CPUs check image hashes in parallel while BL2 loads images
+BL2_PARALLEL_AUTH		:= 0
+
+# Read the next image ahead from storage while BL2 authenticates the current one
+BL2_READ_AHEAD			:= 0
+
 # Select the branch protection features to use.
 BRANCH_PROTECTION		:= 0
 
@@ -56,6 +68,10 @@ COREBOOT			:= 0
 # For Chain of Trust
 CREATE_KEYS			:= 1
 
+# Switch only the EL1 system registers used by the secure payload on OP-TEE and
+# Trusty world switches, leaving the others with their non-secure values
+CTX_EL1_LAZY_SWITCH		:= 0
+
 # Build flag to include AArch32 registers in cpu context save and restore during
 # world switch. This flag must be set to 0 for AArch64-only platforms.
 CTX_INCLUDE_AARCH32_REGS	:= 1
@@ -93,6 +109,9 @@ DISABLE_MTPMU			:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Record a timeline of the boot in BL2 and BL31 for the Normal world
+ENABLE_BOOT_TIMELINE		:= 0
+
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
@@ -111,12 +130,18 @@ ENABLE_PMF			:= 0
 # Flag to enable PSCI STATs functionality
 ENABLE_PSCI_STAT		:= 0
 
+# Flag to enable the per-CPU PSCI transition statistics (latency histograms)
+ENABLE_PSCI_STAT_EXT		:= 0
+
 # Flag to enable Realm Management Extension (FEAT_RME)
 ENABLE_RME			:= 0
 
 # Flag to enable runtime instrumentation using PMF
 ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 
+# Keep per-CPU latency histograms of the SMCs handled by BL31, exported by PMF
+ENABLE_SMC_LATENCY_STATS	:= 0
+
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
@@ -212,6 +237,19 @@ PROGRAMMABLE_RESET_ADDRESS	:= 0
 # Flag used to choose the power state format: Extended State-ID or Original
 PSCI_EXTENDED_STATE_ID		:= 0
 
+# Skip the locks of the parent power domains for CPU-only suspend transitions
+PSCI_LOCK_ELISION		:= 0
+
+# Enable PSCI OS-initiated mode support
+PSCI_OS_INIT_MODE		:= 0
+
+# Enter the core retention states listed by the platform without going through
+# the generic CPU_SUSPEND handling
+PSCI_STANDBY_FAST_PATH		:= 0
+
+# Update the PSCI statistics for the standby states entered by the fast path
+PSCI_STANDBY_FAST_PATH_STAT	:= 1
+
 # Enable RAS support
 RAS_EXTENSION			:= 0
 
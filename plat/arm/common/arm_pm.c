@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -56,6 +56,10 @@ int arm_validate_power_state(unsigned int power_state,
 	if (psci_get_pstate_id(power_state) != 0U)
 		return PSCI_E_INVALID_PARAMS;
 
+#if PSCI_OS_INIT_MODE
+	req_state->last_at_pwrlvl = pwr_lvl;
+#endif
+
 	return PSCI_E_SUCCESS;
 }
 
@@ -97,6 +101,11 @@ int arm_validate_power_state(unsigned int power_state,
 		state_id >>= ARM_LOCAL_PSTATE_WIDTH;
 	}
 
+#if PSCI_OS_INIT_MODE
+	/* The composite state only gives states for the levels affected */
+	req_state->last_at_pwrlvl = (i > 0) ? (unsigned int)(i - 1) : 0U;
+#endif
+
 	return PSCI_E_SUCCESS;
 }
 #endif /* __ARM_RECOM_STATE_ID_ENC__ */
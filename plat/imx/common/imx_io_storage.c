@@ -1,18 +1,21 @@
 /*
- * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2021-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <errno.h>
 
 #include <common/debug.h>
 #include <drivers/io/io_block.h>
 #include <drivers/io/io_driver.h>
+#include <drivers/io/io_encrypted.h>
 #include <drivers/io/io_fip.h>
 #include <drivers/io/io_memmap.h>
 #include <drivers/mmc.h>
 #include <lib/utils_def.h>
+#include <plat/common/platform.h>
 #include <tbbr_img_def.h>
 #include <tools_share/firmware_image_package.h>
 
@@ -20,6 +23,10 @@
 
 static const io_dev_connector_t *fip_dev_con;
 static uintptr_t fip_dev_handle;
+#ifndef DECRYPTION_SUPPORT_none
+static const io_dev_connector_t *enc_dev_con;
+static uintptr_t enc_dev_handle;
+#endif
 
 #ifndef IMX_FIP_MMAP
 static const io_dev_connector_t *mmc_dev_con;
@@ -40,12 +47,26 @@ static const io_block_dev_spec_t mmc_dev_spec = {
 	.ops		= {
 		.read	= mmc_read_blocks,
 		.write	= mmc_write_blocks,
+#if BL2_READ_AHEAD
+		.read_async	= mmc_read_blocks_async,
+		.read_poll	= mmc_read_blocks_poll,
+#endif
 	},
 	.block_size	= MMC_BLOCK_SIZE,
 };
 
 static int open_mmc(const uintptr_t spec);
 
+#if AUTH_SIG_CACHE
+/* Room reserved on the eMMC for the signature verification cache */
+#define IMX_SIG_CACHE_MMC_SIZE	U(0x1000)
+
+static const io_block_spec_t mmc_sig_cache_spec = {
+	.offset = IMX_SIG_CACHE_MMC_BASE,
+	.length = IMX_SIG_CACHE_MMC_SIZE
+};
+#endif
+
 #else
 static const io_dev_connector_t *memmap_dev_con;
 static uintptr_t memmap_dev_handle;
@@ -58,6 +79,9 @@ static int open_memmap(const uintptr_t spec);
 #endif
 
 static int open_fip(const uintptr_t spec);
+#ifndef DECRYPTION_SUPPORT_none
+static int open_enc_fip(const uintptr_t spec);
+#endif
 
 static const io_uuid_spec_t bl31_uuid_spec = {
 	.uuid = UUID_EL3_RUNTIME_FIRMWARE_BL31,
@@ -134,11 +158,43 @@ static const struct plat_io_policy policies[] = {
 		open_memmap
 	},
 #endif
+#ifndef DECRYPTION_SUPPORT_none
+	[ENC_IMAGE_ID] = {
+		&fip_dev_handle,
+		(uintptr_t)NULL,
+		open_fip
+	},
+#endif
+#if ENCRYPT_BL31 && !defined(DECRYPTION_SUPPORT_none)
+	[BL31_IMAGE_ID] = {
+		&enc_dev_handle,
+		(uintptr_t)&bl31_uuid_spec,
+		open_enc_fip
+	},
+#else
 	[BL31_IMAGE_ID] = {
 		&fip_dev_handle,
 		(uintptr_t)&bl31_uuid_spec,
 		open_fip
 	},
+#endif
+#if ENCRYPT_BL32 && !defined(DECRYPTION_SUPPORT_none)
+	[BL32_IMAGE_ID] = {
+		&enc_dev_handle,
+		(uintptr_t)&bl32_uuid_spec,
+		open_enc_fip
+	},
+	[BL32_EXTRA1_IMAGE_ID] = {
+		&enc_dev_handle,
+		(uintptr_t)&bl32_extra1_uuid_spec,
+		open_enc_fip
+	},
+	[BL32_EXTRA2_IMAGE_ID] = {
+		&enc_dev_handle,
+		(uintptr_t)&bl32_extra2_uuid_spec,
+		open_enc_fip
+	},
+#else
 	[BL32_IMAGE_ID] = {
 		&fip_dev_handle,
 		(uintptr_t)&bl32_uuid_spec,
@@ -154,6 +210,7 @@ static const struct plat_io_policy policies[] = {
 		(uintptr_t)&bl32_extra2_uuid_spec,
 		open_fip
 	},
+#endif
 	[BL33_IMAGE_ID] = {
 		&fip_dev_handle,
 		(uintptr_t)&bl33_uuid_spec,
@@ -220,6 +277,25 @@ static int open_fip(const uintptr_t spec)
 	return result;
 }
 
+#ifndef DECRYPTION_SUPPORT_none
+static int open_enc_fip(const uintptr_t spec)
+{
+	int result;
+	uintptr_t local_image_handle;
+
+	/* See if an encrypted FIP is available */
+	result = io_dev_init(enc_dev_handle, (uintptr_t)ENC_IMAGE_ID);
+	if (result == 0) {
+		result = io_open(enc_dev_handle, spec, &local_image_handle);
+		if (result == 0) {
+			VERBOSE("Using encrypted FIP\n");
+			io_close(local_image_handle);
+		}
+	}
+	return result;
+}
+#endif
+
 #ifndef IMX_FIP_MMAP
 static int open_mmc(const uintptr_t spec)
 {
@@ -298,4 +374,83 @@ void plat_imx_io_setup(void)
 	result = io_dev_open(fip_dev_con, (uintptr_t)NULL,
 			     &fip_dev_handle);
 	assert(result == 0);
+
+#ifndef DECRYPTION_SUPPORT_none
+	result = register_io_dev_enc(&enc_dev_con);
+	assert(result == 0);
+
+	result = io_dev_open(enc_dev_con, (uintptr_t)NULL,
+			     &enc_dev_handle);
+	assert(result == 0);
+#endif
+}
+
+#if AUTH_SIG_CACHE
+/*
+ * The signature cache is kept in raw blocks of the boot eMMC. It is only
+ * accessed with the FIP closed, before and after the images are loaded.
+ */
+#ifndef IMX_FIP_MMAP
+static int imx_sig_cache_open(size_t len, uintptr_t *handle)
+{
+	if (len > IMX_SIG_CACHE_MMC_SIZE) {
+		return -ENOMEM;
+	}
+
+	return io_open(mmc_dev_handle, (uintptr_t)&mmc_sig_cache_spec, handle);
+}
+
+int plat_sig_cache_read(void *buf, size_t len)
+{
+	uintptr_t handle;
+	size_t bytes = 0U;
+	int result;
+
+	result = imx_sig_cache_open(len, &handle);
+	if (result != 0) {
+		return result;
+	}
+
+	result = io_read(handle, (uintptr_t)buf, len, &bytes);
+	io_close(handle);
+
+	if ((result == 0) && (bytes != len)) {
+		result = -EIO;
+	}
+
+	return result;
+}
+
+int plat_sig_cache_write(const void *buf, size_t len)
+{
+	uintptr_t handle;
+	size_t bytes = 0U;
+	int result;
+
+	result = imx_sig_cache_open(len, &handle);
+	if (result != 0) {
+		return result;
+	}
+
+	result = io_write(handle, (const uintptr_t)buf, len, &bytes);
+	io_close(handle);
+
+	if ((result == 0) && (bytes != len)) {
+		result = -EIO;
+	}
+
+	return result;
+}
+#else
+/* A memory mapped FIP offers no storage the cache can be written back to */
+int plat_sig_cache_read(void *buf, size_t len)
+{
+	return -ENODEV;
+}
+
+int plat_sig_cache_write(const void *buf, size_t len)
+{
+	return -ENODEV;
 }
+#endif /* IMX_FIP_MMAP */
+#endif /* AUTH_SIG_CACHE */
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <drivers/console.h>
+#include <drivers/ring_console.h>
+
+#include <imx_log_ring.h>
+
+void imx_log_ring_setup(console_t *boot_console)
+{
+	/* Runtime logs go to the log ring, the UART only prints them on a crash */
+	if (boot_console != NULL) {
+		console_set_scope(boot_console,
+				  CONSOLE_FLAG_BOOT | CONSOLE_FLAG_CRASH);
+	}
+	(void)console_ring_register();
+}
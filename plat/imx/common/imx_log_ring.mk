@@ -0,0 +1,15 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+# Keep the runtime logs in per-CPU rings, read with the IMX_SIP_LOG_RING SiP
+# call and only printed on the UART on a crash.
+IMX_LOG_RING		?=	0
+$(eval $(call assert_boolean,IMX_LOG_RING))
+ifeq (${IMX_LOG_RING},1)
+BL31_SOURCES		+=	drivers/console/ring_console.c			\
+				plat/imx/common/imx_log_ring.c
+$(eval $(call add_define,IMX_LOG_RING))
+endif
@@ -0,0 +1,11 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+# The boot timeline and the SMC latency statistics are read through the PMF
+# SiP calls of imx_sip_svc.c, which are handled by pmf_smc_handler().
+ifneq ($(filter 1,${ENABLE_BOOT_TIMELINE} ${ENABLE_SMC_LATENCY_STATS}),)
+BL31_SOURCES		+=	lib/pmf/pmf_smc.c
+endif
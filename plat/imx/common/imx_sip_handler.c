@@ -1,5 +1,5 @@
 /*
- * Copyright 2019 NXP
+ * Copyright 2019-2022 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -18,7 +18,7 @@
 #include <lib/mmio.h>
 #include <sci/sci.h>
 
-#if defined(PLAT_imx8qm) || defined(PLAT_imx8qx) || defined(PLAT_imx8dx) || defined(PLAT_imx8dxl)
+#if IMX_SOC_IMX8Q
 
 #ifdef PLAT_imx8qm
 const static int ap_cluster_index[PLATFORM_CLUSTER_COUNT] = {
@@ -205,7 +205,7 @@ int imx_get_cpu_rev(uint32_t *cpu_id, uint32_t *cpu_rev)
 
 	return 0;
 }
-#endif /* defined(PLAT_imx8qm) || defined(PLAT_imx8qx) || defined(PLAT_imx8dx) || defined(PLAT_imx8qm) || defined(PLAT_imx8dxl) */
+#endif /* IMX_SOC_IMX8Q */
 
 static uint64_t imx_get_commit_hash(u_register_t x2,
 		    u_register_t x3,
@@ -1,19 +1,252 @@
 /*
- * Copyright (c) 2015-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdint.h>
+#include <platform_def.h>
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <drivers/ring_console.h>
 #include <lib/pmf/pmf.h>
+#include <lib/psci/psci_stat_ext.h>
 #include <tools_share/uuid.h>
 #include <imx_sip_svc.h>
 #include <drivers/scmi-msg.h>
 
+#if IMX_SIP_HAS_GPC_PM_DOMAIN
+#include <gpc.h>
+#endif
+
+#define IMX_SIP_ARGS	uint32_t smc_fid, u_register_t x1, u_register_t x2, \
+			u_register_t x3, u_register_t x4, void *cookie,	     \
+			void *handle, u_register_t flags
+
+/*
+ * Handlers of the i.MX SiP function IDs, registered with DECLARE_RT_SVC_FID()
+ * so that imx_sip_handler() finds them through the dense function ID index
+ * of the runtime service framework instead of a switch.
+ */
+static uintptr_t imx_sip_aarch32(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_kernel_entry_handler(smc_fid, x1, x2, x3, x4));
+}
+DECLARE_RT_SVC_FID(imx_aarch32, IMX_SIP_AARCH32, RT_SVC_FID_ANY_SUB,
+		   imx_sip_aarch32);
+
+static uintptr_t imx_sip_buildinfo(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_buildinfo_handler(smc_fid, x1, x2, x3, x4));
+}
+DECLARE_RT_SVC_FID(imx_buildinfo, IMX_SIP_BUILDINFO, RT_SVC_FID_ANY_SUB,
+		   imx_sip_buildinfo);
+
+static uintptr_t imx_sip_call_count(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, rt_svc_fid_call_count((uint32_t)x1, (uint32_t)x2));
+}
+DECLARE_RT_SVC_FID(imx_call_count, IMX_SIP_CALL_COUNT, RT_SVC_FID_ANY_SUB,
+		   imx_sip_call_count);
+
+#if ENABLE_BOOT_TIMELINE
+DECLARE_RT_SVC_FID(imx_timeline_32, PMF_SMC_GET_TIMELINE_32,
+		   RT_SVC_FID_ANY_SUB, pmf_smc_handler);
+DECLARE_RT_SVC_FID(imx_timeline_64, PMF_SMC_GET_TIMELINE_64,
+		   RT_SVC_FID_ANY_SUB, pmf_smc_handler);
+#endif
+
+#if ENABLE_SMC_LATENCY_STATS
+DECLARE_RT_SVC_FID(imx_smc_lat_32, PMF_SMC_GET_SMC_LAT_32,
+		   RT_SVC_FID_ANY_SUB, pmf_smc_handler);
+DECLARE_RT_SVC_FID(imx_smc_lat_64, PMF_SMC_GET_SMC_LAT_64,
+		   RT_SVC_FID_ANY_SUB, pmf_smc_handler);
+#endif
+
+#if ENABLE_PSCI_STAT_EXT && defined(PLAT_PSCI_STAT_SHM_BASE)
+/*
+ * Snapshot the PSCI statistics of all the CPUs to the shared memory of the
+ * platform, returning its address and the size of the snapshot.
+ */
+static uintptr_t imx_sip_psci_stat(IMX_SIP_ARGS)
+{
+	size_t len;
+
+	len = psci_stat_ext_snapshot((void *)PLAT_PSCI_STAT_SHM_BASE,
+				     PLAT_PSCI_STAT_SHM_SIZE);
+	if (len == 0U) {
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	flush_dcache_range(PLAT_PSCI_STAT_SHM_BASE, len);
+	SMC_RET3(handle, SMC_OK, PLAT_PSCI_STAT_SHM_BASE, len);
+}
+DECLARE_RT_SVC_FID(imx_psci_stat, IMX_SIP_PSCI_STAT, RT_SVC_FID_ANY_SUB,
+		   imx_sip_psci_stat);
+#endif
+
+#if defined(IMX_IDLE_PREDICT)
+static uintptr_t imx_sip_idle_predict(IMX_SIP_ARGS)
+{
+	return imx_idle_predict_handler(smc_fid, handle, x1);
+}
+DECLARE_RT_SVC_FID(imx_idle_predict, IMX_SIP_IDLE_PREDICT, RT_SVC_FID_ANY_SUB,
+		   imx_sip_idle_predict);
+#endif
+
+#if defined(IMX_LOG_RING)
+/*
+ * Access to the runtime log rings: GET_INFO returns the number of rings and
+ * their size, READ returns in x2-x7 up to 48 characters of the ring of CPU x2
+ * from the stream position x3, with their number in x0 and the next position
+ * in x1, and DRAIN writes out the rings to the UART.
+ */
+static uintptr_t imx_sip_log_ring(IMX_SIP_ARGS)
+{
+	uint64_t data[6] = { 0U };
+	uint64_t pos = x3;
+	size_t len;
+
+	switch (x1) {
+	case IMX_SIP_LOG_RING_GET_INFO:
+		SMC_RET3(handle, SMC_OK, PLATFORM_CORE_COUNT,
+			 CONSOLE_RING_SIZE);
+	case IMX_SIP_LOG_RING_READ:
+		if (x2 >= PLATFORM_CORE_COUNT) {
+			SMC_RET1(handle, SMC_UNK);
+		}
+
+		len = console_ring_read((unsigned int)x2, &pos, (char *)data,
+					sizeof(data));
+		SMC_RET8(handle, len, pos, data[0], data[1], data[2], data[3],
+			 data[4], data[5]);
+	case IMX_SIP_LOG_RING_DRAIN:
+		console_ring_drain();
+		SMC_RET1(handle, SMC_OK);
+	default:
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
+DECLARE_RT_SVC_FID(imx_log_ring, IMX_SIP_LOG_RING, RT_SVC_FID_ANY_SUB,
+		   imx_sip_log_ring);
+#endif
+
+#if IMX_SIP_HAS_DDR_DVFS
+static uintptr_t imx_sip_ddr_dvfs(IMX_SIP_ARGS)
+{
+	return dram_dvfs_handler(smc_fid, handle, x1, x2, x3);
+}
+DECLARE_RT_SVC_FID(imx_ddr_dvfs, IMX_SIP_DDR_DVFS, RT_SVC_FID_ANY_SUB,
+		   imx_sip_ddr_dvfs);
+#endif
+
+#if IMX_SIP_HAS_SRC
+static uintptr_t imx_sip_src(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_src_handler(smc_fid, x1, x2, x3, handle));
+}
+DECLARE_RT_SVC_FID(imx_src, IMX_SIP_SRC, RT_SVC_FID_ANY_SUB, imx_sip_src);
+#endif
+
+#if IMX_SIP_HAS_GPC
+static uintptr_t imx_sip_gpc(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_gpc_handler(smc_fid, x1, x2, x3));
+}
+DECLARE_RT_SVC_FID(imx_gpc, IMX_SIP_GPC, RT_SVC_FID_ANY_SUB, imx_sip_gpc);
+
+static uintptr_t imx_sip_hab(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_hab_handler(smc_fid, x1, x2, x3, x4));
+}
+DECLARE_RT_SVC_FID(imx_hab, IMX_SIP_HAB, RT_SVC_FID_ANY_SUB, imx_sip_hab);
+#endif
+
+#if IMX_SIP_HAS_GPC_PM_DOMAIN
+/* Power domain control goes straight to the GPC, it is the hottest GPC call */
+static uintptr_t imx_sip_gpc_pm_domain(IMX_SIP_ARGS)
+{
+	imx_gpc_pm_domain_enable(x2, x3);
+	SMC_RET1(handle, 0);
+}
+DECLARE_RT_SVC_FID(imx_gpc_pm_domain, IMX_SIP_GPC, IMX_SIP_GPC_PM_DOMAIN,
+		   imx_sip_gpc_pm_domain);
+#endif
+
+#if defined(PLAT_imx8mq)
+static uintptr_t imx_sip_soc_info(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_soc_info_handler(smc_fid, x1, x2, x3));
+}
+DECLARE_RT_SVC_FID(imx_soc_info, IMX_SIP_GET_SOC_INFO, RT_SVC_FID_ANY_SUB,
+		   imx_sip_soc_info);
+
+static uintptr_t imx_sip_noc(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_noc_handler(smc_fid, x1, x2, x3));
+}
+DECLARE_RT_SVC_FID(imx_noc, IMX_SIP_NOC, RT_SVC_FID_ANY_SUB, imx_sip_noc);
+#endif
+
+#if defined(PLAT_imx8ulp)
+static uintptr_t imx_sip_scmi(IMX_SIP_ARGS)
+{
+	scmi_smt_fastcall_smc_entry(0);
+	SMC_RET1(handle, 0);
+}
+DECLARE_RT_SVC_FID(imx_scmi, IMX_SIP_SCMI, RT_SVC_FID_ANY_SUB, imx_sip_scmi);
+
+static uintptr_t imx_sip_hifi_xrdc(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_hifi_xrdc(smc_fid));
+}
+DECLARE_RT_SVC_FID(imx_hifi_xrdc, IMX_SIP_HIFI_XRDC, RT_SVC_FID_ANY_SUB,
+		   imx_sip_hifi_xrdc);
+#endif
+
+#if IMX_SOC_IMX8Q
+static uintptr_t imx_sip_srtc(IMX_SIP_ARGS)
+{
+	return imx_srtc_handler(smc_fid, handle, x1, x2, x3, x4);
+}
+DECLARE_RT_SVC_FID(imx_srtc, IMX_SIP_SRTC, RT_SVC_FID_ANY_SUB, imx_sip_srtc);
+
+static uintptr_t imx_sip_cpufreq(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_cpufreq_handler(smc_fid, x1, x2, x3));
+}
+DECLARE_RT_SVC_FID(imx_cpufreq, IMX_SIP_CPUFREQ, RT_SVC_FID_ANY_SUB,
+		   imx_sip_cpufreq);
+
+static uintptr_t imx_sip_wakeup_src(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_wakeup_src_handler(smc_fid, x1, x2, x3));
+}
+DECLARE_RT_SVC_FID(imx_wakeup_src, IMX_SIP_WAKEUP_SRC, RT_SVC_FID_ANY_SUB,
+		   imx_sip_wakeup_src);
+
+static uintptr_t imx_sip_otp(IMX_SIP_ARGS)
+{
+	return imx_otp_handler(smc_fid, handle, x1, x2);
+}
+DECLARE_RT_SVC_FID(imx_otp_read, IMX_SIP_OTP_READ, RT_SVC_FID_ANY_SUB,
+		   imx_sip_otp);
+DECLARE_RT_SVC_FID(imx_otp_write, IMX_SIP_OTP_WRITE, RT_SVC_FID_ANY_SUB,
+		   imx_sip_otp);
+
+static uintptr_t imx_sip_misc_set_temp(IMX_SIP_ARGS)
+{
+	SMC_RET1(handle, imx_misc_set_temp_handler(smc_fid, x1, x2, x3, x4));
+}
+DECLARE_RT_SVC_FID(imx_misc_set_temp, IMX_SIP_MISC_SET_TEMP,
+		   RT_SVC_FID_ANY_SUB, imx_sip_misc_set_temp);
+#endif
+
 static int32_t imx_sip_setup(void)
 {
+	rt_svc_fid_init();
+
 	return 0;
 }
 
@@ -26,82 +259,14 @@ static uintptr_t imx_sip_handler(unsigned int smc_fid,
 			void *handle,
 			u_register_t flags)
 {
-	switch (smc_fid) {
-	case IMX_SIP_AARCH32:
-		SMC_RET1(handle, imx_kernel_entry_handler(smc_fid, x1, x2, x3, x4));
-		break;
-#if defined(PLAT_imx8ulp)
-	case IMX_SIP_SCMI:
-		scmi_smt_fastcall_smc_entry(0);
-		SMC_RET1(handle, 0);
-		break;
-	case IMX_SIP_HIFI_XRDC:
-		SMC_RET1(handle, imx_hifi_xrdc(smc_fid));
-		break;
-	case IMX_SIP_DDR_DVFS:
-		return dram_dvfs_handler(smc_fid, handle, x1, x2, x3);
-		break;
-#endif
-#if defined(PLAT_imx8mq)
-	case IMX_SIP_GET_SOC_INFO:
-		SMC_RET1(handle, imx_soc_info_handler(smc_fid, x1, x2, x3));
-		break;
-	case IMX_SIP_GPC:
-		SMC_RET1(handle, imx_gpc_handler(smc_fid, x1, x2, x3));
-		break;
-	case IMX_SIP_SRC:
-		SMC_RET1(handle, imx_src_handler(smc_fid, x1, x2, x3, handle));
-		break;
-	case IMX_SIP_DDR_DVFS:
-		return dram_dvfs_handler(smc_fid, handle, x1, x2, x3);
-	case IMX_SIP_HAB:
-		SMC_RET1(handle, imx_hab_handler(smc_fid, x1, x2, x3, x4));
-		break;
-	case IMX_SIP_NOC:
-		SMC_RET1(handle, imx_noc_handler(smc_fid, x1, x2, x3));
-		break;
-#endif
-#if defined(PLAT_imx8mm) || defined(PLAT_imx8mn) || defined(PLAT_imx8mp)
-	case IMX_SIP_DDR_DVFS:
-		return dram_dvfs_handler(smc_fid, handle, x1, x2, x3);
-	case IMX_SIP_GPC:
-		SMC_RET1(handle, imx_gpc_handler(smc_fid, x1, x2, x3));
-		break;
-	case IMX_SIP_SRC:
-		SMC_RET1(handle, imx_src_handler(smc_fid, x1, x2, x3, handle));
-		break;
-	case IMX_SIP_HAB:
-		SMC_RET1(handle, imx_hab_handler(smc_fid, x1, x2, x3, x4));
-		break;
-#endif
-#if (defined(PLAT_imx8qm) || defined(PLAT_imx8qx) || defined(PLAT_imx8dx) || defined(PLAT_imx8dxl))
-	case  IMX_SIP_SRTC:
-		return imx_srtc_handler(smc_fid, handle, x1, x2, x3, x4);
-	case  IMX_SIP_CPUFREQ:
-		SMC_RET1(handle, imx_cpufreq_handler(smc_fid, x1, x2, x3));
-		break;
-	case  IMX_SIP_WAKEUP_SRC:
-		SMC_RET1(handle, imx_wakeup_src_handler(smc_fid, x1, x2, x3));
-	case IMX_SIP_OTP_READ:
-	case IMX_SIP_OTP_WRITE:
-		return imx_otp_handler(smc_fid, handle, x1, x2);
-	case IMX_SIP_MISC_SET_TEMP:
-		SMC_RET1(handle, imx_misc_set_temp_handler(smc_fid, x1, x2, x3, x4));
-#endif
-	case  IMX_SIP_BUILDINFO:
-		SMC_RET1(handle, imx_buildinfo_handler(smc_fid, x1, x2, x3, x4));
-#if defined(PLAT_imx93)
-	case IMX_SIP_DDR_DVFS:
-		return dram_dvfs_handler(smc_fid, handle, x1, x2, x3);
-	case IMX_SIP_SRC:
-		SMC_RET1(handle, imx_src_handler(smc_fid, x1, x2, x3, handle));
-		break;
-#endif
-	default:
+	const rt_svc_fid_desc_t *desc = rt_svc_fid_lookup(smc_fid, x1);
+
+	if (desc == NULL) {
 		WARN("Unimplemented i.MX SiP Service Call: 0x%x\n", smc_fid);
 		SMC_RET1(handle, SMC_UNK);
-		break;
 	}
+
+	return desc->handle(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
 }
 
 /* Define a runtime service descriptor for fast SMC calls */
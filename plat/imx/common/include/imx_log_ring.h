@@ -0,0 +1,24 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef IMX_LOG_RING_H
+#define IMX_LOG_RING_H
+
+#include <drivers/console.h>
+
+/*
+ * With IMX_LOG_RING, the runtime logs go to the per-CPU log rings and the
+ * boot console, unless NULL, only prints them on a crash. Otherwise this does
+ * nothing.
+ */
+#if defined(IMX_LOG_RING)
+void imx_log_ring_setup(console_t *boot_console);
+#else
+static inline void imx_log_ring_setup(console_t *boot_console)
+{
+}
+#endif
+
+#endif /* IMX_LOG_RING_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 
 /* SMC function IDs for SiP Service queries */
 #define IMX_SIP_GPC			0xC2000000
+#define IMX_SIP_GPC_PM_DOMAIN		0x03
 
 #define IMX_SIP_CPUFREQ			0xC2000001
 #define IMX_SIP_SET_CPUFREQ		0x00
@@ -64,6 +65,24 @@
 
 #define IMX_SIP_MISC_SET_TEMP		0xC200000C
 
+#define IMX_SIP_PSCI_STAT		0xC200000D
+
+#define IMX_SIP_IDLE_PREDICT			0xC200000F
+#define IMX_SIP_IDLE_PREDICT_GET_STATS		0x00
+#define IMX_SIP_IDLE_PREDICT_CLEAR_STATS	0x01
+
+/*
+ * 0xC2000010 to 0xC2000012 are reserved for the PMF calls of
+ * include/lib/pmf/pmf.h. Only 0xC2000011 (timeline) and 0xC2000012 (SMC
+ * latency) are handled, with ENABLE_BOOT_TIMELINE and ENABLE_SMC_LATENCY_STATS.
+ */
+#define IMX_SIP_LOG_RING		0xC2000013
+#define IMX_SIP_LOG_RING_GET_INFO	0x00
+#define IMX_SIP_LOG_RING_READ		0x01
+#define IMX_SIP_LOG_RING_DRAIN		0x02
+
+#define IMX_SIP_CALL_COUNT		0xC20000FC
+
 #define IMX_SIP_AARCH32			0xC20000FD
 
 int imx_kernel_entry_handler(uint32_t smc_fid, u_register_t x1,
@@ -74,34 +93,68 @@ int imx_kernel_entry_handler(uint32_t smc_fid, u_register_t x1,
 
 #define IMX_SIP_HIFI_XRDC               0xC200000E
 
-#if defined(PLAT_imx8mq)
-int imx_soc_info_handler(uint32_t smc_fid, u_register_t x1,
-			 u_register_t x2, u_register_t x3);
-int imx_gpc_handler(uint32_t smc_fid, u_register_t x1,
-		    u_register_t x2, u_register_t x3);
-int imx_src_handler(uint32_t smc_fid, u_register_t x1,
-		    u_register_t x2, u_register_t x3, void *handle);
-int dram_dvfs_handler(uint32_t smc_fid, void *handle,
-	u_register_t x1, u_register_t x2, u_register_t x3);
+/* SoC families sharing their SiP services */
+#if defined(PLAT_imx8mq) || defined(PLAT_imx8mm) || defined(PLAT_imx8mn) || \
+	defined(PLAT_imx8mp)
+#define IMX_SOC_IMX8M			1
+#else
+#define IMX_SOC_IMX8M			0
+#endif
 
-int imx_hab_handler(uint32_t smc_fid, u_register_t x1,
-	u_register_t x2, u_register_t x3, u_register_t x4);
-int imx_noc_handler(uint32_t smc_fid, u_register_t x1,
-	u_register_t x2, u_register_t x3);
+#if defined(PLAT_imx8qm) || defined(PLAT_imx8qx) || defined(PLAT_imx8dx) || \
+	defined(PLAT_imx8dxl)
+#define IMX_SOC_IMX8Q			1
+#else
+#define IMX_SOC_IMX8Q			0
+#endif
+
+/* SiP services provided by the SoC, fixed at build time */
+#if IMX_SOC_IMX8M || defined(PLAT_imx8ulp) || defined(PLAT_imx93)
+#define IMX_SIP_HAS_DDR_DVFS		1
+#else
+#define IMX_SIP_HAS_DDR_DVFS		0
+#endif
+
+#if IMX_SOC_IMX8M || defined(PLAT_imx93)
+#define IMX_SIP_HAS_SRC			1
+#else
+#define IMX_SIP_HAS_SRC			0
+#endif
+
+/* The GPC and HAB services of i.MX8M, the power domains but on i.MX8MQ */
+#define IMX_SIP_HAS_GPC			IMX_SOC_IMX8M
+#if IMX_SOC_IMX8M && !defined(PLAT_imx8mq)
+#define IMX_SIP_HAS_GPC_PM_DOMAIN	1
+#else
+#define IMX_SIP_HAS_GPC_PM_DOMAIN	0
 #endif
-#if defined(PLAT_imx8mm) || defined(PLAT_imx8mn) || defined(PLAT_imx8mp)
+
+#if IMX_SIP_HAS_DDR_DVFS
 int dram_dvfs_handler(uint32_t smc_fid, void *handle,
 	u_register_t x1, u_register_t x2, u_register_t x3);
-
-int imx_gpc_handler(uint32_t smc_fid, u_register_t x1,
-		    u_register_t x2, u_register_t x3);
+#endif
+#if IMX_SIP_HAS_SRC
 int imx_src_handler(uint32_t smc_fid, u_register_t x1,
 		    u_register_t x2, u_register_t x3, void *handle);
+#endif
+#if IMX_SIP_HAS_GPC
+int imx_gpc_handler(uint32_t smc_fid, u_register_t x1,
+		    u_register_t x2, u_register_t x3);
 int imx_hab_handler(uint32_t smc_fid, u_register_t x1,
 	u_register_t x2, u_register_t x3, u_register_t x4);
 #endif
+#if defined(PLAT_imx8mq)
+int imx_soc_info_handler(uint32_t smc_fid, u_register_t x1,
+			 u_register_t x2, u_register_t x3);
+int imx_noc_handler(uint32_t smc_fid, u_register_t x1,
+	u_register_t x2, u_register_t x3);
+#endif
+#if defined(IMX_IDLE_PREDICT)
+uintptr_t imx_idle_predict_handler(uint32_t smc_fid, void *handle,
+				   u_register_t x1);
+#endif
 
-#if (defined(PLAT_imx8qm) || defined(PLAT_imx8qx) || defined(PLAT_imx8dx) || defined(PLAT_imx8dxl))
+#if IMX_SOC_IMX8Q
 int imx_cpufreq_handler(uint32_t smc_fid, u_register_t x1,
 			u_register_t x2, u_register_t x3);
 int imx_srtc_handler(uint32_t smc_fid, void *handle, u_register_t x1,
@@ -121,15 +174,4 @@ uint64_t imx_buildinfo_handler(uint32_t smc_fid, u_register_t x1,
 int scmi_handler(uint32_t smc_fid, u_register_t x1, u_register_t x2, u_register_t x3);
 int imx_hifi_xrdc(uint32_t smc_fid);
 
-#if defined(PLAT_imx8ulp)
-int dram_dvfs_handler(uint32_t smc_fid, void *handle,
-	u_register_t x1, u_register_t x2, u_register_t x3);
-#endif
-
-#if defined(PLAT_imx93)
-int imx_src_handler(uint32_t smc_fid, u_register_t x1,
-		    u_register_t x2, u_register_t x3, void *handle);
-int dram_dvfs_handler(uint32_t smc_fid, void *handle,
-	u_register_t x1, u_register_t x2, u_register_t x3);
-#endif
 #endif /* __IMX_SIP_SVC_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright 2018 NXP
+ * Copyright 2018-2022 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -73,8 +73,8 @@ void ddr4_mr_write(uint32_t mr, uint32_t data, uint32_t mr_type,
 
 void dram_cfg_all_mr(struct dram_info *info, uint32_t pstate)
 {
-	uint32_t num_rank = info->num_rank;
-	uint32_t dram_type = info->dram_type;
+	uint32_t num_rank = dram_get_num_rank();
+	uint32_t dram_type = dram_get_type();
 	/*
 	 * 15. Perform MRS commands as required to re-program
 	 * timing registers in the SDRAM for the new frequency
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019 NXP
+ * Copyright 2019-2022 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -103,7 +103,7 @@ static void get_mr_values(uint32_t (*mr_value)[8])
 		}
 
 #if defined(PLAT_imx8mp)
-		if (dram_info.dram_type == DDRC_LPDDR4) {
+		if (dram_is_lpddr4()) {
 			mr_value[fsp_index][5] = lpddr4_mr_read(1, 12); /* read MR12 from DRAM */
 			mr_value[fsp_index][7] = lpddr4_mr_read(1, 14); /* read MR14 from DRAM */
 		}
@@ -114,14 +114,14 @@ static void get_mr_values(uint32_t (*mr_value)[8])
 static void save_rank_setting(void)
 {
 	uint32_t i, offset;
-	uint32_t pstate_num = dram_info.num_fsp;
+	uint32_t pstate_num = dram_get_num_fsp();
 
 	/* only support maximum 3 setpoints */
 	pstate_num = (pstate_num > MAX_FSP_NUM) ? MAX_FSP_NUM : pstate_num;
 
 	for(i = 0; i < pstate_num; i++) {
 		offset = i ? (i + 1) * 0x1000 : 0;
-		if (dram_info.dram_type == DDRC_LPDDR4) {
+		if (dram_is_lpddr4()) {
 			dram_info.rank_setting[i][0] = mmio_read_32(DDRC_DRAMTMG2(0) + offset);
 		} else {
 			dram_info.rank_setting[i][0] = mmio_read_32(DDRC_DRAMTMG2(0) + offset);
@@ -221,6 +221,13 @@ void dram_info_init(unsigned long dram_timing_base)
 	dram_info.num_rank = ((ddrc_mstr >> 24) & ACTIVE_RANK_MASK) == 0x3 ?
 		DDRC_ACTIVE_TWO_RANK : DDRC_ACTIVE_ONE_RANK;
 
+	/* the DRAM must match the configuration fixed at build time, if any */
+	if (dram_info.dram_type != dram_get_type() ||
+	    dram_info.num_rank != dram_get_num_rank()) {
+		ERROR("DRAM does not match the build configuration\n");
+		panic();
+	}
+
 	/* Get current fsp info */
 	current_fsp = mmio_read_32(DDRC_DFIMISC(0));
 	current_fsp = (current_fsp >> 8) & 0xf;
@@ -245,6 +252,19 @@ void dram_info_init(unsigned long dram_timing_base)
 	/* only support maximum 3 setpoints */
 	dram_info.num_fsp = (i > MAX_FSP_NUM) ? MAX_FSP_NUM : i;
 
+	/* check if has bypass mode support */
+	if (i != 0 && dram_info.timing_info->fsp_table[i-1] < 666)
+		dram_info.bypass_mode = true;
+	else
+		dram_info.bypass_mode = false;
+
+	/* and so must its timing, even when it has no setpoint at all */
+	if (dram_info.num_fsp != dram_get_num_fsp() ||
+	    dram_info.bypass_mode != dram_has_bypass_mode()) {
+		ERROR("DRAM timing does not match the build configuration\n");
+		panic();
+	}
+
 	/* no valid fsp table, return directly */
 	if (i == 0)
 		return;
@@ -252,19 +272,13 @@ void dram_info_init(unsigned long dram_timing_base)
 	/* save the DRAMTMG2/9 for rank to rank workaround */
 	save_rank_setting();
 
-	/* check if has bypass mode support */
-	if (dram_info.timing_info->fsp_table[i-1] < 666)
-		dram_info.bypass_mode = true;
-	else
-		dram_info.bypass_mode = false;
-
 	/* Register the EL3 handler for DDR DVFS */
 	set_interrupt_rm_flag(flags, NON_SECURE);
 	rc = register_interrupt_type_handler(INTR_TYPE_EL3, waiting_dvfs, flags);
 	if (rc)
 		panic();
 
-	if (dram_info.dram_type == DDRC_LPDDR4 && current_fsp != 0x0) {
+	if (dram_is_lpddr4() && current_fsp != 0x0) {
 		/* flush the L1/L2 cache */
 		dcsw_op_all(DCCSW);
 		lpddr4_swffc(&dram_info, dev_fsp, 0x0);
@@ -301,13 +315,13 @@ int dram_dvfs_get_freq_info(void *handle, u_register_t index)
 	case 0: SMC_RET4(handle, dram_info.timing_info->fsp_table[0],
 				1, 0, 5);
 	case 1:
-		if (!dram_info.bypass_mode)
+		if (!dram_has_bypass_mode())
 			SMC_RET4(handle, dram_info.timing_info->fsp_table[1],
 					1, 0, 0);
 		SMC_RET4(handle, dram_info.timing_info->fsp_table[1],
 				2, 2, 4);
 	case 2:
-		if (!dram_info.bypass_mode)
+		if (!dram_has_bypass_mode())
 			SMC_RET4(handle, dram_info.timing_info->fsp_table[2],
 					1, 0, 0);
 		SMC_RET4(handle, dram_info.timing_info->fsp_table[2],
@@ -328,7 +342,7 @@ int dram_dvfs_handler(uint32_t smc_fid, void *handle,
 	uint32_t online_cores = x2;
 
 	if (IMX_SIP_DDR_DVFS_GET_FREQ_COUNT == x1) {
-		SMC_RET1(handle, dram_info.num_fsp);
+		SMC_RET1(handle, dram_get_num_fsp());
 	} else if (IMX_SIP_DDR_DVFS_GET_FREQ_INFO == x1) {
 		return dram_dvfs_get_freq_info(handle, x2);
 	} else if (x1 < 3U) {
@@ -355,7 +369,7 @@ int dram_dvfs_handler(uint32_t smc_fid, void *handle,
 		/* flush the L1/L2 cache */
 		dcsw_op_all(DCCSW);
 
-		if (dram_info.dram_type == DDRC_LPDDR4) {
+		if (dram_is_lpddr4()) {
 			lpddr4_swffc(&dram_info, dev_fsp, fsp_index);
 			dev_fsp = (~dev_fsp) & 0x1;
 		} else {
@@ -0,0 +1,49 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+IMX_DRAM_SOURCES	:=	plat/imx/imx8m/ddr/dram.c		\
+				plat/imx/imx8m/ddr/clock.c		\
+				plat/imx/imx8m/ddr/dram_retention.c	\
+				plat/imx/imx8m/ddr/ddr4_dvfs.c		\
+				plat/imx/imx8m/ddr/lpddr4_dvfs.c
+
+# The DRAM of the board is detected at boot, from the DDRC and the DRAM timing
+# passed by the SPL. When it is known at build time, setting it here turns the
+# checks of the DVFS and retention paths into constants and drops the code of
+# the other configurations.
+
+# DRAM type: lpddr4, ddr4, ddr3l or auto
+IMX_DRAM_TYPE		?=	auto
+ifeq (${IMX_DRAM_TYPE},lpddr4)
+$(eval $(call add_define_val,IMX_DRAM_TYPE,DDRC_LPDDR4))
+else ifeq (${IMX_DRAM_TYPE},ddr4)
+$(eval $(call add_define_val,IMX_DRAM_TYPE,DDRC_DDR4))
+else ifeq (${IMX_DRAM_TYPE},ddr3l)
+$(eval $(call add_define_val,IMX_DRAM_TYPE,DDRC_DDR3L))
+else ifneq (${IMX_DRAM_TYPE},auto)
+$(error "IMX_DRAM_TYPE must be lpddr4, ddr4, ddr3l or auto")
+endif
+
+# Number of ranks: 1, 2 or 0 to detect it
+IMX_DRAM_NUM_RANK	?=	0
+$(if $(filter-out 0 1 2,${IMX_DRAM_NUM_RANK}),$(error "IMX_DRAM_NUM_RANK must be 0, 1 or 2"))
+ifneq (${IMX_DRAM_NUM_RANK},0)
+$(eval $(call add_define,IMX_DRAM_NUM_RANK))
+endif
+
+# Number of setpoints of the DRAM timing: 1 to 3 or 0 to detect it
+IMX_DRAM_NUM_FSP	?=	0
+$(if $(filter-out 0 1 2 3,${IMX_DRAM_NUM_FSP}),$(error "IMX_DRAM_NUM_FSP must be 0 to 3"))
+ifneq (${IMX_DRAM_NUM_FSP},0)
+$(eval $(call add_define,IMX_DRAM_NUM_FSP))
+endif
+
+# DRAM PLL bypassed for the low setpoints: 0, 1 or auto
+IMX_DRAM_BYPASS		?=	auto
+ifneq (${IMX_DRAM_BYPASS},auto)
+$(eval $(call assert_boolean,IMX_DRAM_BYPASS))
+$(eval $(call add_define,IMX_DRAM_BYPASS))
+endif
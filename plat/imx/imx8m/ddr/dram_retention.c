@@ -1,5 +1,5 @@
 /*
- * Copyright 2018-2019 NXP
+ * Copyright 2018-2022 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -28,14 +28,14 @@ bool imx_is_m4_enabled(void);
 void rank_setting_update(void)
 {
 	uint32_t i, offset;
-	uint32_t pstate_num = dram_info.num_fsp;
+	uint32_t pstate_num = dram_get_num_fsp();
 
 	/* only support maximum 3 setpoints */
 	pstate_num = (pstate_num > MAX_FSP_NUM) ? MAX_FSP_NUM : pstate_num;
 
 	for (i = 0; i < pstate_num; i++) {
 		offset = i ? (i + 1) * 0x1000 : 0;
-		if (dram_info.dram_type == DDRC_LPDDR4) {
+		if (dram_is_lpddr4()) {
 			mmio_write_32(DDRC_DRAMTMG2(0) + offset,
 				dram_info.rank_setting[i][0]);
 		} else {
@@ -70,7 +70,7 @@ void dram_enter_retention(void)
 	mmio_write_32(DDRC_PWRCTL(0), 0xaa);
 
 	/* LPDDR4 & DDR4/DDR3L need to check different status */
-	if (dram_info.dram_type == DDRC_LPDDR4)
+	if (dram_is_lpddr4())
 		while(0x223 != (mmio_read_32(DDRC_STAT(0)) & 0x33f))
 			;
 	else
@@ -172,7 +172,7 @@ void dram_exit_retention(void)
 	mmio_write_32(DDRC_SWCTL(0), 0x0);
 
 #if !PLAT_imx8mn
-	if (dram_info.dram_type == DDRC_LPDDR4)
+	if (dram_is_lpddr4())
 		mmio_write_32(DDRC_DDR_SS_GPR0, 0x01); /*LPDDR4 mode */
 #endif /* !PLAT_imx8mn */
 
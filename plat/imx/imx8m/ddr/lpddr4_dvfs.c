@@ -1,5 +1,5 @@
 /*
- * Copyright 2018 NXP
+ * Copyright 2018-2022 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -196,7 +196,8 @@ void lpddr4_swffc(struct dram_info *info, unsigned int init_fsp,
 	} while ((val & 0x1) == 0x1);
 
 	/* change the clock frequency */
-	dram_clock_switch(info->timing_info->fsp_table[fsp_index], info->bypass_mode);
+	dram_clock_switch(info->timing_info->fsp_table[fsp_index],
+			  dram_has_bypass_mode());
 
 	/* dfi_init_start de-assert */
 	mmio_clrbits_32(DDRC_DFIMISC(0), 0x20);
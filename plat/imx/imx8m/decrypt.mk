@@ -0,0 +1,46 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+# Decrypt the encrypted images with mbed TLS, or with the CAAM when
+# IMX_CAAM_DECRYPT=1. The CAAM path has not been validated on hardware yet, so
+# it is left off by default.
+ifneq (${DECRYPTION_SUPPORT},none)
+IMX_CAAM_DECRYPT	?=	0
+BL2_SOURCES		+=	drivers/io/io_encrypted.c			\
+				plat/imx/imx8m/imx8m_enc_key.c
+
+ifeq (${IMX_CAAM_DECRYPT},1)
+PLAT_INCLUDES		+=	-Idrivers/imx/caam
+BL2_SOURCES		+=	drivers/imx/caam/imx_caam_gcm.c
+endif
+
+# Source of the key the images are encrypted with: otp, read from the fuse
+# words starting at IMX_ENC_KEY_OTP_WORD, or blob, a CAAM blob loaded at
+# IMX_ENC_KEY_BLOB_BASE. There is no default, to never fall back to the test
+# key of plat/common.
+ifeq (${IMX_ENC_KEY_SOURCE},otp)
+ifeq (${IMX_ENC_KEY_OTP_WORD},)
+$(error "IMX_ENC_KEY_OTP_WORD must be set with IMX_ENC_KEY_SOURCE=otp")
+endif
+$(eval $(call add_define_val,IMX_ENC_KEY_OTP,1))
+$(eval $(call add_define,IMX_ENC_KEY_OTP_WORD))
+else ifeq (${IMX_ENC_KEY_SOURCE},blob)
+ifneq (${IMX_CAAM_DECRYPT},1)
+$(error "IMX_ENC_KEY_SOURCE=blob requires IMX_CAAM_DECRYPT=1")
+endif
+ifeq (${IMX_ENC_KEY_BLOB_BASE},)
+$(error "IMX_ENC_KEY_BLOB_BASE must be set with IMX_ENC_KEY_SOURCE=blob")
+endif
+$(eval $(call add_define_val,IMX_ENC_KEY_BLOB,1))
+$(eval $(call add_define,IMX_ENC_KEY_BLOB_BASE))
+else
+$(error "IMX_ENC_KEY_SOURCE must be otp or blob with DECRYPTION_SUPPORT")
+endif
+else
+IMX_CAAM_DECRYPT	:=	0
+endif
+$(eval $(call assert_boolean,IMX_CAAM_DECRYPT))
+$(eval $(call add_define,IMX_CAAM_DECRYPT))
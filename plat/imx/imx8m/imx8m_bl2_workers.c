@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+
+#include <arch_helpers.h>
+#include <common/tbbr/tbbr_img_def.h>
+#include <cortex_a53.h>
+#include <lib/mmio.h>
+#include <plat/common/platform.h>
+#include <platform_def.h>
+
+#include <gpc.h>
+
+/*
+ * Secondary CPU handling for BL2_PARALLEL_AUTH. The power controller is
+ * programmed the same way as for PSCI CPU_ON/CPU_OFF in BL31, so that the
+ * parked cores are in the state BL31 expects when it powers them on again.
+ */
+
+int bl2_plat_worker_release(unsigned int core_pos, uintptr_t entrypoint)
+{
+	uint64_t entry = (uint64_t)entrypoint >> 2;
+
+	mmio_write_32(IMX_SRC_BASE + SRC_GPR1_OFFSET + (core_pos << 3),
+		      (uint32_t)(entry >> 22) & 0xffff);
+	mmio_write_32(IMX_SRC_BASE + SRC_GPR1_OFFSET + (core_pos << 3) + 4,
+		      (uint32_t)entry & 0x003fffff);
+
+	/* clear the wfi power down bit of the core */
+	mmio_clrbits_32(IMX_GPC_BASE + LPCR_A53_AD, COREx_WFI_PDN(core_pos));
+
+	/* assert the ncpuporeset */
+	mmio_clrbits_32(IMX_SRC_BASE + SRC_A53RCR1, (1 << core_pos));
+	/* assert the pcg pcr bit of the core */
+	mmio_setbits_32(IMX_GPC_BASE + COREx_PGC_PCR(core_pos), 0x1);
+	/* sw power up the core */
+	mmio_setbits_32(IMX_GPC_BASE + CPU_PGC_UP_TRG, (1 << core_pos));
+
+	/* wait for the power up finished */
+	while ((mmio_read_32(IMX_GPC_BASE + CPU_PGC_UP_TRG) & (1 << core_pos)) != 0)
+		;
+
+	/* deassert the pcg pcr bit of the core */
+	mmio_clrbits_32(IMX_GPC_BASE + COREx_PGC_PCR(core_pos), 0x1);
+	/* deassert the ncpuporeset */
+	mmio_setbits_32(IMX_SRC_BASE + SRC_A53RCR1, (1 << core_pos));
+
+	return 0;
+}
+
+void bl2_plat_worker_setup(void)
+{
+	/* BL2 runs with the MMU off on i.MX8M, nothing to do */
+}
+
+void bl2_plat_worker_park(void)
+{
+	unsigned int core_id = plat_my_core_pos();
+
+	/* enable the wfi power down of the core */
+	mmio_setbits_32(IMX_GPC_BASE + LPCR_A53_AD, COREx_WFI_PDN(core_id));
+	/* assert the pcg pcr bit of the core */
+	mmio_setbits_32(IMX_GPC_BASE + COREx_PGC_PCR(core_id), 0x1);
+}
+
+void __dead2 bl2_plat_worker_pwr_down(void)
+{
+	/* Cortex-A53 core power down sequence */
+	write_sctlr_el3(read_sctlr_el3() & ~SCTLR_C_BIT);
+	isb();
+	dcsw_op_level1(DCCISW);
+	write_a53_cpuectlr_el1(read_a53_cpuectlr_el1() &
+			       ~CORTEX_A53_ECTLR_SMP_BIT);
+	isb();
+
+	for (;;) {
+		dsb();
+		wfi();
+	}
+}
+
+bool bl2_plat_defer_image_auth(unsigned int image_id)
+{
+	/*
+	 * The post image load handling parses the BL32 header and may
+	 * decompress BL33, these must be authenticated right away.
+	 */
+	switch (image_id) {
+	case BL31_IMAGE_ID:
+	case BL32_EXTRA1_IMAGE_ID:
+	case BL32_EXTRA2_IMAGE_ID:
+		return true;
+	case BL33_IMAGE_ID:
+		return IMX_BL33_LZ4 == 0;
+	default:
+		return false;
+	}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <plat/common/platform.h>
+#include <tools_share/firmware_encrypted.h>
+
+#include <platform_def.h>
+
+#if IMX_ENC_KEY_OTP
+#include <imx8m_ocotp.h>
+#endif
+#if IMX_ENC_KEY_BLOB
+#include <imx_caam_gcm.h>
+#endif
+
+/* AES-256 key, as used by the encrypt_fw tool */
+#define IMX_ENC_KEY_LEN			U(32)
+
+#if IMX_ENC_KEY_OTP
+/*
+ * The key is burnt in IMX_ENC_KEY_LEN / 4 consecutive fuse words, starting at
+ * word IMX_ENC_KEY_OTP_WORD.
+ */
+static int imx8m_otp_key(uint8_t *key, size_t *key_len, unsigned int *flags)
+{
+	int rc;
+
+	rc = imx8m_ocotp_read_secret(IMX_ENC_KEY_OTP_WORD, key,
+				     IMX_ENC_KEY_LEN);
+	if (rc == -EACCES) {
+		ERROR("Encryption key fuses are read protected\n");
+		return rc;
+	} else if (rc != 0) {
+		ERROR("Encryption key fuses are not programmed\n");
+		return rc;
+	}
+
+	*key_len = IMX_ENC_KEY_LEN;
+	*flags = 0U;
+
+	return 0;
+}
+#endif /* IMX_ENC_KEY_OTP */
+
+#if IMX_ENC_KEY_BLOB
+/* Key modifier the blob of the key must be encapsulated with */
+static const char imx8m_enc_key_mod[] = "imx8m-fip-enckey";
+
+/*
+ * The key is held in a CAAM blob loaded at IMX_ENC_KEY_BLOB_BASE, which the
+ * CAAM decapsulates into a black key.
+ */
+static int imx8m_blob_key(uint8_t *key, size_t *key_len, unsigned int *flags)
+{
+	imx_caam_key_id_t key_id = {
+		.type = IMX_CAAM_KEY_BLACK_BLOB,
+		.key_len = IMX_ENC_KEY_LEN,
+		.blob_base = IMX_ENC_KEY_BLOB_BASE,
+	};
+
+	memcpy(key_id.key_mod, imx8m_enc_key_mod, sizeof(key_id.key_mod));
+	memcpy(key, &key_id, sizeof(key_id));
+	*key_len = sizeof(key_id);
+	*flags = ENC_KEY_IS_IDENTIFIER;
+
+	return 0;
+}
+#endif /* IMX_ENC_KEY_BLOB */
+
+/*
+ * The same key is returned whether the images are encrypted with the SSK or
+ * the BSSK.
+ */
+int plat_get_enc_key_info(enum fw_enc_status_t fw_enc_status, uint8_t *key,
+			  size_t *key_len, unsigned int *flags,
+			  const uint8_t *img_id, size_t img_id_len)
+{
+	assert(*key_len >= ENC_MAX_KEY_SIZE);
+
+#if IMX_ENC_KEY_OTP
+	return imx8m_otp_key(key, key_len, flags);
+#else
+	return imx8m_blob_key(key, key_len, flags);
+#endif
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/runtime_svc.h>
+#include <lib/psci/psci.h>
+#include <plat/common/platform.h>
+
+#include <imx_sip_svc.h>
+#include <imx8m_psci.h>
+#include <platform_def.h>
+
+/*
+ * Cluster idle state prediction.
+ *
+ * Powering down the PLAT/SCU only saves energy if the cluster stays idle long
+ * enough to pay back the L2 flush and the cluster restore. The durations of
+ * the last cluster idle periods (whatever the cluster state) are kept, and a
+ * cluster power down requested through CPU_SUSPEND is demoted to the cluster
+ * WAIT retention state when the predicted idle time is below the break-even
+ * residency. The prediction is the average of the history, the longest period
+ * excluded, so that one long idle period does not hide a burst of short ones.
+ *
+ * Everything below is accessed by the last CPU entering or the first CPU
+ * leaving a cluster low power state, holding the PSCI cluster lock, with the
+ * data cache possibly disabled on the wake-up path.
+ */
+#define IDLE_HIST_LEN			U(8)
+#define CLUSTER_PDN_BREAK_EVEN_TICKS	((uint64_t)PLAT_CLUSTER_PDN_BREAK_EVEN_US * \
+					 (COUNTER_FREQUENCY / 1000000))
+
+struct imx_idle_predict {
+	/* Durations of the last cluster idle periods, in counter ticks */
+	uint64_t hist[IDLE_HIST_LEN];
+	unsigned int hist_idx;
+	unsigned int hist_count;
+	/* Last prediction made, in counter ticks */
+	uint64_t predicted;
+	/* Decision of the last coordination of the cluster state */
+	bool demote;
+	/* State of the current cluster idle period */
+	bool in_idle;
+	bool pdn_requested;
+	bool demoted;
+	uint64_t entry_ts;
+	/* Statistics reported through IMX_SIP_IDLE_PREDICT */
+	uint64_t idle_count;
+	uint64_t pdn_count;
+	uint64_t demote_count;
+	uint64_t demote_miss;
+	uint64_t pdn_miss;
+};
+
+static struct imx_idle_predict cluster_idle
+#if USE_COHERENT_MEM
+__section("tzfw_coherent_mem")
+#endif
+;
+
+static bool imx_idle_predict_short(void)
+{
+	uint64_t sum = 0U, max = 0U;
+	unsigned int i;
+
+	/* Never demote until the history is full */
+	if (cluster_idle.hist_count < IDLE_HIST_LEN)
+		return false;
+
+	for (i = 0U; i < IDLE_HIST_LEN; i++) {
+		sum += cluster_idle.hist[i];
+		if (cluster_idle.hist[i] > max)
+			max = cluster_idle.hist[i];
+	}
+
+	cluster_idle.predicted = (sum - max) / (IDLE_HIST_LEN - 1U);
+
+	return cluster_idle.predicted < CLUSTER_PDN_BREAK_EVEN_TICKS;
+}
+
+/*
+ * Coordinate the cluster state like the generic implementation does, and
+ * demote an idle cluster power down to retention when the cluster is not
+ * expected to stay idle long enough. System suspend, which requests
+ * PLAT_STOP_OFF_STATE, is left alone, and so is the OS-initiated mode where
+ * the state the OS chose must be honoured as is.
+ */
+plat_local_state_t plat_get_target_pwr_state(unsigned int lvl,
+					     const plat_local_state_t *states,
+					     unsigned int ncpu)
+{
+	plat_local_state_t target = PLAT_MAX_OFF_STATE;
+	unsigned int i;
+
+	for (i = 0U; i < ncpu; i++) {
+		if (states[i] < target)
+			target = states[i];
+	}
+
+	if (lvl != IMX_PWR_LVL1)
+		return target;
+
+	cluster_idle.demote = false;
+
+#if PSCI_OS_INIT_MODE
+	if (psci_get_suspend_mode() == OS_INIT)
+		return target;
+#endif
+
+	if ((target == PLAT_MAX_OFF_STATE) && imx_idle_predict_short()) {
+		cluster_idle.demote = true;
+		target = PLAT_WAIT_RET_STATE;
+	}
+
+	return target;
+}
+
+void imx_idle_predict_enter(const psci_power_state_t *target_state)
+{
+	plat_local_state_t cluster_state = CLUSTER_PWR_STATE(target_state);
+
+	if (is_local_state_run(cluster_state) ||
+	    !is_local_state_run(SYSTEM_PWR_STATE(target_state)))
+		return;
+
+	cluster_idle.in_idle = true;
+	cluster_idle.demoted = cluster_idle.demote;
+	cluster_idle.pdn_requested = cluster_idle.demoted ||
+				     (cluster_state == PLAT_MAX_OFF_STATE);
+	cluster_idle.demote = false;
+
+	cluster_idle.idle_count++;
+	if (cluster_idle.pdn_requested)
+		cluster_idle.pdn_count++;
+	if (cluster_idle.demoted)
+		cluster_idle.demote_count++;
+
+	cluster_idle.entry_ts = read_cntpct_el0();
+}
+
+void imx_idle_predict_exit(const psci_power_state_t *target_state)
+{
+	uint64_t duration;
+
+	if (!cluster_idle.in_idle || is_local_state_run(CLUSTER_PWR_STATE(target_state)))
+		return;
+
+	cluster_idle.in_idle = false;
+	duration = read_cntpct_el0() - cluster_idle.entry_ts;
+
+	if (cluster_idle.pdn_requested) {
+		if (cluster_idle.demoted &&
+		    (duration >= CLUSTER_PDN_BREAK_EVEN_TICKS))
+			cluster_idle.demote_miss++;
+		else if (!cluster_idle.demoted &&
+			 (duration < CLUSTER_PDN_BREAK_EVEN_TICKS))
+			cluster_idle.pdn_miss++;
+	}
+
+	cluster_idle.hist[cluster_idle.hist_idx] = duration;
+	cluster_idle.hist_idx = (cluster_idle.hist_idx + 1U) % IDLE_HIST_LEN;
+	if (cluster_idle.hist_count < IDLE_HIST_LEN)
+		cluster_idle.hist_count++;
+}
+
+/*
+ * CPU_OFF coordinates the cluster state too, but the decision it leaves is
+ * not followed by imx_idle_predict_enter(). Drop it so that it is never
+ * taken for the one of a later cluster idle period.
+ */
+void imx_idle_predict_off(void)
+{
+	cluster_idle.demote = false;
+}
+
+uintptr_t imx_idle_predict_handler(uint32_t smc_fid, void *handle,
+				   u_register_t x1)
+{
+	switch (x1) {
+	case IMX_SIP_IDLE_PREDICT_GET_STATS:
+		SMC_RET7(handle, SMC_OK, cluster_idle.idle_count,
+			 cluster_idle.pdn_count, cluster_idle.demote_count,
+			 cluster_idle.demote_miss, cluster_idle.pdn_miss,
+			 cluster_idle.predicted * 1000000U / COUNTER_FREQUENCY);
+	case IMX_SIP_IDLE_PREDICT_CLEAR_STATS:
+		cluster_idle.idle_count = 0U;
+		cluster_idle.pdn_count = 0U;
+		cluster_idle.demote_count = 0U;
+		cluster_idle.demote_miss = 0U;
+		cluster_idle.pdn_miss = 0U;
+		SMC_RET1(handle, SMC_OK);
+	default:
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -64,6 +64,10 @@ void imx_pwr_domain_off(const psci_power_state_t *target_state)
 
 	plat_gic_cpuif_disable();
 	imx_set_cpu_pwr_off(core_id);
+
+#if defined(IMX_IDLE_PREDICT)
+	imx_idle_predict_off();
+#endif
 }
 
 int imx_validate_power_state(unsigned int power_state,
@@ -73,19 +77,42 @@ int imx_validate_power_state(unsigned int power_state,
 	int pwr_type = psci_get_pstate_type(power_state);
 	int state_id = psci_get_pstate_id(power_state);
 
+	int cluster_state = IMX_PSTATE_ID_LVL(state_id, IMX_PWR_LVL1);
+
 	if (pwr_lvl > PLAT_MAX_PWR_LVL)
 		return PSCI_E_INVALID_PARAMS;
 
+#if PSCI_OS_INIT_MODE
+	req_state->last_at_pwrlvl = pwr_lvl;
+#endif
+
 	if (pwr_type == PSTATE_TYPE_STANDBY) {
 		CORE_PWR_STATE(req_state) = PLAT_MAX_RET_STATE;
-		CLUSTER_PWR_STATE(req_state) = PLAT_MAX_RET_STATE;
+		/* core retention only, see PLAT_PSCI_FAST_STANDBY_IDS */
+		if (state_id != PLAT_MAX_RET_STATE)
+			CLUSTER_PWR_STATE(req_state) = PLAT_MAX_RET_STATE;
+		return PSCI_E_SUCCESS;
 	}
 
-	if (pwr_type == PSTATE_TYPE_POWERDOWN && state_id == 0x33) {
+	if (state_id == 0x33) {
 		CORE_PWR_STATE(req_state) = PLAT_MAX_OFF_STATE;
 		CLUSTER_PWR_STATE(req_state) = PLAT_WAIT_RET_STATE;
+		return PSCI_E_SUCCESS;
 	}
 
+	/* composite state id, the system level is only for system suspend */
+	if ((IMX_PSTATE_ID_LVL(state_id, IMX_PWR_LVL0) != PLAT_MAX_OFF_STATE) ||
+	    (IMX_PSTATE_ID_LVL(state_id, IMX_PWR_LVL2) != PSCI_LOCAL_STATE_RUN))
+		return PSCI_E_INVALID_PARAMS;
+
+	if ((cluster_state != PSCI_LOCAL_STATE_RUN) &&
+	    (cluster_state != PLAT_WAIT_RET_STATE) &&
+	    (cluster_state != PLAT_MAX_OFF_STATE))
+		return PSCI_E_INVALID_PARAMS;
+
+	CORE_PWR_STATE(req_state) = PLAT_MAX_OFF_STATE;
+	CLUSTER_PWR_STATE(req_state) = cluster_state;
+
 	return PSCI_E_SUCCESS;
 }
 
@@ -134,6 +161,10 @@ void imx_domain_suspend(const psci_power_state_t *target_state)
 
 		imx_set_sys_wakeup(core_id, true);
 	}
+
+#if defined(IMX_IDLE_PREDICT)
+	imx_idle_predict_enter(target_state);
+#endif
 }
 
 void imx_domain_suspend_finish(const psci_power_state_t *target_state)
@@ -141,6 +172,10 @@ void imx_domain_suspend_finish(const psci_power_state_t *target_state)
 	uint64_t mpidr = read_mpidr_el1();
 	unsigned int core_id = MPIDR_AFFLVL0_VAL(mpidr);
 
+#if defined(IMX_IDLE_PREDICT)
+	imx_idle_predict_exit(target_state);
+#endif
+
 	if (is_local_state_off(SYSTEM_PWR_STATE(target_state))) {
 		if (!imx_m4_lpa_active()) {
 			imx_noc_wrapper_post_resume(core_id);
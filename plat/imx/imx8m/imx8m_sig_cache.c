@@ -0,0 +1,77 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* mbed TLS headers */
+#include <mbedtls/md.h>
+
+#include <common/debug.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+
+#include <imx8m_ocotp.h>
+
+/* Size of the device secret and of the key derived from it */
+#define IMX_SIG_CACHE_KEY_LEN		U(32)
+
+/*
+ * Label of the key derivation, so that the secret may be shared with other
+ * uses, e.g. the encryption key of the images, without reusing the key itself.
+ */
+static const char imx8m_sig_cache_label[] = "imx8m-sig-cache";
+
+static uint8_t imx8m_sig_cache_key[IMX_SIG_CACHE_KEY_LEN];
+static bool imx8m_sig_cache_key_valid;
+
+/*
+ * The key protecting the signature cache is derived with HMAC-SHA256 from a
+ * device-unique secret, burnt in IMX_SIG_CACHE_KEY_LEN / 4 consecutive fuse
+ * words starting at word IMX_SIG_CACHE_KEY_OTP_WORD.
+ */
+int plat_get_sig_cache_key(uint8_t **key, size_t *key_len)
+{
+	const mbedtls_md_info_t *md_info;
+	uint8_t secret[IMX_SIG_CACHE_KEY_LEN];
+	int rc;
+
+	if (!imx8m_sig_cache_key_valid) {
+		rc = imx8m_ocotp_read_secret(IMX_SIG_CACHE_KEY_OTP_WORD,
+					     secret, sizeof(secret));
+		if (rc != 0) {
+			ERROR("Signature cache key fuses are %s\n",
+			      (rc == -EACCES) ? "read protected" :
+			      "not programmed");
+			zeromem(secret, sizeof(secret));
+			return rc;
+		}
+
+		md_info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+		if (md_info == NULL) {
+			zeromem(secret, sizeof(secret));
+			return -1;
+		}
+
+		rc = mbedtls_md_hmac(md_info, secret, sizeof(secret),
+				     (const unsigned char *)imx8m_sig_cache_label,
+				     sizeof(imx8m_sig_cache_label) - 1U,
+				     imx8m_sig_cache_key);
+		zeromem(secret, sizeof(secret));
+		if (rc != 0) {
+			return -1;
+		}
+
+		imx8m_sig_cache_key_valid = true;
+	}
+
+	*key = imx8m_sig_cache_key;
+	*key_len = sizeof(imx8m_sig_cache_key);
+
+	return 0;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2017-2021 NXP
+ * Copyright 2017-2022 NXP
  * Copyright 2021 Arm
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -11,6 +11,7 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/desc_image_load.h>
+#include <common/image_decompress.h>
 #include <context.h>
 #include <drivers/console.h>
 #include <drivers/generic_delay_timer.h>
@@ -30,6 +31,13 @@
 #include "imx8mm_private.h"
 #include "platform_def.h"
 
+#if IMX_CAAM_DECRYPT
+#include <imx_caam_gcm.h>
+#endif
+#if IMX_BL33_LZ4
+#include <tf_lz4.h>
+#endif
+
 static const struct aipstz_cfg aipstz[] = {
 	{IMX_AIPSTZ1, 0x77777777, 0x77777777, .opacr = {0x0, 0x0, 0x0, 0x0, 0x0}, },
 	{IMX_AIPSTZ2, 0x77777777, 0x77777777, .opacr = {0x0, 0x0, 0x0, 0x0, 0x0}, },
@@ -89,6 +97,11 @@ void bl2_el3_early_platform_setup(u_register_t arg1, u_register_t arg2,
 
 	/* Open handles to a FIP image */
 	plat_imx_io_setup();
+
+#if IMX_CAAM_DECRYPT
+	/* Job ring 0 may be in use by HAB, decrypt the images with ring 2 */
+	(void)imx_caam_gcm_init(IMX_CAAM_BASE, 2U);
+#endif
 }
 
 void bl2_el3_plat_arch_setup(void)
@@ -99,6 +112,29 @@ void bl2_platform_setup(void)
 {
 }
 
+#if IMX_BL33_LZ4
+void bl2_plat_preload_setup(void)
+{
+	/* unlz4() resolves back-references in the output, no workspace */
+	image_decompress_init_in_place(0U, 0U, unlz4);
+}
+
+int bl2_plat_handle_pre_image_load(unsigned int image_id)
+{
+	bl_mem_params_node_t *bl_mem_params;
+
+	if (image_id != BL33_IMAGE_ID) {
+		return 0;
+	}
+
+	bl_mem_params = get_bl_mem_params_node(image_id);
+	assert(bl_mem_params);
+
+	return image_decompress_prepare_in_place(image_id,
+						 &bl_mem_params->image_info);
+}
+#endif
+
 int bl2_plat_handle_post_image_load(unsigned int image_id)
 {
 	int err = 0;
@@ -124,6 +160,11 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 		}
 
 		break;
+#if IMX_BL33_LZ4
+	case BL33_IMAGE_ID:
+		err = image_decompress(&bl_mem_params->image_info);
+		break;
+#endif
 	default:
 		/* Do nothing in default case */
 		break;
@@ -24,6 +24,7 @@
 #include <dram.h>
 #include <gpc.h>
 #include <imx_aipstz.h>
+#include <imx_log_ring.h>
 #include <imx_uart.h>
 #include <imx_rdc.h>
 #include <imx8m_caam.h>
@@ -201,6 +202,7 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 		IMX_CONSOLE_BAUDRATE, &console);
 	/* This console is only used for boot stage */
 	console_set_scope(&console, CONSOLE_FLAG_BOOT);
+	imx_log_ring_setup(&console);
 
 	/*
 	 * tell BL3-1 where the non-secure software image is located
@@ -36,6 +36,12 @@
 #define PLAT_WAIT_RET_STATE		U(1)
 #define PLAT_STOP_OFF_STATE		U(3)
 
+/* Minimum cluster idle time for the PLAT/SCU power down to save energy */
+#define PLAT_CLUSTER_PDN_BREAK_EVEN_US	U(5000)
+
+/* Standby state id of the core retention state, with the cluster running */
+#define PLAT_PSCI_FAST_STANDBY_IDS	BIT_32(PLAT_MAX_RET_STATE)
+
 #define PLAT_PRI_BITS			U(3)
 #define PLAT_SDEI_CRITICAL_PRI		0x10
 #define PLAT_SDEI_NORMAL_PRI		0x20
@@ -47,6 +53,10 @@
 /* non-secure uboot base */
 #define PLAT_NS_IMAGE_OFFSET		U(0x40200000)
 
+/* ENABLE_PSCI_STAT_EXT snapshots, same location as on imx8mm/imx8mp */
+#define PLAT_PSCI_STAT_SHM_SIZE		U(0x2000)
+#define PLAT_PSCI_STAT_SHM_BASE		(PLAT_NS_IMAGE_OFFSET - U(0x1000) - PLAT_PSCI_STAT_SHM_SIZE)
+
 #define BL32_FDT_OVERLAY_ADDR		(PLAT_NS_IMAGE_OFFSET + 0x3000000)
 
 /* GICv3 base address */
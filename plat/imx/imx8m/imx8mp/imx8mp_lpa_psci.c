@@ -202,7 +202,7 @@ static void dram_exit_retention_with_target(uint32_t target)
 	mmio_write_32(DDRC_SWCTL(0), 0x0);
 
 #if !PLAT_imx8mn
-	if (dram_info.dram_type == DDRC_LPDDR4)
+	if (dram_is_lpddr4())
 		mmio_write_32(DDRC_DDR_SS_GPR0, 0x01); /*LPDDR4 mode */
 #endif /* !PLAT_imx8mn */
 
@@ -499,6 +499,10 @@ void imx_domain_suspend(const psci_power_state_t *target_state)
 		}
                 sema4_unlock(SEMA4ID);
 	}
+
+#if defined(IMX_IDLE_PREDICT)
+	imx_idle_predict_enter(target_state);
+#endif
 }
 
 void imx_domain_suspend_finish(const psci_power_state_t *target_state)
@@ -506,6 +510,10 @@ void imx_domain_suspend_finish(const psci_power_state_t *target_state)
 	uint64_t mpidr = read_mpidr_el1();
 	unsigned int core_id = MPIDR_AFFLVL0_VAL(mpidr);
 
+#if defined(IMX_IDLE_PREDICT)
+	imx_idle_predict_exit(target_state);
+#endif
+
 	if (is_local_state_off(SYSTEM_PWR_STATE(target_state))) {
                 sema4_lock(SEMA4ID);
 		if (!imx_m4_lpa_active()) {
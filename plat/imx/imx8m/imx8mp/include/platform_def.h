@@ -35,6 +35,12 @@
 #define PLAT_WAIT_RET_STATE		U(1)
 #define PLAT_STOP_OFF_STATE		U(3)
 
+/* Minimum cluster idle time for the PLAT/SCU power down to save energy */
+#define PLAT_CLUSTER_PDN_BREAK_EVEN_US	U(5000)
+
+/* Standby state id of the core retention state, with the cluster running */
+#define PLAT_PSCI_FAST_STANDBY_IDS	BIT_32(PLAT_MAX_RET_STATE)
+
 #if defined(NEED_BL2)
 #define BL2_BASE			U(0x960000)
 #define BL2_LIMIT			U(0x980000)
@@ -47,6 +53,10 @@
 /* Define FIP image location on eMMC */
 #define IMX_FIP_MMC_BASE		U(0x100000)
 
+/* Scratch buffer for BL2_READ_AHEAD, right after the FIP block buffer */
+#define PLAT_BL2_READ_AHEAD_BASE	(IMX_FIP_BASE + IMX_FIP_SIZE)
+#define PLAT_BL2_READ_AHEAD_SIZE	U(0x02000000)
+
 #define PLAT_IMX8MP_BOOT_MMC_BASE	U(0x30B50000) /* SD */
 #else
 #define BL31_BASE			U(0x970000)
@@ -62,6 +72,14 @@
 #define PLAT_NS_IMAGE_OFFSET		U(0x40200000)
 #define PLAT_NS_IMAGE_SIZE		U(0x00200000)
 
+/* Boot timeline for ENABLE_BOOT_TIMELINE, right below the BL33 load address */
+#define PLAT_BOOT_TIMELINE_SIZE		U(0x1000)
+#define PLAT_BOOT_TIMELINE_BASE		(PLAT_NS_IMAGE_OFFSET - PLAT_BOOT_TIMELINE_SIZE)
+
+/* ENABLE_PSCI_STAT_EXT snapshots, right below the boot timeline */
+#define PLAT_PSCI_STAT_SHM_SIZE		U(0x2000)
+#define PLAT_PSCI_STAT_SHM_BASE		(PLAT_BOOT_TIMELINE_BASE - PLAT_PSCI_STAT_SHM_SIZE)
+
 #define BL32_FDT_OVERLAY_ADDR		(PLAT_NS_IMAGE_OFFSET + 0x3000000)
 
 /* GICv3 base address */
@@ -111,6 +129,7 @@
 #define IMX_TZASC_BASE			U(0x32F80000)
 #define IMX_IOMUX_GPR_BASE		U(0x30340000)
 #define IMX_CAAM_BASE			U(0x30900000)
+#define IMX_OCOTP_BASE			U(0x30350000)
 #define IMX_DDRC_BASE			U(0x3d400000)
 #define IMX_DDRPHY_BASE			U(0x3c000000)
 #define IMX_DDR_IPS_BASE		U(0x3d000000)
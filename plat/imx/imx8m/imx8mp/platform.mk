@@ -15,11 +15,8 @@ include lib/xlat_tables_v2/xlat_tables.mk
 # Include GICv3 driver files
 include drivers/arm/gic/v3/gicv3.mk
 
-IMX_DRAM_SOURCES	:=	plat/imx/imx8m/ddr/dram.c		\
-				plat/imx/imx8m/ddr/clock.c		\
-				plat/imx/imx8m/ddr/dram_retention.c	\
-				plat/imx/imx8m/ddr/ddr4_dvfs.c		\
-				plat/imx/imx8m/ddr/lpddr4_dvfs.c
+# Include DRAM driver files
+include plat/imx/imx8m/ddr/dram.mk
 
 IMX_GIC_SOURCES		:=	${GICV3_SOURCES}			\
 				plat/common/plat_gicv3.c		\
@@ -86,10 +83,10 @@ RESET_TO_BL31		:=	0
 $(eval $(call TOOL_ADD_PAYLOAD,${BUILD_PLAT}/tb_fw.crt,--tb-fw-cert))
 endif
 ifneq ($(BL32_EXTRA1),)
-$(eval $(call TOOL_ADD_IMG,BL32_EXTRA1,--tos-fw-extra1))
+$(eval $(call TOOL_ADD_IMG,BL32_EXTRA1,--tos-fw-extra1,,$(ENCRYPT_BL32)))
 endif
 ifneq ($(BL32_EXTRA2),)
-$(eval $(call TOOL_ADD_IMG,BL32_EXTRA2,--tos-fw-extra2))
+$(eval $(call TOOL_ADD_IMG,BL32_EXTRA2,--tos-fw-extra2,,$(ENCRYPT_BL32)))
 endif
 ifneq ($(HW_CONFIG),)
 $(eval $(call TOOL_ADD_IMG,HW_CONFIG,--hw-config))
@@ -102,6 +99,29 @@ LOAD_IMAGE_V2		:=	1
 BL2_AT_EL3		:=	1
 endif
 
+# Pack BL33 LZ4 compressed and decompress it in place from BL2
+IMX_BL33_LZ4		?=	0
+$(eval $(call assert_boolean,IMX_BL33_LZ4))
+$(eval $(call add_define,IMX_BL33_LZ4))
+
+ifeq (${IMX_BL33_LZ4},1)
+include lib/lz4/lz4.mk
+
+BL2_SOURCES		+=	common/image_decompress.c			\
+				${LZ4_SOURCES}
+
+BL33_PRE_TOOL_FILTER	:=	LZ4
+endif
+
+include plat/imx/imx8m/decrypt.mk
+include plat/imx/imx8m/sig_cache.mk
+
+ifeq (${BL2_PARALLEL_AUTH},1)
+BL2_SOURCES		+=	plat/imx/imx8m/imx8m_bl2_workers.c
+endif
+
+include plat/imx/common/imx_pmf.mk
+
 ifneq (${TRUSTED_BOARD_BOOT},0)
 
 include drivers/auth/mbedtls/mbedtls_crypto.mk
@@ -143,6 +163,9 @@ endif
 USE_COHERENT_MEM	:=	1
 RESET_TO_BL31		:=	1
 A53_DISABLE_NON_TEMPORAL_HINT := 0
+PSCI_LOCK_ELISION	:=	1
+PSCI_OS_INIT_MODE	:=	1
+PSCI_STANDBY_FAST_PATH	:=	1
 
 ERRATA_A53_835769	:=	1
 ERRATA_A53_843419	:=	1
@@ -177,3 +200,11 @@ BL31_SOURCES            +=      plat/imx/imx8m/fsl_sema4.c			\
                                 plat/imx/imx8m/sema4.c				\
                                 plat/imx/imx8m/imx8mp/imx8mp_lpa_psci.c
 endif
+
+IMX_IDLE_PREDICT	?=	0
+ifeq (${IMX_IDLE_PREDICT},1)
+BL31_SOURCES		+=	plat/imx/imx8m/imx8m_idle_predict.c
+$(eval $(call add_define,IMX_IDLE_PREDICT))
+endif
+
+include plat/imx/common/imx_log_ring.mk
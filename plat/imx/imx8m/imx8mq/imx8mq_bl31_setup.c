@@ -28,6 +28,7 @@
 #include <dram.h>
 #include <gpc.h>
 #include <imx_aipstz.h>
+#include <imx_log_ring.h>
 #include <imx_uart.h>
 #include <imx_rdc.h>
 #include <imx8m_caam.h>
@@ -161,6 +162,9 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 	console_imx_uart_register(IMX_BOOT_UART_BASE, IMX_BOOT_UART_CLK_IN_HZ,
 		IMX_CONSOLE_BAUDRATE, &console);
 #endif
+
+	/* The UART, if any, keeps its default boot and crash scope */
+	imx_log_ring_setup(NULL);
 	/*
 	 * tell BL3-1 where the non-secure software image is located
 	 * and the entry state information.
@@ -259,6 +263,9 @@ unsigned int plat_get_syscnt_freq2(void)
 
 void bl31_plat_runtime_setup(void)
 {
+#if defined(IMX_LOG_RING)
+	console_switch_state(CONSOLE_FLAG_RUNTIME);
+#endif
 	return;
 }
 
@@ -32,6 +32,12 @@
 #define PLAT_WAIT_OFF_STATE		U(2)
 #define PLAT_STOP_OFF_STATE		U(3)
 
+/* Minimum cluster idle time for the PLAT/SCU power down to save energy */
+#define PLAT_CLUSTER_PDN_BREAK_EVEN_US	U(5000)
+
+/* Standby state id of the core retention state, with the cluster running */
+#define PLAT_PSCI_FAST_STANDBY_IDS	BIT_32(PLAT_MAX_RET_STATE)
+
 #define BL31_BASE			U(0x910000)
 #define BL31_LIMIT			U(0x920000)
 
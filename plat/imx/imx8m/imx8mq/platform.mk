@@ -14,11 +14,8 @@ PLAT_INCLUDES		:=	-Iplat/imx/common/include		\
 # Include GICv3 driver files
 include drivers/arm/gic/v3/gicv3.mk
 
-IMX_DRAM_SOURCES	:=	plat/imx/imx8m/ddr/dram.c		\
-				plat/imx/imx8m/ddr/clock.c		\
-				plat/imx/imx8m/ddr/dram_retention.c	\
-				plat/imx/imx8m/ddr/ddr4_dvfs.c		\
-				plat/imx/imx8m/ddr/lpddr4_dvfs.c
+# Include DRAM driver files
+include plat/imx/imx8m/ddr/dram.mk
 
 IMX_GIC_SOURCES		:=	${GICV3_SOURCES}			\
 				plat/common/plat_gicv3.c		\
@@ -69,6 +66,9 @@ endif
 USE_COHERENT_MEM	:=	1
 RESET_TO_BL31		:=	1
 A53_DISABLE_NON_TEMPORAL_HINT := 0
+PSCI_LOCK_ELISION	:=	1
+PSCI_OS_INIT_MODE	:=	1
+PSCI_STANDBY_FAST_PATH	:=	1
 WARMBOOT_ENABLE_DCACHE_EARLY	:=	1
 
 ERRATA_A53_835769	:=	1
@@ -87,3 +87,13 @@ $(eval $(call add_define,IMX_BOOT_UART_BASE))
 ifeq (${IMX_ANDROID_BUILD},true)
 $(eval $(call add_define,IMX_ANDROID_BUILD))
 endif
+
+IMX_IDLE_PREDICT	?=	0
+ifeq (${IMX_IDLE_PREDICT},1)
+BL31_SOURCES		+=	plat/imx/imx8m/imx8m_idle_predict.c
+$(eval $(call add_define,IMX_IDLE_PREDICT))
+endif
+
+include plat/imx/common/imx_log_ring.mk
+
+include plat/imx/common/imx_pmf.mk
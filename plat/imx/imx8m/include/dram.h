@@ -1,5 +1,5 @@
 /*
- * Copyright 2019 NXP
+ * Copyright 2019-2022 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -66,6 +66,52 @@ struct dram_info {
 
 extern struct dram_info dram_info;
 
+/*
+ * DRAM configuration of the board, constant when it is fixed at build time
+ * by IMX_DRAM_TYPE, IMX_DRAM_NUM_RANK, IMX_DRAM_NUM_FSP or IMX_DRAM_BYPASS,
+ * so that the code of the other configurations is dropped.
+ */
+static inline int dram_get_type(void)
+{
+#ifdef IMX_DRAM_TYPE
+	return IMX_DRAM_TYPE;
+#else
+	return dram_info.dram_type;
+#endif
+}
+
+static inline bool dram_is_lpddr4(void)
+{
+	return dram_get_type() == DDRC_LPDDR4;
+}
+
+static inline unsigned int dram_get_num_rank(void)
+{
+#ifdef IMX_DRAM_NUM_RANK
+	return IMX_DRAM_NUM_RANK;
+#else
+	return dram_info.num_rank;
+#endif
+}
+
+static inline uint32_t dram_get_num_fsp(void)
+{
+#ifdef IMX_DRAM_NUM_FSP
+	return IMX_DRAM_NUM_FSP;
+#else
+	return dram_info.num_fsp;
+#endif
+}
+
+static inline bool dram_has_bypass_mode(void)
+{
+#ifdef IMX_DRAM_BYPASS
+	return IMX_DRAM_BYPASS != 0;
+#else
+	return dram_info.bypass_mode;
+#endif
+}
+
 void dram_info_init(unsigned long dram_timing_base);
 void dram_umctl2_init(struct dram_timing_info *timing);
 void dram_phy_init(struct dram_timing_info *timing);
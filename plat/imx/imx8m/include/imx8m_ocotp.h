@@ -0,0 +1,47 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef IMX8M_OCOTP_H
+#define IMX8M_OCOTP_H
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <lib/mmio.h>
+
+#include <platform_def.h>
+
+/* Shadow registers of the fuse words, 0xBADABADA when read protected */
+#define OCOTP_SHADOW(_word)		(IMX_OCOTP_BASE + U(0x400) + \
+					 ((_word) * U(0x10)))
+#define OCOTP_READ_LOCKED		U(0xBADABADA)
+
+/*
+ * Read a secret burnt in len / 4 consecutive fuse words, starting at word
+ * 'word' (bank * 4 + word), least significant byte first. Returns -EACCES if
+ * the fuses are read protected and -ENOENT if they are not programmed.
+ */
+static inline int imx8m_ocotp_read_secret(unsigned int word, uint8_t *buf,
+					  size_t len)
+{
+	uint32_t val, blank = 0U;
+	unsigned int i;
+
+	for (i = 0U; i < (len / 4U); i++) {
+		val = mmio_read_32(OCOTP_SHADOW(word + i));
+		if (val == OCOTP_READ_LOCKED) {
+			return -EACCES;
+		}
+
+		blank |= val;
+		memcpy(&buf[i * 4U], &val, sizeof(val));
+	}
+
+	return (blank == 0U) ? -ENOENT : 0;
+}
+
+#endif /* IMX8M_OCOTP_H */
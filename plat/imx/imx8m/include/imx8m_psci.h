@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,6 +11,18 @@
 #define CLUSTER_PWR_STATE(state) ((state)->pwr_domain_state[MPIDR_AFFLVL1])
 #define SYSTEM_PWR_STATE(state) ((state)->pwr_domain_state[PLAT_MAX_PWR_LVL])
 
+/*
+ * CPU_SUSPEND power down state ids give the local state requested for each
+ * power level, one nibble per level starting with the core: 0x04 for core
+ * power down, 0x14 for core power down with cluster WAIT retention and 0x44
+ * for core and PLAT/SCU power down. 0x33 is the legacy id of core power down
+ * with cluster WAIT retention.
+ */
+#define IMX_PSTATE_ID_LVL_WIDTH		U(4)
+#define IMX_PSTATE_ID_LVL_MASK		U(0xf)
+#define IMX_PSTATE_ID_LVL(id, lvl)	(((id) >> ((lvl) * IMX_PSTATE_ID_LVL_WIDTH)) & \
+					 IMX_PSTATE_ID_LVL_MASK)
+
 int imx_pwr_domain_on(u_register_t mpidr);
 void imx_pwr_domain_on_finish(const psci_power_state_t *target_state);
 void imx_pwr_domain_off(const psci_power_state_t *target_state);
@@ -19,4 +31,10 @@ void imx_cpu_standby(plat_local_state_t cpu_state);
 void imx_domain_suspend(const psci_power_state_t *target_state);
 void imx_domain_suspend_finish(const psci_power_state_t *target_state);
 
+#if defined(IMX_IDLE_PREDICT)
+void imx_idle_predict_enter(const psci_power_state_t *target_state);
+void imx_idle_predict_exit(const psci_power_state_t *target_state);
+void imx_idle_predict_off(void);
+#endif
+
 #endif /* IMX8M_PSCI_H */
@@ -0,0 +1,23 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+# The signature cache is stored in raw blocks of the boot eMMC, starting at
+# the block aligned offset IMX_SIG_CACHE_MMC_BASE, and protected with a key
+# derived from the secret burnt in the 8 fuse words starting at
+# IMX_SIG_CACHE_KEY_OTP_WORD. There are no defaults: both must be reserved for
+# this use on the board.
+ifeq (${AUTH_SIG_CACHE},1)
+ifeq (${IMX_SIG_CACHE_KEY_OTP_WORD},)
+$(error "IMX_SIG_CACHE_KEY_OTP_WORD must be set with AUTH_SIG_CACHE")
+endif
+ifeq (${IMX_SIG_CACHE_MMC_BASE},)
+$(error "IMX_SIG_CACHE_MMC_BASE must be set with AUTH_SIG_CACHE")
+endif
+$(eval $(call add_define,IMX_SIG_CACHE_KEY_OTP_WORD))
+$(eval $(call add_define,IMX_SIG_CACHE_MMC_BASE))
+
+BL2_SOURCES		+=	plat/imx/imx8m/imx8m_sig_cache.c
+endif
@@ -28,6 +28,7 @@
 #include <plat_imx8.h>
 #include <sci/sci.h>
 #include <sec_rsrc.h>
+#include <imx_log_ring.h>
 #include <imx_sip_svc.h>
 #include <string.h>
 
@@ -38,10 +39,6 @@ IMPORT_SYM(unsigned long, __RW_START__, BL31_RW_START);
 IMPORT_SYM(unsigned long, __DATA_START__, BL31_DATA_START);
 IMPORT_SYM(unsigned long, __DATA_END__, BL31_DATA_END);
 
-#if DEBUG_CONSOLE
-extern unsigned long console_list;
-#endif
-
 static entry_point_info_t bl32_image_ep_info;
 static entry_point_info_t bl33_image_ep_info;
 
@@ -454,7 +451,7 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 #if DEBUG_CONSOLE
 	static console_t console;
 
-	console_list = 0;
+	console_list = NULL;
 #endif
 	if (sc_ipc_open(&ipc_handle, SC_IPC_BASE) != SC_ERR_NONE)
 		panic();
@@ -478,6 +475,9 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 		     IMX_CONSOLE_BAUDRATE, &console);
 #endif
 
+	/* The UART, if any, keeps its default boot and crash scope */
+	imx_log_ring_setup(NULL);
+
 	/* Turn on MU for non-secure OS/Hypervisor */
 	sc_pm_set_resource_power_mode(ipc_handle, NS_OS_MU, SC_PM_PW_MODE_ON);
 
@@ -590,6 +590,9 @@ unsigned int plat_get_syscnt_freq2(void)
 
 void bl31_plat_runtime_setup(void)
 {
+#if defined(IMX_LOG_RING)
+	console_switch_state(CONSOLE_FLAG_RUNTIME);
+#endif
 	return;
 }
 
@@ -69,3 +69,7 @@ endif
 ifdef COCKPIT_A72
         $(eval $(call add_define,COCKPIT_A72))
 endif
+
+include plat/imx/common/imx_log_ring.mk
+
+include plat/imx/common/imx_pmf.mk
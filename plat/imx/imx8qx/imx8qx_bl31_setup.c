@@ -28,6 +28,7 @@
 #include <plat_imx8.h>
 #include <sci/sci.h>
 #include <sec_rsrc.h>
+#include <imx_log_ring.h>
 #include <imx_sip_svc.h>
 #include <string.h>
 
@@ -38,10 +39,6 @@ IMPORT_SYM(unsigned long, __RW_START__, BL31_RW_START);
 IMPORT_SYM(unsigned long, __DATA_START__, BL31_DATA_START);
 IMPORT_SYM(unsigned long, __DATA_END__, BL31_DATA_END);
 
-#if DEBUG_CONSOLE
-extern unsigned long console_list;
-#endif
-
 static entry_point_info_t bl32_image_ep_info;
 static entry_point_info_t bl33_image_ep_info;
 
@@ -422,7 +419,7 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 #if DEBUG_CONSOLE
 	static console_t console;
 
-	console_list = 0;
+	console_list = NULL;
 #endif
 	if (sc_ipc_open(&ipc_handle, SC_IPC_BASE) != SC_ERR_NONE)
 		panic();
@@ -444,6 +441,9 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 	console_lpuart_register(IMX_BOOT_UART_BASE, IMX_BOOT_UART_CLK_IN_HZ,
 		     IMX_CONSOLE_BAUDRATE, &console);
 #endif
+
+	/* The UART, if any, keeps its default boot and crash scope */
+	imx_log_ring_setup(NULL);
 	/* Turn on MU1 for non-secure OS/Hypervisor */
 	sc_pm_set_resource_power_mode(ipc_handle, SC_R_MU_1A, SC_PM_PW_MODE_ON);
 
@@ -546,6 +546,9 @@ unsigned int plat_get_syscnt_freq2(void)
 
 void bl31_plat_runtime_setup(void)
 {
+#if defined(IMX_LOG_RING)
+	console_switch_state(CONSOLE_FLAG_RUNTIME);
+#endif
 	return;
 }
 #ifdef SPD_trusty
@@ -63,3 +63,7 @@ $(eval $(call add_define,IMX_SEPARATE_XLAT_TABLE))
 
 BL31_SOURCES += plat/imx/common/ffa_shared_mem.c
 endif
+
+include plat/imx/common/imx_log_ring.mk
+
+include plat/imx/common/imx_pmf.mk
@@ -51,6 +51,8 @@ ifeq (${SPD},trusty)
 	BL31_SOURCES += plat/imx/common/ffa_shared_mem.c
 endif
 
+include plat/imx/common/imx_pmf.mk
+
 ifeq ($(findstring clang,$(notdir $(CC))),)
     TF_CFLAGS_aarch64	+=	-fno-strict-aliasing
 endif
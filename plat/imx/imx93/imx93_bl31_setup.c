@@ -19,6 +19,7 @@
 #include <plat/common/platform.h>
 
 #include <imx8_lpuart.h>
+#include <imx_log_ring.h>
 #include <platform_def.h>
 #include <plat_imx8.h>
 #include <trdc.h>
@@ -43,6 +44,9 @@ static const mmap_region_t imx_mmap[] = {
 	MAP_REGION_FLAT(DDRMIX_BASE, DDRMIX_SIZE, MT_DEVICE | MT_RW | MT_NS),
 	MAP_REGION_FLAT(GPIO_BASE, GPIO_SIZE, MT_DEVICE | MT_RW),
 	MAP_REGION_FLAT(NIC_MAIN_GPV_BASE, 0x200000, MT_DEVICE | MT_RW),
+#if ENABLE_PSCI_STAT_EXT
+	MAP_REGION_FLAT(PLAT_PSCI_STAT_SHM_BASE, PLAT_PSCI_STAT_SHM_SIZE, MT_MEMORY | MT_RW | MT_NS),
+#endif
 
 	{0},
 };
@@ -77,6 +81,7 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 
 	/* This console is only used for boot stage */
 	console_set_scope(&console, CONSOLE_FLAG_BOOT);
+	imx_log_ring_setup(&console);
 
 	/*
 	 * tell BL3-1 where the non-secure software image is located
@@ -118,6 +118,15 @@
 #define CLUSTER_PWR_STATE(state) ((state)->pwr_domain_state[MPIDR_AFFLVL1])
 #define SYSTEM_PWR_STATE(state) ((state)->pwr_domain_state[PLAT_MAX_PWR_LVL])
 
+/*
+ * CPU_SUSPEND power down state ids give the local state requested for each
+ * power level, one nibble per level starting with the core: 0x04 for core
+ * power down, 0x24 for core power down with cluster retention and 0x44 for
+ * core and cluster power down. 0x33 is the legacy id of core power down with
+ * cluster retention.
+ */
+#define IMX_PSTATE_ID_LVL(id, lvl)	(((id) >> ((lvl) * 4U)) & 0xfU)
+
 #define GPIO_CTRL_REG_NUM		U(8)
 #define GPIO_PIN_MAX_NUM		U(32)
 #define GPIO_CTX(addr, num)	\
@@ -634,19 +643,42 @@ int imx_validate_power_state(unsigned int power_state,
 	int pwr_type = psci_get_pstate_type(power_state);
 	int state_id = psci_get_pstate_id(power_state);
 
+	int cluster_state = IMX_PSTATE_ID_LVL(state_id, MPIDR_AFFLVL1);
+
 	if (pwr_lvl > PLAT_MAX_PWR_LVL)
 		return PSCI_E_INVALID_PARAMS;
 
+#if PSCI_OS_INIT_MODE
+	req_state->last_at_pwrlvl = pwr_lvl;
+#endif
+
 	if (pwr_type == PSTATE_TYPE_STANDBY) {
 		CORE_PWR_STATE(req_state) = PLAT_MAX_RET_STATE;
-		CLUSTER_PWR_STATE(req_state) = PLAT_MAX_RET_STATE;
+		/* core retention only, see PLAT_PSCI_FAST_STANDBY_IDS */
+		if (state_id != PLAT_MAX_RET_STATE)
+			CLUSTER_PWR_STATE(req_state) = PLAT_MAX_RET_STATE;
+		return PSCI_E_SUCCESS;
 	}
 
-	if (pwr_type == PSTATE_TYPE_POWERDOWN && state_id == 0x33) {
+	if (state_id == 0x33) {
 		CORE_PWR_STATE(req_state) = PLAT_MAX_OFF_STATE;
 		CLUSTER_PWR_STATE(req_state) = PLAT_MAX_RET_STATE;
+		return PSCI_E_SUCCESS;
 	}
 
+	/* composite state id, the system level is only for system suspend */
+	if ((IMX_PSTATE_ID_LVL(state_id, MPIDR_AFFLVL0) != PLAT_MAX_OFF_STATE) ||
+	    (IMX_PSTATE_ID_LVL(state_id, PLAT_MAX_PWR_LVL) != PSCI_LOCAL_STATE_RUN))
+		return PSCI_E_INVALID_PARAMS;
+
+	if ((cluster_state != PSCI_LOCAL_STATE_RUN) &&
+	    (cluster_state != PLAT_MAX_RET_STATE) &&
+	    (cluster_state != PLAT_MAX_OFF_STATE))
+		return PSCI_E_INVALID_PARAMS;
+
+	CORE_PWR_STATE(req_state) = PLAT_MAX_OFF_STATE;
+	CLUSTER_PWR_STATE(req_state) = cluster_state;
+
 	return PSCI_E_SUCCESS;
 }
 
@@ -737,6 +769,18 @@ void imx_pwr_domain_off(const psci_power_state_t *target_state)
 	mmio_setbits_32(IMX_GPC_BASE + GPC_GLOBAL_OFFSET + GPC_SYS_SLEEP, 1 << (17 + core_id));
 }
 
+void imx_cpu_standby(plat_local_state_t cpu_state)
+{
+	dsb();
+	write_scr_el3(read_scr_el3() | SCR_FIQ_BIT);
+	isb();
+
+	wfi();
+
+	write_scr_el3(read_scr_el3() & (~SCR_FIQ_BIT));
+	isb();
+}
+
 void imx_pwr_domain_suspend(const psci_power_state_t *target_state)
 {
 	uint64_t mpidr = read_mpidr_el1();
@@ -904,6 +948,7 @@ void __dead2 imx_system_off(void)
 static const plat_psci_ops_t imx_plat_psci_ops = {
 	.validate_ns_entrypoint = imx_validate_ns_entrypoint,
 	.validate_power_state = imx_validate_power_state,
+	.cpu_standby = imx_cpu_standby,
 	.pwr_domain_on = imx_pwr_domain_on,
 	.pwr_domain_off = imx_pwr_domain_off,
 	.pwr_domain_on_finish = imx_pwr_domain_on_finish,
@@ -28,6 +28,9 @@
 #define PLAT_MAX_OFF_STATE		U(4)
 #define PLAT_MAX_RET_STATE		U(2)
 
+/* Standby state id of the core retention state, with the cluster running */
+#define PLAT_PSCI_FAST_STANDBY_IDS	BIT_32(PLAT_MAX_RET_STATE)
+
 #define BL31_BASE			U(0x204E0000)
 #define BL31_LIMIT			U(0x20520000)
 
@@ -36,6 +39,10 @@
 /* non-secure uboot base */
 /* TODO */
 #define PLAT_NS_IMAGE_OFFSET		U(0x80200000)
+
+/* ENABLE_PSCI_STAT_EXT snapshots, right below the BL33 load address */
+#define PLAT_PSCI_STAT_SHM_SIZE		U(0x2000)
+#define PLAT_PSCI_STAT_SHM_BASE		(PLAT_NS_IMAGE_OFFSET - PLAT_PSCI_STAT_SHM_SIZE)
 #define BL32_FDT_OVERLAY_ADDR           (PLAT_NS_IMAGE_OFFSET + 0x3000000)
 
 /* GICv4 base address */
@@ -46,7 +53,11 @@
 #define PLAT_PHY_ADDR_SPACE_SIZE	(ULL(1) << 32)
 
 #define MAX_XLAT_TABLES			12
+#if ENABLE_PSCI_STAT_EXT
+#define MAX_MMAP_REGIONS		17
+#else
 #define MAX_MMAP_REGIONS		16
+#endif
 
 #define IMX_LPUART_BASE			0x44380000
 #define IMX_BOOT_UART_CLK_IN_HZ		24000000 /* Select 24MHz oscillator */
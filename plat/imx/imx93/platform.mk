@@ -48,8 +48,15 @@ HW_ASSISTED_COHERENCY	:= 	1
 USE_COHERENT_MEM	:=	0
 PROGRAMMABLE_RESET_ADDRESS := 1
 COLD_BOOT_SINGLE_CPU := 1
+PSCI_LOCK_ELISION	:=	1
+PSCI_OS_INIT_MODE	:=	1
+PSCI_STANDBY_FAST_PATH	:=	1
 
 BL32_BASE               ?=      0x96000000
 BL32_SIZE               ?=      0x02000000
 $(eval $(call add_define,BL32_BASE))
 $(eval $(call add_define,BL32_SIZE))
+
+include plat/imx/common/imx_log_ring.mk
+
+include plat/imx/common/imx_pmf.mk
@@ -65,7 +65,7 @@ static uint64_t opteed_sel1_interrupt_handler(uint32_t id,
 	assert(handle == cm_get_context(NON_SECURE));
 
 	/* Save the non-secure context before entering the OPTEE */
-	cm_el1_sysregs_context_save(NON_SECURE);
+	cm_el1_sysregs_context_save_lazy(NON_SECURE);
 
 	/* Get a reference to this cpu's OPTEE context */
 	linear_id = plat_my_core_pos();
@@ -73,7 +73,7 @@ static uint64_t opteed_sel1_interrupt_handler(uint32_t id,
 	assert(&optee_ctx->cpu_ctx == cm_get_context(SECURE));
 
 	cm_set_elr_el3(SECURE, (uint64_t)&optee_vector_table->fiq_entry);
-	cm_el1_sysregs_context_restore(SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
 	cm_set_next_eret_context(SECURE);
 
 	/*
@@ -215,7 +215,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 */
 		assert(handle == cm_get_context(NON_SECURE));
 
-		cm_el1_sysregs_context_save(NON_SECURE);
+		cm_el1_sysregs_context_save_lazy(NON_SECURE);
 
 		/*
 		 * We are done stashing the non-secure context. Ask the
@@ -243,7 +243,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 					&optee_vector_table->yield_smc_entry);
 		}
 
-		cm_el1_sysregs_context_restore(SECURE);
+		cm_el1_sysregs_context_restore_lazy(SECURE);
 		cm_set_next_eret_context(SECURE);
 
 		write_ctx_reg(get_gpregs_ctx(&optee_ctx->cpu_ctx),
@@ -361,14 +361,14 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 * and return to the non-secure state.
 		 */
 		assert(handle == cm_get_context(SECURE));
-		cm_el1_sysregs_context_save(SECURE);
+		cm_el1_sysregs_context_save_lazy(SECURE);
 
 		/* Get a reference to the non-secure context */
 		ns_cpu_context = cm_get_context(NON_SECURE);
 		assert(ns_cpu_context);
 
 		/* Restore non-secure state */
-		cm_el1_sysregs_context_restore(NON_SECURE);
+		cm_el1_sysregs_context_restore_lazy(NON_SECURE);
 		cm_set_next_eret_context(NON_SECURE);
 
 		SMC_RET4(ns_cpu_context, x1, x2, x3, x4);
@@ -387,7 +387,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 * secure system register context since OPTEE was supposed
 		 * to preserve it during S-EL1 interrupt handling.
 		 */
-		cm_el1_sysregs_context_restore(NON_SECURE);
+		cm_el1_sysregs_context_restore_lazy(NON_SECURE);
 		cm_set_next_eret_context(NON_SECURE);
 
 		SMC_RET0((uint64_t) ns_cpu_context);
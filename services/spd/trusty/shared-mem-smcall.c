@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2020-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 #include <common/runtime_svc.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <lib/cassert.h>
 #include <lib/object_pool.h>
 #include <lib/spinlock.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
@@ -25,6 +26,41 @@
 #define TRUSTY_SHARED_MEMORY_OBJ_SIZE (512 * 1024)
 #endif
 
+/*
+ * The buffer is split in fixed-size slots, each holding one object with a
+ * small descriptor, followed by an overflow area where larger objects take a
+ * run of slot-sized blocks. Set TRUSTY_SHMEM_SLOT_SIZE and
+ * TRUSTY_SHMEM_OVERFLOW_SIZE in platform_def.h to tune the split.
+ */
+#ifndef TRUSTY_SHMEM_SLOT_SIZE
+#define TRUSTY_SHMEM_SLOT_SIZE 256
+#endif
+
+#ifndef TRUSTY_SHMEM_OVERFLOW_SIZE
+#define TRUSTY_SHMEM_OVERFLOW_SIZE (TRUSTY_SHARED_MEMORY_OBJ_SIZE / 4)
+#endif
+
+#define TRUSTY_SHMEM_OVERFLOW_BLOCKS \
+	(TRUSTY_SHMEM_OVERFLOW_SIZE / TRUSTY_SHMEM_SLOT_SIZE)
+#define TRUSTY_SHMEM_SLOT_COUNT \
+	((TRUSTY_SHARED_MEMORY_OBJ_SIZE - TRUSTY_SHMEM_OVERFLOW_SIZE) / \
+	 TRUSTY_SHMEM_SLOT_SIZE)
+#define TRUSTY_SHMEM_INDEX_COUNT \
+	(TRUSTY_SHMEM_SLOT_COUNT + TRUSTY_SHMEM_OVERFLOW_BLOCKS)
+
+/*
+ * Handles encode the index of the object in the low bits, and a generation
+ * number that is never reused in the high bits.
+ */
+#define TRUSTY_SHMEM_INDEX_BITS 16
+#define TRUSTY_SHMEM_INDEX_MASK ((UINT64_C(1) << TRUSTY_SHMEM_INDEX_BITS) - 1)
+#define TRUSTY_SHMEM_NO_SLOT UINT16_MAX
+
+CASSERT((TRUSTY_SHMEM_SLOT_SIZE % 8) == 0, assert_trusty_shmem_slot_align);
+CASSERT(TRUSTY_SHMEM_SLOT_COUNT > 0, assert_trusty_shmem_no_slot);
+CASSERT(TRUSTY_SHMEM_INDEX_COUNT < TRUSTY_SHMEM_NO_SLOT,
+	assert_trusty_shmem_too_many_slots);
+
 #pragma weak plat_mem_set_shared
 int plat_mem_set_shared(struct ffa_mtd *mtd, bool shared)
 {
@@ -56,20 +92,43 @@ struct trusty_shmem_obj {
 
 /**
  * struct trusty_shmem_obj_state - Global state.
- * @data:           Backing store for trusty_shmem_obj objects.
- * @allocated:      Number of bytes allocated in @data.
- * @next_handle:    Handle used for next allocated object.
- * @lock:           Lock protecting all state in this file.
+ * @data:           Backing store for trusty_shmem_obj objects, slots first,
+ *                  then the overflow area.
+ * @handles:        Handle of the object at each index, 0 if the index is free.
+ *                  Indices below %TRUSTY_SHMEM_SLOT_COUNT are slots, the
+ *                  following ones are blocks of the overflow area.
+ * @next_free:      Free list of slots, linked by index.
+ * @ovf_blocks:     Number of overflow blocks used by the object starting at
+ *                  each overflow block, 0 if no object starts there.
+ * @free_slot:      First slot of the free list, %TRUSTY_SHMEM_NO_SLOT if all
+ *                  slots are in use.
+ * @slots_ready:    %true once the free list has been built.
+ * @live:           Number of allocated objects.
+ * @next_gen:       Generation used in the handle of the next object.
+ * @obj_locks:      Lock of the object at each index. Protects the object
+ *                  while @lock is not held, see trusty_shmem_obj_get().
+ * @lock:           Lock protecting all state above. Held, with the lock of
+ *                  the object, to fill or free an object. Also serializes the
+ *                  dynamic mappings of the RX/TX buffers, as all clients share
+ *                  the translation context of BL31.
  */
 struct trusty_shmem_obj_state {
 	uint8_t *data;
-	size_t allocated;
-	uint64_t next_handle;
+	uint64_t *handles;
+	uint16_t *next_free;
+	uint16_t *ovf_blocks;
+	uint16_t free_slot;
+	bool slots_ready;
+	size_t live;
+	uint64_t next_gen;
+	struct spinlock *obj_locks;
 	struct spinlock lock;
 };
 
 /**
  * struct trusty_shmem_client_state - Per client state.
+ * @lock:               Lock protecting this client's state and buffers. Taken
+ *                      before &trusty_shmem_obj_state.lock.
  * @tx_buf:             Client's transmit buffer.
  * @rx_buf:             Client's receive buffer.
  * @buf_size:           Size of @tx_buf and @rx_buf.
@@ -84,6 +143,7 @@ struct trusty_shmem_obj_state {
  *                      in the memory_region_attributes of the ffa_mtd.
  */
 struct trusty_shmem_client_state {
+	struct spinlock lock;
 	const void *tx_buf;
 	void *rx_buf;
 	size_t buf_size;
@@ -100,11 +160,19 @@ struct trusty_shmem_client_state {
 __section(".bss.trusty.shmem.objs_data")
 __aligned(8) static uint8_t
 	trusty_shmem_objs_data[TRUSTY_SHARED_MEMORY_OBJ_SIZE];
+static uint64_t trusty_shmem_handles[TRUSTY_SHMEM_INDEX_COUNT];
+static uint16_t trusty_shmem_next_free[TRUSTY_SHMEM_SLOT_COUNT];
+static uint16_t trusty_shmem_ovf_blocks[TRUSTY_SHMEM_OVERFLOW_BLOCKS];
+static struct spinlock trusty_shmem_obj_locks[TRUSTY_SHMEM_INDEX_COUNT];
 static struct trusty_shmem_obj_state trusty_shmem_obj_state = {
 	/* initializing data this way keeps the bulk of the state in .bss */
 	.data = trusty_shmem_objs_data,
+	.handles = trusty_shmem_handles,
+	.next_free = trusty_shmem_next_free,
+	.ovf_blocks = trusty_shmem_ovf_blocks,
+	.obj_locks = trusty_shmem_obj_locks,
 	/* Set start value for handle so top 32 bits are needed quickly */
-	.next_handle = 0xffffffc0,
+	.next_gen = 0xffc0,
 };
 
 static struct trusty_shmem_client_state trusty_shmem_client_state[2] = {
@@ -127,12 +195,88 @@ static size_t trusty_shmem_obj_size(size_t desc_size)
 	return desc_size + offsetof(struct trusty_shmem_obj, desc);
 }
 
+/**
+ * trusty_shmem_obj_at - Get the object stored at an index.
+ * @state:      Global state.
+ * @index:      Slot index, or %TRUSTY_SHMEM_SLOT_COUNT + overflow block index.
+ *
+ * Return: Pointer to the storage of the object at @index.
+ */
+static struct trusty_shmem_obj *
+trusty_shmem_obj_at(struct trusty_shmem_obj_state *state, size_t index)
+{
+	return (struct trusty_shmem_obj *)(state->data +
+					   index * TRUSTY_SHMEM_SLOT_SIZE);
+}
+
+/**
+ * trusty_shmem_obj_index - Get the index of an allocated object.
+ * @state:      Global state.
+ * @obj:        Object allocated by trusty_shmem_obj_alloc().
+ *
+ * Return: Index of @obj, see trusty_shmem_obj_at().
+ */
+static size_t trusty_shmem_obj_index(struct trusty_shmem_obj_state *state,
+				     struct trusty_shmem_obj *obj)
+{
+	return ((uint8_t *)obj - state->data) / TRUSTY_SHMEM_SLOT_SIZE;
+}
+
+/**
+ * trusty_shmem_obj_lock - Get the lock of an allocated object.
+ * @state:      Global state.
+ * @obj:        Object allocated by trusty_shmem_obj_alloc().
+ *
+ * Return: Lock of @obj.
+ */
+static struct spinlock *
+trusty_shmem_obj_lock(struct trusty_shmem_obj_state *state,
+		      struct trusty_shmem_obj *obj)
+{
+	return &state->obj_locks[trusty_shmem_obj_index(state, obj)];
+}
+
+/**
+ * trusty_shmem_ovf_alloc - Allocate a run of overflow blocks.
+ * @state:      Global state.
+ * @blocks:     Number of blocks needed.
+ *
+ * Large descriptors are rare, so a first-fit search is good enough here.
+ *
+ * Return: Index of the first block in the overflow area, or
+ *         %TRUSTY_SHMEM_NO_SLOT if there is no free run long enough.
+ */
+static size_t trusty_shmem_ovf_alloc(struct trusty_shmem_obj_state *state,
+				     size_t blocks)
+{
+	size_t block = 0;
+	size_t run_start = 0;
+
+	while (block < TRUSTY_SHMEM_OVERFLOW_BLOCKS) {
+		if (state->ovf_blocks[block]) {
+			block += state->ovf_blocks[block];
+			run_start = block;
+			continue;
+		}
+		block++;
+		if (block - run_start == blocks) {
+			state->ovf_blocks[run_start] = blocks;
+			return run_start;
+		}
+	}
+	return TRUSTY_SHMEM_NO_SLOT;
+}
+
 /**
  * trusty_shmem_obj_alloc - Allocate struct trusty_shmem_obj.
  * @state:      Global state.
  * @desc_size:  Size of struct ffa_memory_region_descriptor object that
  *              allocated object will hold.
  *
+ * Objects that fit in a slot are taken from the slot free list, larger ones
+ * (or all of them once the slots are exhausted) from the overflow area. The
+ * object is given a new handle, which stays valid until the object is freed.
+ *
  * Return: Pointer to newly allocated object, or %NULL if there not enough space
  *         left. The returned pointer is only valid while @state is locked, to
  *         used it again after unlocking @state, trusty_shmem_obj_lookup must be
@@ -142,44 +286,82 @@ static struct trusty_shmem_obj *
 trusty_shmem_obj_alloc(struct trusty_shmem_obj_state *state, size_t desc_size)
 {
 	struct trusty_shmem_obj *obj;
-	size_t free = sizeof(trusty_shmem_objs_data) - state->allocated;
-	if (trusty_shmem_obj_size(desc_size) > free) {
-		NOTICE("%s(0x%zx) failed, free 0x%zx\n",
-		       __func__, desc_size, free);
+	size_t obj_size = trusty_shmem_obj_size(desc_size);
+	size_t blocks = (obj_size + TRUSTY_SHMEM_SLOT_SIZE - 1) /
+			TRUSTY_SHMEM_SLOT_SIZE;
+	size_t index = TRUSTY_SHMEM_NO_SLOT;
+
+	if (!state->slots_ready) {
+		for (size_t i = 0; i < TRUSTY_SHMEM_SLOT_COUNT; i++) {
+			state->next_free[i] = (i + 1 < TRUSTY_SHMEM_SLOT_COUNT) ?
+					      i + 1 : TRUSTY_SHMEM_NO_SLOT;
+		}
+		state->free_slot = 0;
+		state->slots_ready = true;
+	}
+
+	if (blocks == 1 && state->free_slot != TRUSTY_SHMEM_NO_SLOT) {
+		index = state->free_slot;
+		state->free_slot = state->next_free[index];
+	} else if (blocks <= TRUSTY_SHMEM_OVERFLOW_BLOCKS) {
+		index = trusty_shmem_ovf_alloc(state, blocks);
+		if (index != TRUSTY_SHMEM_NO_SLOT) {
+			index += TRUSTY_SHMEM_SLOT_COUNT;
+		}
+	}
+	if (index == TRUSTY_SHMEM_NO_SLOT) {
+		NOTICE("%s(0x%zx) failed, %zu objects live\n",
+		       __func__, desc_size, state->live);
 		return NULL;
 	}
-	obj = (struct trusty_shmem_obj *)(state->data + state->allocated);
+
+	state->handles[index] = (state->next_gen++ << TRUSTY_SHMEM_INDEX_BITS) |
+				index;
+	state->live++;
+
+	obj = trusty_shmem_obj_at(state, index);
 	obj->desc_size = desc_size;
 	obj->desc_filled = 0;
 	obj->in_use = 0;
-	state->allocated += trusty_shmem_obj_size(desc_size);
 	return obj;
 }
 
+/**
+ * trusty_shmem_obj_handle - Get the handle of an allocated object.
+ * @state:      Global state.
+ * @obj:        Object allocated by trusty_shmem_obj_alloc().
+ *
+ * Return: Handle of @obj.
+ */
+static uint64_t trusty_shmem_obj_handle(struct trusty_shmem_obj_state *state,
+					struct trusty_shmem_obj *obj)
+{
+	return state->handles[trusty_shmem_obj_index(state, obj)];
+}
+
 /**
  * trusty_shmem_obj_free - Free struct trusty_shmem_obj.
  * @state:      Global state.
  * @obj:        Object to free.
  *
- * Release memory used by @obj. Other objects may move, so on return all
- * pointers to struct trusty_shmem_obj object should be considered invalid, not
- * just @obj.
- *
- * The current implementation always compacts the remaining objects to simplify
- * the allocator and to avoid fragmentation.
+ * Release memory used by @obj and invalidate its handle. Other objects do not
+ * move. The caller holds @state->lock and the lock of @obj.
  */
-
 static void trusty_shmem_obj_free(struct trusty_shmem_obj_state *state,
 				  struct trusty_shmem_obj *obj)
 {
-	size_t free_size = trusty_shmem_obj_size(obj->desc_size);
-	uint8_t *shift_dest = (uint8_t *)obj;
-	uint8_t *shift_src = shift_dest + free_size;
-	size_t shift_size = state->allocated - (shift_src - state->data);
-	if (shift_size) {
-		memmove(shift_dest, shift_src, shift_size);
-	}
-	state->allocated -= free_size;
+	size_t index = trusty_shmem_obj_index(state, obj);
+
+	assert(state->handles[index]);
+	state->handles[index] = 0;
+	state->live--;
+
+	if (index < TRUSTY_SHMEM_SLOT_COUNT) {
+		state->next_free[index] = state->free_slot;
+		state->free_slot = index;
+	} else {
+		state->ovf_blocks[index - TRUSTY_SHMEM_SLOT_COUNT] = 0;
+	}
 }
 
 /**
@@ -193,15 +375,53 @@ static void trusty_shmem_obj_free(struct trusty_shmem_obj_state *state,
 static struct trusty_shmem_obj *
 trusty_shmem_obj_lookup(struct trusty_shmem_obj_state *state, uint64_t handle)
 {
-	uint8_t *curr = state->data;
-	while (curr - state->data < state->allocated) {
-		struct trusty_shmem_obj *obj = (struct trusty_shmem_obj *)curr;
-		if (obj->desc.handle == handle) {
-			return obj;
-		}
-		curr += trusty_shmem_obj_size(obj->desc_size);
+	size_t index = handle & TRUSTY_SHMEM_INDEX_MASK;
+
+	if (!handle || index >= TRUSTY_SHMEM_INDEX_COUNT ||
+	    state->handles[index] != handle) {
+		return NULL;
+	}
+	return trusty_shmem_obj_at(state, index);
+}
+
+/**
+ * trusty_shmem_obj_get - Lookup and lock struct trusty_shmem_obj by handle.
+ * @state:      Global state.
+ * @handle:     Unique handle of object to return.
+ *
+ * Used by the calls that only read an object or update its @in_use count.
+ * @state->lock is only held for the lookup, the object stays locked by its own
+ * lock instead, so that these calls do not serialize with the calls on other
+ * objects. The object is not filled or freed until trusty_shmem_obj_put() is
+ * called, as that needs its lock as well.
+ *
+ * Return: Locked object with handle matching @handle, or %NULL if no object in
+ *         @state->data has a matching handle.
+ */
+static struct trusty_shmem_obj *
+trusty_shmem_obj_get(struct trusty_shmem_obj_state *state, uint64_t handle)
+{
+	struct trusty_shmem_obj *obj;
+
+	spin_lock(&state->lock);
+	obj = trusty_shmem_obj_lookup(state, handle);
+	if (obj) {
+		spin_lock(trusty_shmem_obj_lock(state, obj));
 	}
-	return NULL;
+	spin_unlock(&state->lock);
+
+	return obj;
+}
+
+/**
+ * trusty_shmem_obj_put - Unlock an object returned by trusty_shmem_obj_get().
+ * @state:      Global state.
+ * @obj:        Object to unlock.
+ */
+static void trusty_shmem_obj_put(struct trusty_shmem_obj_state *state,
+				 struct trusty_shmem_obj *obj)
+{
+	spin_unlock(trusty_shmem_obj_lock(state, obj));
 }
 
 static struct ffa_comp_mrd *
@@ -311,8 +531,13 @@ static long trusty_ffa_fill_desc(struct trusty_shmem_client_state *client,
 				 ffa_mtd_flag32_t mtd_flags,
 				 void *smc_handle)
 {
+	struct spinlock *obj_lock = trusty_shmem_obj_lock(&trusty_shmem_obj_state,
+							  obj);
 	int ret;
 
+	/* Keep the calls holding only the object lock out while it changes */
+	spin_lock(obj_lock);
+
 	if (!client->buf_size) {
 		NOTICE("%s: buffer pair not registered\n", __func__);
 		ret = -EINVAL;
@@ -338,7 +563,8 @@ static long trusty_ffa_fill_desc(struct trusty_shmem_client_state *client,
 
 	if (!obj->desc_filled) {
 		/* First fragment, descriptor header has been copied */
-		obj->desc.handle = trusty_shmem_obj_state.next_handle++;
+		obj->desc.handle = trusty_shmem_obj_handle(
+			&trusty_shmem_obj_state, obj);
 		obj->desc.flags = mtd_flags;
 		obj->desc.memory_region_attributes |= FFA_MEM_ATTR_NONSECURE;
 	}
@@ -353,6 +579,7 @@ static long trusty_ffa_fill_desc(struct trusty_shmem_client_state *client,
 	uint32_t handle_low = (uint32_t)obj->desc.handle;
 	uint32_t handle_high = obj->desc.handle >> 32;
 	if (obj->desc_filled != obj->desc_size) {
+		spin_unlock(obj_lock);
 		SMC_RET8(smc_handle, SMC_FC_FFA_MEM_FRAG_RX, handle_low,
 			 handle_high, obj->desc_filled,
 			 (uint32_t)obj->desc.sender_id << 16, 0, 0, 0);
@@ -363,6 +590,7 @@ static long trusty_ffa_fill_desc(struct trusty_shmem_client_state *client,
 		goto err_share_fail;
 	}
 
+	spin_unlock(obj_lock);
 	SMC_RET8(smc_handle, SMC_FC_FFA_SUCCESS, 0, handle_low, handle_high, 0,
 		 0, 0, 0);
 
@@ -370,6 +598,7 @@ err_share_fail:
 err_bad_desc:
 err_arg:
 	trusty_shmem_obj_free(&trusty_shmem_obj_state, obj);
+	spin_unlock(obj_lock);
 	return ret;
 }
 
@@ -506,6 +735,8 @@ trusty_ffa_mem_retrieve_req(struct trusty_shmem_client_state *client,
 	struct trusty_shmem_obj *obj = NULL;
 	const struct ffa_mtd *req = client->tx_buf;
 	struct ffa_mtd *resp = client->rx_buf;
+	size_t desc_size;
+	long ret;
 
 	if (!client->buf_size) {
 		NOTICE("%s: buffer pair not registered\n", __func__);
@@ -536,7 +767,7 @@ trusty_ffa_mem_retrieve_req(struct trusty_shmem_client_state *client,
 		return -EINVAL;
 	}
 
-	obj = trusty_shmem_obj_lookup(&trusty_shmem_obj_state, req->handle);
+	obj = trusty_shmem_obj_get(&trusty_shmem_obj_state, req->handle);
 	if (!obj) {
 		return -ENOENT;
 	}
@@ -544,19 +775,22 @@ trusty_ffa_mem_retrieve_req(struct trusty_shmem_client_state *client,
 	if (obj->desc_filled != obj->desc_size) {
 		NOTICE("%s: incomplete object desc filled %zu < size %zu\n",
 		       __func__, obj->desc_filled, obj->desc_size);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto err_put;
 	}
 
 	if (req->emad_count && req->sender_id != obj->desc.sender_id) {
 		NOTICE("%s: wrong sender id 0x%x != 0x%x\n",
 		       __func__, req->sender_id, obj->desc.sender_id);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto err_put;
 	}
 
 	if (req->emad_count && req->tag != obj->desc.tag) {
 		NOTICE("%s: wrong tag 0x%" PRIx64 " != 0x%" PRIx64 "\n",
 		       __func__, req->tag, obj->desc.tag);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto err_put;
 	}
 
 	if (req->flags != 0 && req->flags != obj->desc.flags) {
@@ -567,7 +801,8 @@ trusty_ffa_mem_retrieve_req(struct trusty_shmem_client_state *client,
 		 * FFA_MTD_FLAG_TYPE_LEND_MEMORY.
 		 */
 		NOTICE("%s: invalid flags 0x%x\n", __func__, req->flags);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto err_put;
 	}
 
 	/* TODO: support more than one endpoint ids */
@@ -577,7 +812,8 @@ trusty_ffa_mem_retrieve_req(struct trusty_shmem_client_state *client,
 		NOTICE("%s: wrong receiver id 0x%x != 0x%x\n",
 		       __func__, req->emad[0].mapd.endpoint_id,
 		       obj->desc.emad[0].mapd.endpoint_id);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto err_put;
 	}
 
 	if (req->emad_count) {
@@ -593,8 +829,15 @@ trusty_ffa_mem_retrieve_req(struct trusty_shmem_client_state *client,
 		resp->memory_region_attributes &= ~FFA_MEM_ATTR_NONSECURE;
 	}
 
-	SMC_RET8(smc_handle, SMC_FC_FFA_MEM_RETRIEVE_RESP, obj->desc_size,
+	desc_size = obj->desc_size;
+	trusty_shmem_obj_put(&trusty_shmem_obj_state, obj);
+
+	SMC_RET8(smc_handle, SMC_FC_FFA_MEM_RETRIEVE_RESP, desc_size,
 		 copy_size, 0, 0, 0, 0, 0);
+
+err_put:
+	trusty_shmem_obj_put(&trusty_shmem_obj_state, obj);
+	return ret;
 }
 
 /**
@@ -619,6 +862,7 @@ static long trusty_ffa_mem_frag_rx(struct trusty_shmem_client_state *client,
 {
 	struct trusty_shmem_obj *obj;
 	uint64_t handle = handle_low | (((uint64_t)handle_high) << 32);
+	long ret;
 
 	if (!client->buf_size) {
 		NOTICE("%s: buffer pair not registered\n", __func__);
@@ -631,7 +875,7 @@ static long trusty_ffa_mem_frag_rx(struct trusty_shmem_client_state *client,
 		return -EINVAL;
 	}
 
-	obj = trusty_shmem_obj_lookup(&trusty_shmem_obj_state, handle);
+	obj = trusty_shmem_obj_get(&trusty_shmem_obj_state, handle);
 	if (!obj) {
 		NOTICE("%s: invalid handle, 0x%" PRIx64
 		       ", not a valid handle\n", __func__, handle);
@@ -642,13 +886,15 @@ static long trusty_ffa_mem_frag_rx(struct trusty_shmem_client_state *client,
 	    sender_id != (uint32_t)obj->desc.sender_id << 16) {
 		NOTICE("%s: invalid sender_id 0x%x != 0x%x\n", __func__,
 		       sender_id, (uint32_t)obj->desc.sender_id << 16);
-		return -ENOENT;
+		ret = -ENOENT;
+		goto err_put;
 	}
 
 	if (fragment_offset >= obj->desc_size) {
 		NOTICE("%s: invalid fragment_offset 0x%x >= 0x%zx\n",
 		       __func__, fragment_offset, obj->desc_size);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto err_put;
 	}
 
 	size_t full_copy_size = obj->desc_size - fragment_offset;
@@ -658,8 +904,14 @@ static long trusty_ffa_mem_frag_rx(struct trusty_shmem_client_state *client,
 
 	memcpy(client->rx_buf, src + fragment_offset, copy_size);
 
+	trusty_shmem_obj_put(&trusty_shmem_obj_state, obj);
+
 	SMC_RET8(smc_handle, SMC_FC_FFA_MEM_FRAG_TX, handle_low, handle_high,
 		 copy_size, sender_id, 0, 0, 0);
+
+err_put:
+	trusty_shmem_obj_put(&trusty_shmem_obj_state, obj);
+	return ret;
 }
 
 /**
@@ -677,6 +929,7 @@ static int trusty_ffa_mem_relinquish(struct trusty_shmem_client_state *client)
 {
 	struct trusty_shmem_obj *obj;
 	const struct ffa_mem_relinquish_descriptor *req = client->tx_buf;
+	int ret = 0;
 
 	if (!client->buf_size) {
 		NOTICE("%s: buffer pair not registered\n", __func__);
@@ -693,25 +946,30 @@ static int trusty_ffa_mem_relinquish(struct trusty_shmem_client_state *client)
 		return -EINVAL;
 	}
 
-	obj = trusty_shmem_obj_lookup(&trusty_shmem_obj_state, req->handle);
+	obj = trusty_shmem_obj_get(&trusty_shmem_obj_state, req->handle);
 	if (!obj) {
 		return -ENOENT;
 	}
 
 	if (obj->desc.emad_count != req->endpoint_count) {
-		return -EINVAL;
+		ret = -EINVAL;
+		goto out;
 	}
 	for (size_t i = 0; i < req->endpoint_count; i++) {
 		if (req->endpoint_array[i] !=
 		    obj->desc.emad[i].mapd.endpoint_id) {
-			return -EINVAL;
+			ret = -EINVAL;
+			goto out;
 		}
 	}
 	if (!obj->in_use) {
-		return -EACCES;
+		ret = -EACCES;
+		goto out;
 	}
 	obj->in_use--;
-	return 0;
+out:
+	trusty_shmem_obj_put(&trusty_shmem_obj_state, obj);
+	return ret;
 }
 
 /**
@@ -732,6 +990,7 @@ static int trusty_ffa_mem_reclaim(struct trusty_shmem_client_state *client,
 {
 	int ret;
 	struct trusty_shmem_obj *obj;
+	struct spinlock *obj_lock;
 	uint64_t handle = handle_low | (((uint64_t)handle_high) << 32);
 
 	if (client->receiver) {
@@ -748,18 +1007,24 @@ static int trusty_ffa_mem_reclaim(struct trusty_shmem_client_state *client,
 	if (!obj) {
 		return -ENOENT;
 	}
+
+	/* Wait for the calls that got the object before it was looked up */
+	obj_lock = trusty_shmem_obj_lock(&trusty_shmem_obj_state, obj);
+	spin_lock(obj_lock);
 	if (obj->in_use) {
-		return -EACCES;
+		ret = -EACCES;
+		goto out;
 	}
 
 	ret = plat_mem_set_shared(&obj->desc, false);
 	if (ret) {
-		return ret;
+		goto out;
 	}
 
 	trusty_shmem_obj_free(&trusty_shmem_obj_state, obj);
-
-	return 0;
+out:
+	spin_unlock(obj_lock);
+	return ret;
 }
 
 /**
@@ -850,6 +1115,8 @@ static long trusty_ffa_rxtx_unmap(struct trusty_shmem_client_state *client,
 	}
 
 	if (!client->identity_mapped) {
+		/* Invalidate the TLB entries of both buffers at once */
+		xlat_batch_begin();
 		ret = mmap_remove_dynamic_region((uintptr_t)client->tx_buf,
 						 client->buf_size);
 		if (ret) {
@@ -862,8 +1129,9 @@ static long trusty_ffa_rxtx_unmap(struct trusty_shmem_client_state *client,
 			NOTICE("%s: failed to unmap rx buffer @ %p, size 0x%zx\n",
 			       __func__, client->rx_buf, client->buf_size);
 		}
+		xlat_batch_end();
 	}
-	if (trusty_shmem_obj_state.allocated) {
+	if (trusty_shmem_obj_state.live) {
 		WARN("%s: shared memory regions are still active\n", __func__);
 	}
 
@@ -1010,6 +1278,34 @@ static int to_spi_err(long ret)
 	}
 }
 
+/**
+ * trusty_ffa_accesses_objs - Check if a call uses the shared memory objects.
+ * @smc_fid:    FF-A function id.
+ *
+ * Return: %true if the call needs &trusty_shmem_obj_state.lock, %false if it
+ *         only touches the state of the calling client. The calls that map
+ *         or unmap buffers need it as well, for the translation context. The
+ *         calls that only read an object or update its in_use count take the
+ *         lock themselves, just for the lookup, see trusty_shmem_obj_get().
+ */
+static bool trusty_ffa_accesses_objs(uint32_t smc_fid)
+{
+	switch (smc_fid) {
+	case SMC_FC_FFA_RXTX_MAP:
+	case SMC_FC64_FFA_RXTX_MAP:
+	case SMC_FC_FFA_RXTX_UNMAP:
+	case SMC_FC_FFA_MEM_LEND:
+	case SMC_FC64_FFA_MEM_LEND:
+	case SMC_FC_FFA_MEM_SHARE:
+	case SMC_FC64_FFA_MEM_SHARE:
+	case SMC_FC_FFA_MEM_RECLAIM:
+	case SMC_FC_FFA_MEM_FRAG_TX:
+		return true;
+	default:
+		return false;
+	}
+}
+
 /*
  * trusty_shared_memory_smc - SMC call handler.
  */
@@ -1036,6 +1332,7 @@ uintptr_t spmd_smc_handler(uint32_t smc_fid,
 	u_register_t ret_reg3 = 0;
 	struct trusty_shmem_client_state *client = &trusty_shmem_client_state[
 		is_caller_secure(flags)];
+	bool obj_access = trusty_ffa_accesses_objs(smc_fid);
 
 	if (((smc_fid < SMC_FC32_FFA_MIN) || (smc_fid > SMC_FC32_FFA_MAX)) &&
 	    ((smc_fid < SMC_FC64_FFA_MIN) || (smc_fid > SMC_FC64_FFA_MAX))) {
@@ -1043,7 +1340,10 @@ uintptr_t spmd_smc_handler(uint32_t smc_fid,
 		SMC_RET1(handle, SMC_UNK);
 	}
 
-	spin_lock(&trusty_shmem_obj_state.lock);
+	spin_lock(&client->lock);
+	if (obj_access) {
+		spin_lock(&trusty_shmem_obj_state.lock);
+	}
 
 	switch (smc_fid) {
 	case SMC_FC_FFA_VERSION:
@@ -1126,7 +1426,10 @@ uintptr_t spmd_smc_handler(uint32_t smc_fid,
 		ret = -ENOTSUP;
 		break;
 	}
-	spin_unlock(&trusty_shmem_obj_state.lock);
+	if (obj_access) {
+		spin_unlock(&trusty_shmem_obj_state.lock);
+	}
+	spin_unlock(&client->lock);
 
 	if (ret) {
 		if (ret == (int64_t)handle) {
@@ -122,14 +122,14 @@ static struct smc_args trusty_context_switch(uint32_t security_state, uint64_t r
 	 */
 	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
 		fpregs_context_save(get_fpregs_ctx(cm_get_context(security_state)));
-	cm_el1_sysregs_context_save(security_state);
+	cm_el1_sysregs_context_save_lazy(security_state);
 
 	ctx->saved_security_state = security_state;
 	ret_args = trusty_context_switch_helper(&ctx->saved_sp, &args);
 
 	assert(ctx->saved_security_state == ((security_state == 0U) ? 1U : 0U));
 
-	cm_el1_sysregs_context_restore(security_state);
+	cm_el1_sysregs_context_restore_lazy(security_state);
 	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
 		fpregs_context_restore(get_fpregs_ctx(cm_get_context(security_state)));
 
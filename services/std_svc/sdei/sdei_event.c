@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,11 +7,34 @@
 #include <assert.h>
 
 #include <lib/utils.h>
+#include <lib/utils_def.h>
 
 #include "sdei_private.h"
 
 #define MAP_OFF(_map, _mapping) ((_map) - (_mapping)->map)
 
+/* Marker of the interrupt hash table slots whose mapping was removed */
+static sdei_ev_map_t sdei_hash_removed;
+
+/* Serialises the updates of the interrupt hash table */
+static spinlock_t sdei_intr_hash_lock;
+
+/*
+ * Hash tables slot of an event number or interrupt. The tables use open
+ * addressing with linear probing, and have a power of two number of slots.
+ */
+static inline unsigned int sdei_hash(uint32_t key)
+{
+	uint32_t h = key * 0x9e3779b1U;
+
+	return (h ^ (h >> 16)) & (sdei_hash_size - 1U);
+}
+
+static inline unsigned int sdei_hash_next(unsigned int slot)
+{
+	return (slot + 1U) & (sdei_hash_size - 1U);
+}
+
 /*
  * Get SDEI entry with the given mapping: on success, returns pointer to SDEI
  * entry. On error, returns NULL.
@@ -59,17 +82,39 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 {
 	const sdei_mapping_t *mapping;
 	sdei_ev_map_t *map;
-	unsigned int i;
+	unsigned int i, slot;
+
+	/*
+	 * Free dynamic mappings aren't in the hash table. Looking one up only
+	 * happens on interrupt bind, so a linear search is fine.
+	 */
+	if (intr_num == SDEI_DYN_IRQ) {
+		mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
+		iterate_mapping(mapping, i, map) {
+			if (is_map_dynamic(map) && (map->intr == SDEI_DYN_IRQ))
+				return map;
+		}
+
+		return NULL;
+	}
 
 	/*
-	 * Look for a match in private and shared mappings, as requested. This
-	 * is a linear search. However, if the mappings are required to be
-	 * sorted, for large maps, we could consider binary search.
+	 * The table is read without lock: a mapping being added or removed
+	 * may or may not be found, which is also the case with the lock. The
+	 * interrupt of each candidate mapping is checked, as it can be
+	 * released meanwhile.
 	 */
-	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
-	iterate_mapping(mapping, i, map) {
-		if (map->intr == intr_num)
+	slot = sdei_hash(intr_num);
+	for (i = 0U; i < sdei_hash_size; i++) {
+		map = sdei_intr_hash[slot];
+		if (map == NULL)
+			break;
+
+		if ((map != &sdei_hash_removed) && (map->intr == intr_num) &&
+		    (is_event_shared(map) == shared))
 			return map;
+
+		slot = sdei_hash_next(slot);
 	}
 
 	return NULL;
@@ -81,21 +126,133 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
  */
 sdei_ev_map_t *find_event_map(int ev_num)
 {
-	const sdei_mapping_t *mapping;
 	sdei_ev_map_t *map;
-	unsigned int i, j;
+	unsigned int i, slot;
+
+	slot = sdei_hash((uint32_t) ev_num);
+	for (i = 0U; i < sdei_hash_size; i++) {
+		map = sdei_event_hash[slot];
+		if (map == NULL)
+			break;
+
+		if (map->ev_num == ev_num)
+			return map;
+
+		slot = sdei_hash_next(slot);
+	}
+
+	return NULL;
+}
+
+/* Add a mapping bound to an interrupt to the interrupt hash table */
+void sdei_intr_hash_add(sdei_ev_map_t *map)
+{
+	unsigned int i, slot;
+
+	assert(map->intr != SDEI_DYN_IRQ);
+
+	spin_lock(&sdei_intr_hash_lock);
+
+	slot = sdei_hash(map->intr);
+	for (i = 0U; i < sdei_hash_size; i++) {
+		if ((sdei_intr_hash[slot] == NULL) ||
+		    (sdei_intr_hash[slot] == &sdei_hash_removed))
+			break;
+
+		slot = sdei_hash_next(slot);
+	}
+
+	/* The table is never more than half full */
+	assert(i < sdei_hash_size);
+
+	/* Publish the interrupt of the mapping before the mapping itself */
+	dmbish();
+	sdei_intr_hash[slot] = map;
+
+	spin_unlock(&sdei_intr_hash_lock);
+}
+
+/* Remove a mapping from the interrupt hash table, before it's released */
+void sdei_intr_hash_remove(sdei_ev_map_t *map)
+{
+	unsigned int i, slot;
+
+	spin_lock(&sdei_intr_hash_lock);
+
+	slot = sdei_hash(map->intr);
+	for (i = 0U; i < sdei_hash_size; i++) {
+		assert(sdei_intr_hash[slot] != NULL);
+		if (sdei_intr_hash[slot] == map)
+			break;
+
+		slot = sdei_hash_next(slot);
+	}
+
+	assert(i < sdei_hash_size);
 
 	/*
-	 * Iterate through mappings to find a match. This is a linear search.
-	 * However, if the mappings are required to be sorted, for large maps,
-	 * we could consider binary search.
+	 * The slot can only be emptied when the next one is empty, otherwise
+	 * the mappings after it couldn't be found anymore: mark it as removed.
 	 */
+	if (sdei_intr_hash[sdei_hash_next(slot)] == NULL)
+		sdei_intr_hash[slot] = NULL;
+	else
+		sdei_intr_hash[slot] = &sdei_hash_removed;
+
+	spin_unlock(&sdei_intr_hash_lock);
+}
+
+/* Sort the mappings in the increasing order of event number */
+static void sort_mapping(const sdei_mapping_t *mapping)
+{
+	sdei_ev_map_t tmp;
+	unsigned int i, j;
+
+	/* Insertion sort: there are few mappings, usually already sorted */
+	for (i = 1U; i < mapping->num_maps; i++) {
+		tmp = mapping->map[i];
+		for (j = i; j > 0U; j--) {
+			if (mapping->map[j - 1U].ev_num <= tmp.ev_num)
+				break;
+
+			mapping->map[j] = mapping->map[j - 1U];
+		}
+		mapping->map[j] = tmp;
+	}
+}
+
+/*
+ * Sort the platform mappings and build the hash tables used to look them up.
+ * This must be called before any event entry is used, as sorting changes the
+ * index of the mappings.
+ */
+void sdei_init_maps(void)
+{
+	const sdei_mapping_t *mapping;
+	sdei_ev_map_t *map;
+	unsigned int i, j, slot;
+
+	assert(IS_POWER_OF_TWO(sdei_hash_size));
+
 	for_each_mapping_type(i, mapping) {
+		sort_mapping(mapping);
+
 		iterate_mapping(mapping, j, map) {
-			if (map->ev_num == ev_num)
-				return map;
+			slot = sdei_hash((uint32_t) map->ev_num);
+			while (sdei_event_hash[slot] != NULL) {
+				/* Event numbers must be unique */
+				assert(sdei_event_hash[slot]->ev_num !=
+						map->ev_num);
+				slot = sdei_hash_next(slot);
+			}
+			sdei_event_hash[slot] = map;
+
+			/*
+			 * Statically bound mappings are added to the interrupt
+			 * table, dynamic ones when they're bound.
+			 */
+			if (!is_map_dynamic(map) && !is_map_explicit(map))
+				sdei_intr_hash_add(map);
 		}
 	}
-
-	return NULL;
 }
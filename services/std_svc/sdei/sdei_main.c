@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -108,7 +108,7 @@ static void sdei_class_init(sdei_class_t class)
 	ev_num_so_far = -1;
 	for_each_shared_map(i, map) {
 #if ENABLE_ASSERTIONS
-		/* Ensure mappings are sorted */
+		/* Ensure mappings are sorted, with no duplicate event */
 		assert((ev_num_so_far < 0) || (map->ev_num > ev_num_so_far));
 
 		ev_num_so_far = map->ev_num;
@@ -151,7 +151,7 @@ static void sdei_class_init(sdei_class_t class)
 	ev_num_so_far = -1;
 	for_each_private_map(i, map) {
 #if ENABLE_ASSERTIONS
-		/* Ensure mappings are sorted */
+		/* Ensure mappings are sorted, with no duplicate event */
 		assert((ev_num_so_far < 0) || (map->ev_num > ev_num_so_far));
 
 		ev_num_so_far = map->ev_num;
@@ -229,6 +229,7 @@ static void sdei_class_init(sdei_class_t class)
 void sdei_init(void)
 {
 	plat_sdei_setup();
+	sdei_init_maps();
 	sdei_class_init(SDEI_CRITICAL);
 	sdei_class_init(SDEI_NORMAL);
 
@@ -766,6 +767,7 @@ static int sdei_interrupt_bind(unsigned int intr_num)
 		if (!is_map_bound(map)) {
 			map->intr = intr_num;
 			set_map_bound(map);
+			sdei_intr_hash_add(map);
 			retry = false;
 		}
 		sdei_map_unlock(map);
@@ -823,6 +825,7 @@ static int sdei_interrupt_release(int ev_num)
 		 * during unregister.
 		 */
 
+		sdei_intr_hash_remove(map);
 		map->intr = SDEI_DYN_IRQ;
 		clr_map_bound(map);
 	} else {
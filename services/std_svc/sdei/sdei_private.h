@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -227,11 +227,17 @@ static inline void sdei_map_unlock(sdei_ev_map_t *map)
 extern const sdei_mapping_t sdei_global_mappings[];
 extern sdei_entry_t sdei_private_event_table[];
 extern sdei_entry_t sdei_shared_event_table[];
+extern sdei_ev_map_t *sdei_event_hash[];
+extern sdei_ev_map_t *sdei_intr_hash[];
+extern const unsigned int sdei_hash_size;
 
 void init_sdei_state(void);
 
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared);
 sdei_ev_map_t *find_event_map(int ev_num);
+void sdei_init_maps(void);
+void sdei_intr_hash_add(sdei_ev_map_t *map);
+void sdei_intr_hash_remove(sdei_ev_map_t *map);
 sdei_entry_t *get_event_entry(sdei_ev_map_t *map);
 
 int64_t sdei_event_context(void *handle, unsigned int param);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, ARM Limited. All rights reserved.
+ * Copyright (c) 2021-2022, ARM Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,78 +7,108 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stdint.h>
+
+#include <platform_def.h>
+
 #include <lib/spinlock.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
 #include <plat/common/plat_trng.h>
+#include <plat/common/platform.h>
 
 /*
  * # Entropy pool
  * Note that the TRNG Firmware interface can request up to 192 bits of entropy
- * in a single call or three 64bit words per call. We have 4 words in the pool
- * so that when we have 1-63 bits in the pool, and we have a request for
- * 192 bits of entropy, we don't have to throw out the leftover 1-63 bits of
- * entropy.
+ * in a single call or three 64bit words per call. A pool has room for more
+ * than two such requests, so that when we have 1-63 bits in the pool, and we
+ * have a request for 192 bits of entropy, we don't have to throw out the
+ * leftover 1-63 bits of entropy.
+ *
+ * Each CPU draws from its own pool without taking any lock. When it runs low
+ * it is topped up from the shared pool, and then from the platform source in
+ * bulk; words that do not fit in the CPU pool overflow into the shared pool.
  */
-#define WORDS_IN_POOL (4)
-static uint64_t entropy[WORDS_IN_POOL];
-/* index in bits of the first bit of usable entropy */
-static uint32_t entropy_bit_index;
-/* then number of valid bits in the entropy pool */
-static uint32_t entropy_bit_size;
+#define WORDS_IN_POOL (8)
 
+struct trng_pool {
+	uint64_t entropy[WORDS_IN_POOL];
+	/* index in bits of the first bit of usable entropy */
+	uint32_t bit_index;
+	/* then number of valid bits in the entropy pool */
+	uint32_t bit_size;
+} __aligned(CACHE_WRITEBACK_GRANULE);
+
+static struct trng_pool cpu_pool[PLATFORM_CORE_COUNT];
+static struct trng_pool shared_pool;
+
+/* Protects shared_pool */
 static spinlock_t trng_pool_lock;
+/* Serializes accesses to the platform entropy source */
+static spinlock_t trng_source_lock;
 
-#define BITS_PER_WORD (sizeof(entropy[0]) * 8)
+#define BITS_PER_WORD (sizeof(uint64_t) * 8)
 #define BITS_IN_POOL (WORDS_IN_POOL * BITS_PER_WORD)
-#define ENTROPY_MIN_WORD (entropy_bit_index / BITS_PER_WORD)
-#define ENTROPY_FREE_BIT (entropy_bit_size + entropy_bit_index)
-#define _ENTROPY_FREE_WORD (ENTROPY_FREE_BIT / BITS_PER_WORD)
-#define ENTROPY_FREE_INDEX (_ENTROPY_FREE_WORD % WORDS_IN_POOL)
-/* ENTROPY_WORD_INDEX(0) includes leftover bits in the lower bits */
-#define ENTROPY_WORD_INDEX(i) ((ENTROPY_MIN_WORD + i) % WORDS_IN_POOL)
+#define ENTROPY_MIN_WORD(p) ((p)->bit_index / BITS_PER_WORD)
+#define ENTROPY_FREE_BIT(p) ((p)->bit_size + (p)->bit_index)
+#define _ENTROPY_FREE_WORD(p) (ENTROPY_FREE_BIT(p) / BITS_PER_WORD)
+#define ENTROPY_FREE_INDEX(p) (_ENTROPY_FREE_WORD(p) % WORDS_IN_POOL)
+/* ENTROPY_WORD_INDEX(p, 0) includes leftover bits in the lower bits */
+#define ENTROPY_WORD_INDEX(p, i) ((ENTROPY_MIN_WORD(p) + (i)) % WORDS_IN_POOL)
+/* The word holding the leftover bits is not free */
+#define ENTROPY_FREE_WORDS(p) ((unsigned int)((BITS_IN_POOL - \
+	(p)->bit_size - ((p)->bit_index % BITS_PER_WORD)) / BITS_PER_WORD))
+
+#pragma weak plat_get_entropy_bulk
 
 /*
- * Fill the entropy pool until we have at least as many bits as requested.
- * Returns true after filling the pool, and false if the entropy source is out
- * of entropy and the pool could not be filled.
- * Assumes locks are taken.
+ * Default bulk read of the platform entropy source, one word at a time.
+ * Returns the number of words written to out.
  */
-static bool trng_fill_entropy(uint32_t nbits)
+unsigned int plat_get_entropy_bulk(uint64_t *out, unsigned int nwords)
 {
-	while (nbits > entropy_bit_size) {
-		bool valid = plat_get_entropy(&entropy[ENTROPY_FREE_INDEX]);
-
-		if (valid) {
-			entropy_bit_size += BITS_PER_WORD;
-			assert(entropy_bit_size <= BITS_IN_POOL);
-		} else {
-			return false;
+	unsigned int i;
+
+	for (i = 0U; i < nwords; i++) {
+		if (!plat_get_entropy(&out[i])) {
+			break;
 		}
 	}
-	return true;
+
+	return i;
 }
 
 /*
- * Pack entropy into the out buffer, filling and taking locks as needed.
- * Returns true on success, false on failure.
- *
- * Note: out must have enough space for nbits of entropy
+ * Append whole words of entropy to the pool.
+ * Assumes the pool has room for them and that locks are taken.
  */
-bool trng_pack_entropy(uint32_t nbits, uint64_t *out)
+static void trng_pool_push(struct trng_pool *pool, const uint64_t *in,
+			   unsigned int nwords)
 {
-	bool success = true;
+	unsigned int i;
 
-	spin_lock(&trng_pool_lock);
+	assert(nwords <= ENTROPY_FREE_WORDS(pool));
 
-	if (!trng_fill_entropy(nbits)) {
-		success = false;
-		goto out;
+	for (i = 0U; i < nwords; i++) {
+		pool->entropy[ENTROPY_FREE_INDEX(pool)] = in[i];
+		pool->bit_size += BITS_PER_WORD;
 	}
+}
 
-	const unsigned int rshift = entropy_bit_index % BITS_PER_WORD;
+/*
+ * Pack nbits of entropy from the pool into the out buffer.
+ * Assumes the pool holds at least nbits and that locks are taken.
+ *
+ * Note: out must have enough space for nbits of entropy
+ */
+static void trng_pool_pack(struct trng_pool *pool, uint32_t nbits,
+			   uint64_t *out)
+{
+	const unsigned int rshift = pool->bit_index % BITS_PER_WORD;
 	const unsigned int lshift = BITS_PER_WORD - rshift;
 	const int to_fill = ((nbits + BITS_PER_WORD - 1) / BITS_PER_WORD);
 	int word_i;
 
+	assert(nbits <= pool->bit_size);
 	for (word_i = 0; word_i < to_fill; word_i++) {
 		/*
 		 * Repack the entropy from the pool into the passed in out
@@ -113,7 +143,9 @@ bool trng_pack_entropy(uint32_t nbits, uint64_t *out)
 		 *                  [e,e,e,e,e,e,e,e]
 		 */
 		out[word_i] = 0;
-		out[word_i] |= entropy[ENTROPY_WORD_INDEX(word_i)] >> rshift;
+		out[word_i] |=
+			pool->entropy[ENTROPY_WORD_INDEX(pool, word_i)]
+			>> rshift;
 
 		/*
 		 * Note that a shift of 64 bits is treated as a shift of 0 bits.
@@ -122,30 +154,89 @@ bool trng_pack_entropy(uint32_t nbits, uint64_t *out)
 		 * the `|=` operation.
 		 */
 		if (lshift != BITS_PER_WORD) {
-			out[word_i] |= entropy[ENTROPY_WORD_INDEX(word_i + 1)]
+			out[word_i] |=
+				pool->entropy[ENTROPY_WORD_INDEX(pool, word_i + 1)]
 				<< lshift;
 		}
 	}
-	const uint64_t mask = ~0ULL >> (BITS_PER_WORD - (nbits % BITS_PER_WORD));
+	if ((nbits % BITS_PER_WORD) != 0U) {
+		const uint64_t mask = ~0ULL >>
+			(BITS_PER_WORD - (nbits % BITS_PER_WORD));
 
-	out[to_fill - 1] &= mask;
+		out[to_fill - 1] &= mask;
+	}
+
+	pool->bit_index = (pool->bit_index + nbits) % BITS_IN_POOL;
+	pool->bit_size -= nbits;
+}
 
-	entropy_bit_index = (entropy_bit_index + nbits) % BITS_IN_POOL;
-	entropy_bit_size -= nbits;
+/*
+ * Top up the pool of the calling CPU so that it holds at least nbits, first
+ * from the shared pool and then with a bulk read of the platform source.
+ * Returns false if the entropy source is out of entropy and the pool could
+ * not be filled.
+ */
+static bool trng_fill_entropy(struct trng_pool *pool, uint32_t nbits)
+{
+	uint64_t batch[WORDS_IN_POOL];
+	unsigned int nwords, got;
 
-out:
+	spin_lock(&trng_pool_lock);
+	nwords = MIN(ENTROPY_FREE_WORDS(pool),
+		     (unsigned int)(shared_pool.bit_size / BITS_PER_WORD));
+	if (nwords != 0U) {
+		trng_pool_pack(&shared_pool, nwords * BITS_PER_WORD, batch);
+	}
 	spin_unlock(&trng_pool_lock);
 
-	return success;
+	trng_pool_push(pool, batch, nwords);
+
+	if (pool->bit_size < nbits) {
+		spin_lock(&trng_source_lock);
+		got = plat_get_entropy_bulk(batch, WORDS_IN_POOL);
+		spin_unlock(&trng_source_lock);
+
+		assert(got <= WORDS_IN_POOL);
+		nwords = MIN(got, ENTROPY_FREE_WORDS(pool));
+		trng_pool_push(pool, batch, nwords);
+
+		if (got > nwords) {
+			spin_lock(&trng_pool_lock);
+			trng_pool_push(&shared_pool, &batch[nwords],
+				       MIN(got - nwords,
+					   ENTROPY_FREE_WORDS(&shared_pool)));
+			spin_unlock(&trng_pool_lock);
+		}
+	}
+
+	zeromem(batch, sizeof(batch));
+
+	return pool->bit_size >= nbits;
 }
 
-void trng_entropy_pool_setup(void)
+/*
+ * Pack entropy into the out buffer, filling the pool of the calling CPU as
+ * needed. Returns true on success, false on failure.
+ *
+ * Note: out must have enough space for nbits of entropy
+ */
+bool trng_pack_entropy(uint32_t nbits, uint64_t *out)
 {
-	int i;
+	struct trng_pool *pool = &cpu_pool[plat_my_core_pos()];
 
-	for (i = 0; i < WORDS_IN_POOL; i++) {
-		entropy[i] = 0;
+	assert(nbits <= (BITS_IN_POOL - BITS_PER_WORD));
+
+	if ((pool->bit_size < nbits) && !trng_fill_entropy(pool, nbits)) {
+		return false;
 	}
-	entropy_bit_index = 0;
-	entropy_bit_size = 0;
+
+	trng_pool_pack(pool, nbits, out);
+
+	return true;
+}
+
+void trng_entropy_pool_setup(void)
+{
+	zeromem(cpu_pool, sizeof(cpu_pool));
+	zeromem(&shared_pool, sizeof(shared_pool));
 }
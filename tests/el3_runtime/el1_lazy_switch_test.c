@@ -0,0 +1,338 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of the lazy EL1 system register switch of context_mgmt.c
+ * (CTX_EL1_LAZY_SWITCH). The EL1 registers are modelled by an el1_sysregs_t
+ * and the routines of context.S by copies of the same register sets. World
+ * switches are made in the order of the OP-TEE and Trusty dispatchers, with
+ * the secure payload writing the registers it uses, and the test checks that
+ * the normal world gets back all of its registers.
+ */
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <common/bl_common.h>
+#include <common/debug.h>
+#include <context.h>
+#include <lib/el3_runtime/context_mgmt.h>
+#include <lib/utils_def.h>
+
+/* Registers that context.S leaves to the normal world, see save_aux */
+static const unsigned int aux_regs[] = {
+	CTX_AMAIR_EL1,
+	CTX_ACTLR_EL1,
+	CTX_AFSR0_EL1,
+	CTX_AFSR1_EL1,
+	CTX_CONTEXTIDR_EL1,
+};
+
+/*
+ * Registers written by OP-TEE or Trusty while they run: thread switches
+ * and TLS of the trusted applications, AT instructions, set/way cache
+ * maintenance, and the usual translation and exception state.
+ */
+static const unsigned int secure_written_regs[] = {
+	CTX_TPIDR_EL0,
+	CTX_TPIDRRO_EL0,
+	CTX_PAR_EL1,
+	CTX_CSSELR_EL1,
+	CTX_SPSR_EL1,
+	CTX_ELR_EL1,
+	CTX_SP_EL1,
+	CTX_ESR_EL1,
+	CTX_FAR_EL1,
+	CTX_TTBR0_EL1,
+	CTX_TPIDR_EL1,
+};
+
+#define NUM_EL1_REGS	(sizeof(el1_sysregs_t) / sizeof(uint64_t))
+
+static el1_sysregs_t hw;
+static cpu_context_t ctx[2];
+static unsigned int failures;
+static jmp_buf panic_jmp;
+static bool expect_panic;
+
+static bool is_aux_reg(unsigned int offset)
+{
+	unsigned int i;
+
+	for (i = 0U; i < ARRAY_SIZE(aux_regs); i++) {
+		if (aux_regs[i] == offset) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void copy_regs(el1_sysregs_t *dst, const el1_sysregs_t *src,
+		      bool core, bool aux)
+{
+	unsigned int i;
+
+	for (i = 0U; i < NUM_EL1_REGS; i++) {
+		bool is_aux = is_aux_reg(i << DWORD_SHIFT);
+
+		if ((is_aux && aux) || (!is_aux && core)) {
+			dst->ctx_regs[i] = src->ctx_regs[i];
+		}
+	}
+}
+
+/* Models of the context.S routines */
+void el1_sysregs_context_save(el1_sysregs_t *regs)
+{
+	copy_regs(regs, &hw, true, true);
+}
+
+void el1_sysregs_context_restore(el1_sysregs_t *regs)
+{
+	copy_regs(&hw, regs, true, true);
+}
+
+void el1_sysregs_context_save_core(el1_sysregs_t *regs)
+{
+	copy_regs(regs, &hw, true, false);
+}
+
+void el1_sysregs_context_restore_core(el1_sysregs_t *regs)
+{
+	copy_regs(&hw, regs, true, false);
+}
+
+void el1_sysregs_context_save_aux(el1_sysregs_t *regs)
+{
+	copy_regs(regs, &hw, false, true);
+}
+
+/* BL31 services used by context_mgmt.c */
+void *cm_get_context(uint32_t security_state)
+{
+	return &ctx[security_state];
+}
+
+void *cm_get_context_by_index(unsigned int cpu_idx,
+			      unsigned int security_state)
+{
+	return &ctx[security_state];
+}
+
+void cm_set_next_context(void *context)
+{
+}
+
+unsigned int plat_my_core_pos(void)
+{
+	return 0U;
+}
+
+void zeromem(void *mem, u_register_t length)
+{
+	memset(mem, 0, length);
+}
+
+void tf_log(const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	/* Skip the log level marker */
+	vprintf(fmt + 1, args);
+	va_end(args);
+}
+
+void console_flush(void)
+{
+}
+
+void __dead2 do_panic(void)
+{
+	if (!expect_panic) {
+		printf("FAIL: unexpected panic\n");
+		exit(1);
+	}
+
+	longjmp(panic_jmp, 1);
+}
+
+/* Give each register of a world a value of its own */
+static void fill_regs(el1_sysregs_t *regs, uint64_t seed)
+{
+	unsigned int i;
+
+	for (i = 0U; i < NUM_EL1_REGS; i++) {
+		regs->ctx_regs[i] = (seed << 32) | (i + 1U);
+	}
+}
+
+static void secure_payload_run(uint64_t seed)
+{
+	unsigned int i;
+
+	for (i = 0U; i < ARRAY_SIZE(secure_written_regs); i++) {
+		write_ctx_reg(&hw, secure_written_regs[i], seed + i);
+	}
+}
+
+static void check_regs(const char *test, const el1_sysregs_t *regs,
+		       const el1_sysregs_t *expected)
+{
+	unsigned int i;
+
+	for (i = 0U; i < NUM_EL1_REGS; i++) {
+		if (regs->ctx_regs[i] != expected->ctx_regs[i]) {
+			printf("FAIL: %s: EL1 register at 0x%x is 0x%llx, expected 0x%llx\n",
+			       test, i << DWORD_SHIFT,
+			       (unsigned long long)regs->ctx_regs[i],
+			       (unsigned long long)expected->ctx_regs[i]);
+			failures++;
+		}
+	}
+}
+
+/* A normal world running with its registers, out of reset */
+static void normal_world_start(el1_sysregs_t *ns_regs)
+{
+	el1_sysregs_t s_regs;
+
+	fill_regs(ns_regs, 0x1U);
+	fill_regs(&s_regs, 0x2U);
+	*get_el1_sysregs_ctx(&ctx[SECURE]) = s_regs;
+	zeromem(get_el1_sysregs_ctx(&ctx[NON_SECURE]), sizeof(el1_sysregs_t));
+	hw = *ns_regs;
+
+	/* Reset of the lazy switch state, as done by PSCI */
+	cm_init_context_by_index(0U, &(entry_point_info_t){
+		.h.attr = NON_SECURE,
+	});
+	hw = *ns_regs;
+}
+
+/* opteed_smc_handler(): yielding call and TEESMC_OPTEED_RETURN_CALL_DONE */
+static void test_optee_call(void)
+{
+	el1_sysregs_t ns_regs;
+	unsigned int n;
+
+	normal_world_start(&ns_regs);
+
+	for (n = 0U; n < 3U; n++) {
+		cm_el1_sysregs_context_save_lazy(NON_SECURE);
+		cm_el1_sysregs_context_restore_lazy(SECURE);
+		secure_payload_run(0x5000U + n * 0x100U);
+		cm_el1_sysregs_context_save_lazy(SECURE);
+		cm_el1_sysregs_context_restore_lazy(NON_SECURE);
+
+		check_regs("optee_call", &hw, &ns_regs);
+	}
+}
+
+/* Secure interrupt, then TEESMC_OPTEED_RETURN_FIQ_DONE */
+static void test_optee_fiq(void)
+{
+	el1_sysregs_t ns_regs;
+
+	normal_world_start(&ns_regs);
+
+	cm_el1_sysregs_context_save_lazy(NON_SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
+	secure_payload_run(0x6000U);
+	cm_el1_sysregs_context_restore_lazy(NON_SECURE);
+
+	check_regs("optee_fiq", &hw, &ns_regs);
+}
+
+/* trusty_context_switch() from the normal world and back */
+static void test_trusty_switch(void)
+{
+	el1_sysregs_t ns_regs;
+	el1_sysregs_t s_regs;
+
+	normal_world_start(&ns_regs);
+
+	cm_el1_sysregs_context_save_lazy(NON_SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
+	secure_payload_run(0x7000U);
+	s_regs = hw;
+	cm_el1_sysregs_context_save_lazy(SECURE);
+	cm_el1_sysregs_context_restore_lazy(NON_SECURE);
+
+	check_regs("trusty_switch", &hw, &ns_regs);
+
+	/* The secure world gets its own values back on the next call */
+	cm_el1_sysregs_context_save_lazy(NON_SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
+	check_regs("trusty_switch secure", &hw, &s_regs);
+	cm_el1_sysregs_context_save_lazy(SECURE);
+	cm_el1_sysregs_context_restore_lazy(NON_SECURE);
+}
+
+/* A full switch while the secure world runs, as PSCI or SPM would do */
+static void test_full_switch(void)
+{
+	el1_sysregs_t ns_regs;
+
+	normal_world_start(&ns_regs);
+
+	cm_el1_sysregs_context_save_lazy(NON_SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
+	secure_payload_run(0x8000U);
+	cm_el1_sysregs_context_save(SECURE);
+	cm_el1_sysregs_context_restore(NON_SECURE);
+
+	check_regs("full_switch", &hw, &ns_regs);
+	check_regs("full_switch context",
+		   get_el1_sysregs_ctx(&ctx[NON_SECURE]), &ns_regs);
+}
+
+#if ENABLE_ASSERTIONS
+/* A secure payload breaking the contract is caught with assertions */
+static void test_contract_check(void)
+{
+	el1_sysregs_t ns_regs;
+
+	normal_world_start(&ns_regs);
+
+	cm_el1_sysregs_context_save_lazy(NON_SECURE);
+	cm_el1_sysregs_context_restore_lazy(SECURE);
+	write_ctx_reg(&hw, CTX_CONTEXTIDR_EL1, 0x9000U);
+	cm_el1_sysregs_context_save_lazy(SECURE);
+
+	expect_panic = true;
+	if (setjmp(panic_jmp) == 0) {
+		cm_el1_sysregs_context_restore_lazy(NON_SECURE);
+		printf("FAIL: contract_check: no panic\n");
+		failures++;
+	}
+	expect_panic = false;
+}
+#endif /* ENABLE_ASSERTIONS */
+
+int main(void)
+{
+	test_optee_call();
+	test_optee_fiq();
+	test_trusty_switch();
+	test_full_switch();
+#if ENABLE_ASSERTIONS
+	test_contract_check();
+#endif
+
+	if (failures != 0U) {
+		printf("%u failures\n", failures);
+		return 1;
+	}
+
+	printf("EL1 lazy switch tests passed\n");
+	return 0;
+}
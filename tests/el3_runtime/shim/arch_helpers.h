@@ -0,0 +1,68 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+#include <cdefs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <arch.h>
+
+/*
+ * Host replacement for include/arch/aarch64/arch_helpers.h, covering what
+ * context_mgmt.c uses. The system registers are plain variables that read as
+ * zero until they are written: no optional architecture feature is present
+ * and EL2 is not implemented.
+ */
+#define HOST_SYSREG_RW_FUNCS(_name)					\
+static u_register_t host_ ## _name;					\
+static inline u_register_t read_ ## _name(void)				\
+{									\
+	return host_ ## _name;						\
+}									\
+static inline void write_ ## _name(u_register_t v)			\
+{									\
+	host_ ## _name = v;						\
+}
+
+HOST_SYSREG_RW_FUNCS(actlr_el1)
+HOST_SYSREG_RW_FUNCS(cnthctl_el2)
+HOST_SYSREG_RW_FUNCS(cnthp_ctl_el2)
+HOST_SYSREG_RW_FUNCS(cntvoff_el2)
+HOST_SYSREG_RW_FUNCS(cptr_el2)
+HOST_SYSREG_RW_FUNCS(cptr_el3)
+HOST_SYSREG_RW_FUNCS(hcr_el2)
+HOST_SYSREG_RW_FUNCS(hstr_el2)
+HOST_SYSREG_RW_FUNCS(id_aa64isar0_el1)
+HOST_SYSREG_RW_FUNCS(id_aa64isar1_el1)
+HOST_SYSREG_RW_FUNCS(id_aa64mmfr0_el1)
+HOST_SYSREG_RW_FUNCS(id_aa64mmfr1_el1)
+HOST_SYSREG_RW_FUNCS(id_aa64mmfr2_el1)
+HOST_SYSREG_RW_FUNCS(id_aa64pfr0_el1)
+HOST_SYSREG_RW_FUNCS(id_aa64pfr1_el1)
+HOST_SYSREG_RW_FUNCS(mdcr_el2)
+HOST_SYSREG_RW_FUNCS(midr_el1)
+HOST_SYSREG_RW_FUNCS(mpidr_el1)
+HOST_SYSREG_RW_FUNCS(pmcr_el0)
+HOST_SYSREG_RW_FUNCS(scr)
+HOST_SYSREG_RW_FUNCS(sctlr_el2)
+HOST_SYSREG_RW_FUNCS(vmpidr_el2)
+HOST_SYSREG_RW_FUNCS(vpidr_el2)
+HOST_SYSREG_RW_FUNCS(vttbr_el2)
+
+static inline unsigned int el_implemented(unsigned int el)
+{
+	return (el == 2U) ? EL_IMPL_NONE : EL_IMPL_A64ONLY;
+}
+
+static inline void isb(void) { }
+static inline void dsbsy(void) { }
+static inline void dsbish(void) { }
+
+#endif /* ARCH_HELPERS_H */
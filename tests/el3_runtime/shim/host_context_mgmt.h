@@ -0,0 +1,38 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef HOST_CONTEXT_MGMT_H
+#define HOST_CONTEXT_MGMT_H
+
+/*
+ * lib/el3_runtime/context_mgmt.h defines cm_set_next_context() with inline
+ * assembly for AArch64. Take its AArch32 declaration instead, the test
+ * provides the function, and declare the AArch64 functions here.
+ */
+#include <assert.h>
+#include <context.h>
+#include <stdint.h>
+
+#include <arch.h>
+
+#undef __aarch64__
+#include <lib/el3_runtime/context_mgmt.h>
+#define __aarch64__	1
+
+void cm_el1_sysregs_context_save(uint32_t security_state);
+void cm_el1_sysregs_context_restore(uint32_t security_state);
+void cm_el1_sysregs_context_save_lazy(uint32_t security_state);
+void cm_el1_sysregs_context_restore_lazy(uint32_t security_state);
+void cm_set_elr_el3(uint32_t security_state, uintptr_t entrypoint);
+void cm_set_elr_spsr_el3(uint32_t security_state,
+			uintptr_t entrypoint, uint32_t spsr);
+void cm_write_scr_el3_bit(uint32_t security_state,
+			  uint32_t bit_pos,
+			  uint32_t value);
+void cm_set_next_eret_context(uint32_t security_state);
+u_register_t cm_get_scr_el3(uint32_t security_state);
+
+#endif /* HOST_CONTEXT_MGMT_H */
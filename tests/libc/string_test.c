@@ -0,0 +1,425 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of memcpy(), memmove() and memcmp() of the firmware libc, built
+ * as tf_memcpy(), tf_memmove() and tf_memcmp(). Every combination of source
+ * and destination offsets, lengths and, for memmove(), overlaps is checked
+ * against a byte at a time reference, with guard bytes around the buffers.
+ * The throughput of the routines is then measured over a few sizes.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void *tf_memcpy(void *dst, const void *src, size_t len);
+void *tf_memmove(void *dst, const void *src, size_t len);
+int tf_memcmp(const void *s1, const void *s2, size_t len);
+
+/* Offsets from a 16-byte boundary, covering the 8 and 16-byte loops */
+#define MAX_OFF		16U
+/* Several iterations of the 64-byte loop, followed by every tail length */
+#define COPY_MAX_LEN	300U
+/* Distance between source and destination, below and above 64 bytes */
+#define MOVE_SPAN	80U
+#define MOVE_MAX_LEN	200U
+#define CMP_MAX_LEN	160U
+#define GUARD		64U
+#define GUARD_BYTE	0xa5U
+
+#define ARRAY_LEN(_a)	(sizeof(_a) / sizeof((_a)[0]))
+
+/* Failures reported in detail for each routine */
+#define MAX_REPORTS	10U
+
+#define COPY_BUF_SIZE	(GUARD + MAX_OFF + COPY_MAX_LEN + GUARD)
+#define MOVE_BUF_SIZE	(GUARD + MOVE_SPAN + MOVE_MAX_LEN + GUARD)
+#define CMP_BUF_SIZE	(MAX_OFF + CMP_MAX_LEN + 1U)
+
+/* Throughput of each routine is measured for this long per size */
+#define BENCH_NS	20000000ULL
+#define BENCH_MAX_LEN	65536U
+
+static unsigned int failures;
+
+static uint8_t copy_src[COPY_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t copy_dst[COPY_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t copy_ref[COPY_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t move_buf[MOVE_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t move_ref[MOVE_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t cmp_a[CMP_BUF_SIZE] __attribute__((aligned(64)));
+static uint8_t cmp_b[CMP_BUF_SIZE] __attribute__((aligned(64)));
+
+static __attribute__((format(printf, 2, 3)))
+void fail(unsigned int *reports, const char *fmt, ...)
+{
+	va_list args;
+
+	failures++;
+	if (++(*reports) > MAX_REPORTS) {
+		return;
+	}
+
+	va_start(args, fmt);
+	printf("FAIL: ");
+	vprintf(fmt, args);
+	va_end(args);
+}
+
+/* Bytes that are different at every position and never the guard byte */
+static void fill_pattern(uint8_t *buf, size_t len, unsigned int seed)
+{
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		buf[i] = (uint8_t)(((i + seed) * 7U + 1U) % 251U);
+	}
+}
+
+static void ref_memmove(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	uint8_t tmp[MOVE_BUF_SIZE];
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		tmp[i] = src[i];
+	}
+	for (i = 0U; i < len; i++) {
+		dst[i] = tmp[i];
+	}
+}
+
+/* Same result as lib/libc/memcmp.c */
+static int ref_memcmp(const uint8_t *s1, const uint8_t *s2, size_t len)
+{
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		if (s1[i] != s2[i]) {
+			return (int)s1[i] - (int)s2[i];
+		}
+	}
+
+	return 0;
+}
+
+static size_t first_diff(const uint8_t *a, const uint8_t *b, size_t len)
+{
+	size_t i;
+
+	for (i = 0U; i < len; i++) {
+		if (a[i] != b[i]) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static void test_memcpy(void)
+{
+	unsigned int src_off, dst_off, reports = 0U;
+	unsigned long cases = 0UL;
+	size_t len, diff;
+	void *ret;
+
+	fill_pattern(copy_src, sizeof(copy_src), 0U);
+
+	for (src_off = 0U; src_off < MAX_OFF; src_off++) {
+		for (dst_off = 0U; dst_off < MAX_OFF; dst_off++) {
+			for (len = 0U; len <= COPY_MAX_LEN; len++) {
+				uint8_t *src = &copy_src[GUARD + src_off];
+				uint8_t *dst = &copy_dst[GUARD + dst_off];
+
+				memset(copy_dst, GUARD_BYTE, sizeof(copy_dst));
+				memset(copy_ref, GUARD_BYTE, sizeof(copy_ref));
+				memcpy(&copy_ref[GUARD + dst_off], src, len);
+
+				ret = tf_memcpy(dst, src, len);
+				cases++;
+
+				if (ret != dst) {
+					fail(&reports, "memcpy src+%u dst+%u len %zu returned %p, expected %p\n",
+					     src_off, dst_off, len, ret,
+					     (void *)dst);
+				}
+
+				diff = first_diff(copy_dst, copy_ref,
+						  sizeof(copy_dst));
+				if (diff != sizeof(copy_dst)) {
+					fail(&reports, "memcpy src+%u dst+%u len %zu: byte %td is 0x%02x, expected 0x%02x\n",
+					     src_off, dst_off, len,
+					     (ptrdiff_t)diff - (GUARD + dst_off),
+					     copy_dst[diff], copy_ref[diff]);
+				}
+			}
+		}
+	}
+
+	printf("memcpy: %lu cases\n", cases);
+}
+
+static void test_memmove(void)
+{
+	unsigned int src_off, dst_off, reports = 0U;
+	unsigned long cases = 0UL;
+	size_t len, diff;
+	void *ret;
+
+	for (src_off = 0U; src_off < MOVE_SPAN; src_off++) {
+		for (dst_off = 0U; dst_off < MOVE_SPAN; dst_off++) {
+			for (len = 0U; len <= MOVE_MAX_LEN; len++) {
+				uint8_t *src = &move_buf[GUARD + src_off];
+				uint8_t *dst = &move_buf[GUARD + dst_off];
+
+				memset(move_buf, GUARD_BYTE, GUARD);
+				fill_pattern(&move_buf[GUARD],
+					     MOVE_SPAN + MOVE_MAX_LEN, 0U);
+				memset(&move_buf[MOVE_BUF_SIZE - GUARD],
+				       GUARD_BYTE, GUARD);
+				memcpy(move_ref, move_buf, sizeof(move_ref));
+				ref_memmove(&move_ref[GUARD + dst_off],
+					    &move_ref[GUARD + src_off], len);
+
+				ret = tf_memmove(dst, src, len);
+				cases++;
+
+				if (ret != dst) {
+					fail(&reports, "memmove src+%u dst+%u len %zu returned %p, expected %p\n",
+					     src_off, dst_off, len, ret,
+					     (void *)dst);
+				}
+
+				diff = first_diff(move_buf, move_ref,
+						  sizeof(move_buf));
+				if (diff != sizeof(move_buf)) {
+					fail(&reports, "memmove src+%u dst+%u len %zu: byte %td is 0x%02x, expected 0x%02x\n",
+					     src_off, dst_off, len,
+					     (ptrdiff_t)diff - (GUARD + dst_off),
+					     move_buf[diff], move_ref[diff]);
+				}
+			}
+		}
+	}
+
+	printf("memmove: %lu cases\n", cases);
+}
+
+static void check_memcmp(const uint8_t *a, const uint8_t *b, size_t len,
+			 const char *what, size_t pos, unsigned int *reports)
+{
+	int ret = tf_memcmp(a, b, len);
+	int expected = ref_memcmp(a, b, len);
+
+	if (ret != expected) {
+		fail(reports, "memcmp s1+%u s2+%u len %zu %s %zu returned %d, expected %d\n",
+		     (unsigned int)((uintptr_t)a % MAX_OFF),
+		     (unsigned int)((uintptr_t)b % MAX_OFF), len, what, pos,
+		     ret, expected);
+	}
+}
+
+/*
+ * For each length, the objects are compared when equal and then with a
+ * first difference at each position, in both directions and with bytes of
+ * either sign, while the bytes after it differ the other way.
+ */
+static void test_memcmp(void)
+{
+	static const uint8_t values[][2] = {
+		{ 0x80U, 0x7fU },
+		{ 0x01U, 0xffU },
+		{ 0x42U, 0x41U },
+	};
+	unsigned int a_off, b_off, reports = 0U, v;
+	unsigned long cases = 0UL;
+	size_t len, pos;
+
+	for (a_off = 0U; a_off < MAX_OFF; a_off++) {
+		for (b_off = 0U; b_off < MAX_OFF; b_off++) {
+			uint8_t *a = &cmp_a[a_off];
+			uint8_t *b = &cmp_b[b_off];
+
+			fill_pattern(a, CMP_MAX_LEN + 1U, 3U);
+			fill_pattern(b, CMP_MAX_LEN + 1U, 3U);
+
+			for (len = 0U; len <= CMP_MAX_LEN; len++) {
+				/* Differs only past the end */
+				b[len] ^= 0xffU;
+				check_memcmp(a, b, len, "equal up to", len,
+					     &reports);
+				b[len] ^= 0xffU;
+				cases++;
+
+				for (pos = 0U; pos < len; pos++) {
+					uint8_t a0 = a[pos], b0 = b[pos];
+					uint8_t a1 = a[pos + 1U];
+					uint8_t b1 = b[pos + 1U];
+
+					for (v = 0U; v < 2U * ARRAY_LEN(values);
+					     v++) {
+						unsigned int hi = v & 1U;
+
+						a[pos] = values[v / 2U][hi];
+						b[pos] = values[v / 2U][hi ^ 1U];
+						a[pos + 1U] = values[v / 2U][hi ^ 1U];
+						b[pos + 1U] = values[v / 2U][hi];
+
+						check_memcmp(a, b, len,
+							     "differing at",
+							     pos, &reports);
+						cases++;
+					}
+
+					a[pos] = a0;
+					b[pos] = b0;
+					a[pos + 1U] = a1;
+					b[pos + 1U] = b1;
+				}
+			}
+		}
+	}
+
+	printf("memcmp: %lu cases\n", cases);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+enum bench_op {
+	BENCH_MEMCPY,
+	BENCH_MEMMOVE,
+	BENCH_MEMCMP,
+};
+
+struct bench_case {
+	const char *name;
+	enum bench_op op;
+	/* Offsets of the source and destination from 64-byte boundaries */
+	unsigned int src_off;
+	unsigned int dst_off;
+	/* The destination overlaps the source, ahead of it */
+	int overlap;
+};
+
+static const struct bench_case bench_cases[] = {
+	{ "memcpy  aligned",   BENCH_MEMCPY,  0U, 0U, 0 },
+	{ "memcpy  word",      BENCH_MEMCPY,  4U, 0U, 0 },
+	{ "memcpy  byte",      BENCH_MEMCPY,  1U, 0U, 0 },
+	{ "memmove forward",   BENCH_MEMMOVE, 64U, 0U, 1 },
+	{ "memmove backward",  BENCH_MEMMOVE, 0U, 64U, 1 },
+	{ "memmove byte back", BENCH_MEMMOVE, 0U, 65U, 1 },
+	{ "memcmp  aligned",   BENCH_MEMCMP,  0U, 0U, 0 },
+	{ "memcmp  word",      BENCH_MEMCMP,  4U, 0U, 0 },
+	{ "memcmp  byte",      BENCH_MEMCMP,  1U, 0U, 0 },
+};
+
+static const size_t bench_sizes[] = { 64U, 512U, 4096U, BENCH_MAX_LEN };
+
+static volatile int bench_sink;
+
+static double bench_run(const struct bench_case *bc, uint8_t *buf_a,
+			uint8_t *buf_b, size_t len)
+{
+	uint8_t *src = &buf_a[bc->src_off];
+	uint8_t *dst = bc->overlap ? &buf_a[bc->dst_off] :
+		       &buf_b[bc->dst_off];
+	uint64_t start, elapsed, bytes = 0U;
+
+	start = now_ns();
+	do {
+		unsigned int i;
+
+		for (i = 0U; i < 16U; i++) {
+			switch (bc->op) {
+			case BENCH_MEMCPY:
+				tf_memcpy(dst, src, len);
+				break;
+			case BENCH_MEMMOVE:
+				tf_memmove(dst, src, len);
+				break;
+			default:
+				bench_sink = tf_memcmp(dst, src, len);
+				break;
+			}
+		}
+
+		bytes += 16U * len;
+		elapsed = now_ns() - start;
+	} while (elapsed < BENCH_NS);
+
+	/* MB/s */
+	return ((double)bytes * 1000.0) / (double)elapsed;
+}
+
+static void bench(void)
+{
+	uint8_t *buf_a, *buf_b;
+	unsigned int c, s;
+
+	buf_a = aligned_alloc(64U, 2U * BENCH_MAX_LEN);
+	buf_b = aligned_alloc(64U, 2U * BENCH_MAX_LEN);
+	if ((buf_a == NULL) || (buf_b == NULL)) {
+		printf("FAIL: out of memory\n");
+		failures++;
+		goto out;
+	}
+
+	/* memcmp() goes through the whole objects */
+	memset(buf_a, 0x5aU, 2U * BENCH_MAX_LEN);
+	memset(buf_b, 0x5aU, 2U * BENCH_MAX_LEN);
+
+	printf("\nThroughput (MB/s) %19s", "");
+	for (s = 0U; s < ARRAY_LEN(bench_sizes); s++) {
+		printf(" %8zu", bench_sizes[s]);
+	}
+	printf("\n");
+
+	for (c = 0U; c < ARRAY_LEN(bench_cases); c++) {
+		printf("%-36s", bench_cases[c].name);
+		for (s = 0U; s < ARRAY_LEN(bench_sizes); s++) {
+			printf(" %8.0f", bench_run(&bench_cases[c], buf_a,
+						   buf_b, bench_sizes[s]));
+		}
+		printf("\n");
+	}
+
+out:
+	free(buf_a);
+	free(buf_b);
+}
+
+int main(void)
+{
+	printf("Testing the %s routines\n", LIBC_IMPL);
+
+	test_memcpy();
+	test_memmove();
+	test_memcmp();
+
+	if (failures == 0U) {
+		bench();
+	}
+
+	if (failures != 0U) {
+		printf("%u failures\n", failures);
+		return 1;
+	}
+
+	printf("libc string tests passed\n");
+	return 0;
+}
@@ -0,0 +1,13 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef HOST_CDEFS_H
+#define HOST_CDEFS_H
+
+/* The TF-A libc is not used on the host, but its compiler helpers are */
+#include <lib/libc/cdefs.h>
+
+#endif /* HOST_CDEFS_H */
@@ -0,0 +1,17 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef HOST_COMPAT_H
+#define HOST_COMPAT_H
+
+/*
+ * Types provided by the TF-A libc that the host C library doesn't have. This
+ * header is included ahead of every TF-A source built for the host.
+ */
+typedef unsigned long u_register_t;
+typedef long register_t;
+
+#endif /* HOST_COMPAT_H */
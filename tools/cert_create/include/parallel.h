@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/* Function running the job 'idx' of a batch of jobs */
+typedef void (*parallel_job_t)(unsigned int idx, void *arg);
+
+/* Exported API */
+void parallel_set_max_threads(unsigned int num);
+void parallel_run(unsigned int num_jobs, parallel_job_t job, void *arg);
+
+#endif /* PARALLEL_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -24,6 +24,18 @@
 key_t *keys;
 unsigned int num_keys;
 
+/*
+ * Private keys loaded from files. When several sets of certificates are
+ * created, each key file is only read and parsed once.
+ */
+typedef struct key_cache_s {
+	char *fn;
+	EVP_PKEY *key;
+	struct key_cache_s *next;
+} key_cache_t;
+
+static key_cache_t *key_cache;
+
 /*
  * Create a new key container
  */
@@ -128,18 +140,77 @@ int key_create(key_t *key, int type, int key_bits)
 	return 0;
 }
 
+static EVP_PKEY *key_cache_get(const char *fn)
+{
+	key_cache_t *entry;
+
+	for (entry = key_cache; entry != NULL; entry = entry->next) {
+		if (strcmp(entry->fn, fn) == 0) {
+			return entry->key;
+		}
+	}
+
+	return NULL;
+}
+
+static void key_cache_add(const char *fn, EVP_PKEY *k)
+{
+	key_cache_t *entry;
+
+	entry = malloc(sizeof(*entry));
+	if (entry == NULL) {
+		return;
+	}
+
+	entry->fn = malloc(strlen(fn) + 1);
+	if (entry->fn == NULL) {
+		free(entry);
+		return;
+	}
+	strcpy(entry->fn, fn);
+
+	EVP_PKEY_up_ref(k);
+	entry->key = k;
+	entry->next = key_cache;
+	key_cache = entry;
+}
+
+void key_cache_free(void)
+{
+	key_cache_t *entry;
+
+	while (key_cache != NULL) {
+		entry = key_cache;
+		key_cache = entry->next;
+		EVP_PKEY_free(entry->key);
+		free(entry->fn);
+		free(entry);
+	}
+}
+
 int key_load(key_t *key, unsigned int *err_code)
 {
 	FILE *fp;
 	EVP_PKEY *k;
 
 	if (key->fn) {
+		/* Use the key if it was already loaded from this file */
+		k = key_cache_get(key->fn);
+		if (k) {
+			EVP_PKEY_up_ref(k);
+			EVP_PKEY_free(key->key);
+			key->key = k;
+			*err_code = KEY_ERR_NONE;
+			return 1;
+		}
+
 		/* Load key from file */
 		fp = fopen(key->fn, "r");
 		if (fp) {
 			k = PEM_read_PrivateKey(fp, &key->key, NULL, NULL);
 			fclose(fp);
 			if (k) {
+				key_cache_add(key->fn, k);
 				*err_code = KEY_ERR_NONE;
 				return 1;
 			} else {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -24,6 +24,7 @@
 #include "debug.h"
 #include "ext.h"
 #include "key.h"
+#include "parallel.h"
 #include "sha.h"
 
 /*
@@ -57,6 +58,8 @@
 #define ID_TO_BIT_MASK(id)		(1 << id)
 #define NUM_ELEM(x)			((sizeof(x)) / (sizeof(x[0])))
 #define HELP_OPT_MAX_LEN		128
+#define BATCH_LINE_MAX_LEN		4096
+#define BATCH_MAX_ARGS			(2 * CMD_OPT_MAX_NUM)
 
 /* Global options */
 static int key_alg;
@@ -66,6 +69,10 @@ static int new_keys;
 static int save_keys;
 static int print_cert;
 
+/* Image hash algorithm indicated in the certificate extensions */
+static const EVP_MD *md_info;
+static unsigned int md_len;
+
 /* Info messages created in the Makefile */
 extern const char build_msg[];
 extern const char platform_msg[];
@@ -172,6 +179,19 @@ static int get_hash_alg(const char *hash_alg_str)
 	return -1;
 }
 
+static int cert_has_ext(const cert_t *cert, int ext_idx)
+{
+	int i;
+
+	for (i = 0; i < cert->num_ext; i++) {
+		if (cert->ext[i] == ext_idx) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
 static void check_cmd_params(void)
 {
 	cert_t *cert;
@@ -288,69 +308,54 @@ static const cmd_opt_t common_cmd_opt[] = {
 	{
 		{ "print-cert", no_argument, NULL, 'p' },
 		"Print the certificates in the standard output"
+	},
+	{
+		{ "batch", required_argument, NULL, 'B' },
+		"Create the sets of certificates given by the lines of a file, "
+		"each line holding the options of one set"
+	},
+	{
+		{ "jobs", required_argument, NULL, 'j' },
+		"Number of threads hashing the images and signing the "
+		"certificates (default: one per CPU)"
 	}
 };
 
-int main(int argc, char *argv[])
+/*
+ * Parse the command line options, or the options of one set of certificates
+ * given in a batch file. Return the name of the batch file, if any.
+ */
+static const char *parse_cmd_opts(int argc, char *argv[], int in_batch)
 {
-	STACK_OF(X509_EXTENSION) * sk;
-	X509_EXTENSION *cert_ext = NULL;
+	const struct option *cmd_opt;
+	const char *cur_opt;
+	const char *batch_fn = NULL;
 	ext_t *ext;
 	key_t *key;
 	cert_t *cert;
-	FILE *file;
-	int i, j, ext_nid, nvctr;
-	int c, opt_idx = 0;
-	const struct option *cmd_opt;
-	const char *cur_opt;
-	unsigned int err_code;
-	unsigned char md[SHA512_DIGEST_LENGTH];
-	unsigned int  md_len;
-	const EVP_MD *md_info;
-
-	NOTICE("CoT Generation Tool: %s\n", build_msg);
-	NOTICE("Target platform: %s\n", platform_msg);
-
-	/* Set default options */
-	key_alg = KEY_ALG_RSA;
-	hash_alg = HASH_ALG_SHA256;
-	key_size = -1;
-
-	/* Add common command line options */
-	for (i = 0; i < NUM_ELEM(common_cmd_opt); i++) {
-		cmd_opt_add(&common_cmd_opt[i]);
-	}
-
-	/* Initialize the certificates */
-	if (cert_init() != 0) {
-		ERROR("Cannot initialize certificates\n");
-		exit(1);
-	}
-
-	/* Initialize the keys */
-	if (key_init() != 0) {
-		ERROR("Cannot initialize keys\n");
-		exit(1);
-	}
-
-	/* Initialize the new types and register OIDs for the extensions */
-	if (ext_init() != 0) {
-		ERROR("Cannot initialize extensions\n");
-		exit(1);
-	}
+	int c, opt_idx = 0, jobs;
 
 	/* Get the command line options populated during the initialization */
 	cmd_opt = cmd_opt_get_array();
 
+	/* Restart the parsing from the first option */
+	optind = 0;
+
 	while (1) {
 		/* getopt_long stores the option index here. */
-		c = getopt_long(argc, argv, "a:b:hknps:", cmd_opt, &opt_idx);
+		c = getopt_long(argc, argv, "a:b:B:hj:knps:", cmd_opt, &opt_idx);
 
 		/* Detect the end of the options. */
 		if (c == -1) {
 			break;
 		}
 
+		if (in_batch && ((c == 'B') || (c == 'h') || (c == 'j'))) {
+			ERROR("Option '%s' not allowed in a batch file\n",
+			      argv[optind - 1]);
+			exit(1);
+		}
+
 		switch (c) {
 		case 'a':
 			key_alg = get_key_alg(optarg);
@@ -366,9 +371,20 @@ int main(int argc, char *argv[])
 				exit(1);
 			}
 			break;
+		case 'B':
+			batch_fn = optarg;
+			break;
 		case 'h':
 			print_help(argv[0], cmd_opt);
 			exit(0);
+		case 'j':
+			jobs = atoi(optarg);
+			if (jobs <= 0) {
+				ERROR("Invalid number of jobs '%s'\n", optarg);
+				exit(1);
+			}
+			parallel_set_max_threads(jobs);
+			break;
 		case 'k':
 			save_keys = 1;
 			break;
@@ -402,31 +418,26 @@ int main(int argc, char *argv[])
 			break;
 		case '?':
 		default:
+			if (in_batch) {
+				exit(1);
+			}
 			print_help(argv[0], cmd_opt);
 			exit(1);
 		}
 	}
 
-	/* Select a reasonable default key-size */
-	if (key_size == -1) {
-		key_size = KEY_SIZES[key_alg][0];
+	if (optind < argc) {
+		ERROR("Unexpected argument '%s'\n", argv[optind]);
+		exit(1);
 	}
 
-	/* Check command line arguments */
-	check_cmd_params();
+	return batch_fn;
+}
 
-	/* Indicate SHA as image hash algorithm in the certificate
-	 * extension */
-	if (hash_alg == HASH_ALG_SHA384) {
-		md_info = EVP_sha384();
-		md_len  = SHA384_DIGEST_LENGTH;
-	} else if (hash_alg == HASH_ALG_SHA512) {
-		md_info = EVP_sha512();
-		md_len  = SHA512_DIGEST_LENGTH;
-	} else {
-		md_info = EVP_sha256();
-		md_len  = SHA256_DIGEST_LENGTH;
-	}
+static void load_keys(void)
+{
+	int i;
+	unsigned int err_code;
 
 	/* Load private keys from files (or generate new ones) */
 	for (i = 0 ; i < num_keys ; i++) {
@@ -467,96 +478,194 @@ int main(int argc, char *argv[])
 			exit(1);
 		}
 	}
+}
 
-	/* Create the certificates */
-	for (i = 0 ; i < num_certs ; i++) {
+/* Hash of the image of each extension of type EXT_TYPE_HASH */
+static unsigned char (*ext_md)[SHA512_DIGEST_LENGTH];
 
-		cert = &certs[i];
+static void hash_job(unsigned int idx, void *arg)
+{
+	int ext_idx = ((int *)arg)[idx];
+	ext_t *ext = &extensions[ext_idx];
 
-		if (cert->fn == NULL) {
-			/* Certificate not requested. Skip to the next one */
-			continue;
-		}
+	/* Calculate the hash of the file */
+	if (!sha_file(hash_alg, ext->arg, ext_md[ext_idx])) {
+		ERROR("Cannot calculate hash of %s\n", ext->arg);
+		exit(1);
+	}
+}
 
-		/* Create a new stack of extensions. This stack will be used
-		 * to create the certificate */
-		CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
+static void create_cert(cert_t *cert)
+{
+	STACK_OF(X509_EXTENSION) * sk;
+	X509_EXTENSION *cert_ext = NULL;
+	ext_t *ext;
+	int j, ext_nid, nvctr;
+	unsigned char md[SHA512_DIGEST_LENGTH];
 
-		for (j = 0 ; j < cert->num_ext ; j++) {
+	/* Create a new stack of extensions. This stack will be used
+	 * to create the certificate */
+	CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
 
-			ext = &extensions[cert->ext[j]];
+	for (j = 0 ; j < cert->num_ext ; j++) {
 
-			/* Get OpenSSL internal ID for this extension */
-			CHECK_OID(ext_nid, ext->oid);
+		ext = &extensions[cert->ext[j]];
 
-			/*
-			 * Three types of extensions are currently supported:
-			 *     - EXT_TYPE_NVCOUNTER
-			 *     - EXT_TYPE_HASH
-			 *     - EXT_TYPE_PKEY
-			 */
-			switch (ext->type) {
-			case EXT_TYPE_NVCOUNTER:
-				if (ext->optional && ext->arg == NULL) {
-					/* Skip this NVCounter */
-					continue;
-				} else {
-					/* Checked by `check_cmd_params` */
-					assert(ext->arg != NULL);
-					nvctr = atoi(ext->arg);
-					CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
-						EXT_CRIT, nvctr));
-				}
-				break;
-			case EXT_TYPE_HASH:
-				if (ext->arg == NULL) {
-					if (ext->optional) {
-						/* Include a hash filled with zeros */
-						memset(md, 0x0, SHA512_DIGEST_LENGTH);
-					} else {
-						/* Do not include this hash in the certificate */
-						continue;
-					}
+		/* Get OpenSSL internal ID for this extension */
+		CHECK_OID(ext_nid, ext->oid);
+
+		/*
+		 * Three types of extensions are currently supported:
+		 *     - EXT_TYPE_NVCOUNTER
+		 *     - EXT_TYPE_HASH
+		 *     - EXT_TYPE_PKEY
+		 */
+		switch (ext->type) {
+		case EXT_TYPE_NVCOUNTER:
+			if (ext->optional && ext->arg == NULL) {
+				/* Skip this NVCounter */
+				continue;
+			} else {
+				/* Checked by `check_cmd_params` */
+				assert(ext->arg != NULL);
+				nvctr = atoi(ext->arg);
+				CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
+					EXT_CRIT, nvctr));
+			}
+			break;
+		case EXT_TYPE_HASH:
+			if (ext->arg == NULL) {
+				if (ext->optional) {
+					/* Include a hash filled with zeros */
+					memset(md, 0x0, SHA512_DIGEST_LENGTH);
 				} else {
-					/* Calculate the hash of the file */
-					if (!sha_file(hash_alg, ext->arg, md)) {
-						ERROR("Cannot calculate hash of %s\n",
-							ext->arg);
-						exit(1);
-					}
+					/* Do not include this hash in the certificate */
+					continue;
 				}
-				CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
-						EXT_CRIT, md_info, md,
-						md_len));
-				break;
-			case EXT_TYPE_PKEY:
-				CHECK_NULL(cert_ext, ext_new_key(ext_nid,
-					EXT_CRIT, keys[ext->attr.key].key));
-				break;
-			default:
-				ERROR("Unknown extension type '%d' in %s\n",
-						ext->type, cert->cn);
-				exit(1);
+			} else {
+				/* Hash calculated by create_certs() */
+				memcpy(md, ext_md[cert->ext[j]], md_len);
 			}
-
-			/* Push the extension into the stack */
-			sk_X509_EXTENSION_push(sk, cert_ext);
+			CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
+					EXT_CRIT, md_info, md,
+					md_len));
+			break;
+		case EXT_TYPE_PKEY:
+			CHECK_NULL(cert_ext, ext_new_key(ext_nid,
+				EXT_CRIT, keys[ext->attr.key].key));
+			break;
+		default:
+			ERROR("Unknown extension type '%d' in %s\n",
+					ext->type, cert->cn);
+			exit(1);
 		}
 
-		/* Create certificate. Signed with corresponding key */
-		if (!cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
-			ERROR("Cannot create %s\n", cert->cn);
-			exit(1);
+		/* Push the extension into the stack */
+		sk_X509_EXTENSION_push(sk, cert_ext);
+	}
+
+	/* Create certificate. Signed with corresponding key */
+	if (!cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
+		ERROR("Cannot create %s\n", cert->cn);
+		exit(1);
+	}
+
+	for (cert_ext = sk_X509_EXTENSION_pop(sk); cert_ext != NULL;
+			cert_ext = sk_X509_EXTENSION_pop(sk)) {
+		X509_EXTENSION_free(cert_ext);
+	}
+
+	sk_X509_EXTENSION_free(sk);
+}
+
+static void cert_job(unsigned int idx, void *arg)
+{
+	create_cert(&certs[((int *)arg)[idx]]);
+}
+
+/*
+ * Create the requested certificates. The images are hashed concurrently, then
+ * the certificates are signed concurrently, in as many rounds as needed for the
+ * issuer certificates to be created first.
+ *
+ * A certificate is signed with the certificate of its issuer if the issuer
+ * comes earlier in the array of certificates, otherwise as a self-signed
+ * certificate, so the order of the rounds preserves that of the array.
+ */
+static void create_certs(void)
+{
+	cert_t *cert;
+	ext_t *ext;
+	int *jobs, *round;
+	int i, j, num_jobs, num_rounds = 0;
+
+	jobs = malloc(((num_certs > num_extensions) ? num_certs :
+		       num_extensions) * sizeof(*jobs));
+	round = calloc(num_certs, sizeof(*round));
+	ext_md = calloc(num_extensions, sizeof(*ext_md));
+	if ((jobs == NULL) || (round == NULL) || (ext_md == NULL)) {
+		ERROR("%s:%d Failed to allocate memory.\n", __func__, __LINE__);
+		exit(1);
+	}
+
+	/* Hash the images of the requested certificates */
+	num_jobs = 0;
+	for (i = 0 ; i < num_extensions ; i++) {
+		ext = &extensions[i];
+		if ((ext->type != EXT_TYPE_HASH) || (ext->arg == NULL)) {
+			continue;
+		}
+		for (j = 0 ; j < num_certs ; j++) {
+			if ((certs[j].fn != NULL) &&
+			    cert_has_ext(&certs[j], i)) {
+				jobs[num_jobs++] = i;
+				break;
+			}
 		}
+	}
+	parallel_run(num_jobs, hash_job, jobs);
 
-		for (cert_ext = sk_X509_EXTENSION_pop(sk); cert_ext != NULL;
-				cert_ext = sk_X509_EXTENSION_pop(sk)) {
-			X509_EXTENSION_free(cert_ext);
+	/*
+	 * A certificate is signed after the certificate of its issuer if the
+	 * issuer comes first, before it otherwise.
+	 */
+	for (i = 0 ; i < num_certs ; i++) {
+		cert = &certs[i];
+		if (cert->fn == NULL) {
+			continue;
+		}
+		for (j = 0 ; j < i ; j++) {
+			if ((certs[j].fn != NULL) &&
+			    ((cert->issuer == j) || (certs[j].issuer == i)) &&
+			    (round[i] <= round[j])) {
+				round[i] = round[j] + 1;
+			}
+		}
+		if (round[i] + 1 > num_rounds) {
+			num_rounds = round[i] + 1;
 		}
+	}
 
-		sk_X509_EXTENSION_free(sk);
+	for (j = 0 ; j < num_rounds ; j++) {
+		num_jobs = 0;
+		for (i = 0 ; i < num_certs ; i++) {
+			if ((certs[i].fn != NULL) && (round[i] == j)) {
+				jobs[num_jobs++] = i;
+			}
+		}
+		parallel_run(num_jobs, cert_job, jobs);
 	}
 
+	free(ext_md);
+	ext_md = NULL;
+	free(round);
+	free(jobs);
+}
+
+static void save_certs(void)
+{
+	FILE *file;
+	int i;
 
 	/* Print the certificates */
 	if (print_cert) {
@@ -590,13 +699,208 @@ int main(int argc, char *argv[])
 			}
 		}
 	}
+}
 
-	/* If we got here, then we must have filled the key array completely.
-	 * We can then safely call free on all of the keys in the array
-	 */
+/* Create one set of certificates from the options parsed */
+static void create_cert_set(void)
+{
+	int i;
+
+	/* Select a reasonable default key-size */
+	if (key_size == -1) {
+		key_size = KEY_SIZES[key_alg][0];
+	}
+
+	/* Check command line arguments */
+	check_cmd_params();
+
+	/* Indicate SHA as image hash algorithm in the certificate
+	 * extension */
+	if (hash_alg == HASH_ALG_SHA384) {
+		md_info = EVP_sha384();
+		md_len  = SHA384_DIGEST_LENGTH;
+	} else if (hash_alg == HASH_ALG_SHA512) {
+		md_info = EVP_sha512();
+		md_len  = SHA512_DIGEST_LENGTH;
+	} else {
+		md_info = EVP_sha256();
+		md_len  = SHA256_DIGEST_LENGTH;
+	}
+
+	load_keys();
+	create_certs();
+	save_certs();
+
+	/* Free the keys and certificates, ready for the next set */
 	for (i = 0; i < num_keys; i++) {
 		EVP_PKEY_free(keys[i].key);
+		keys[i].key = NULL;
 	}
+	for (i = 0; i < num_certs; i++) {
+		X509_free(certs[i].x);
+		certs[i].x = NULL;
+	}
+}
+
+/*
+ * Restore the options given in the command line, freeing those given for the
+ * previous set of certificates.
+ */
+static void restore_cmd_opts(int saved_opts[], char *key_fn[],
+			     const char *ext_arg[], const char *cert_fn[])
+{
+	int i;
+
+	key_alg = saved_opts[0];
+	hash_alg = saved_opts[1];
+	key_size = saved_opts[2];
+	new_keys = saved_opts[3];
+	save_keys = saved_opts[4];
+	print_cert = saved_opts[5];
+
+	for (i = 0; i < num_keys; i++) {
+		if (keys[i].fn != key_fn[i]) {
+			free(keys[i].fn);
+			keys[i].fn = key_fn[i];
+		}
+	}
+	for (i = 0; i < num_extensions; i++) {
+		if (extensions[i].arg != ext_arg[i]) {
+			free((void *)extensions[i].arg);
+			extensions[i].arg = ext_arg[i];
+		}
+	}
+	for (i = 0; i < num_certs; i++) {
+		if (certs[i].fn != cert_fn[i]) {
+			free((void *)certs[i].fn);
+			certs[i].fn = cert_fn[i];
+		}
+	}
+}
+
+/*
+ * Create the sets of certificates given in a batch file. Each line holds the
+ * options of a set, added to the options given in the command line. Empty
+ * lines and lines starting with '#' are ignored. The keys loaded from files
+ * are shared by all the sets.
+ */
+static void run_batch(const char *batch_fn, char *prog)
+{
+	char line[BATCH_LINE_MAX_LEN];
+	char *argv[BATCH_MAX_ARGS + 1];
+	int saved_opts[6];
+	char **key_fn;
+	const char **ext_arg, **cert_fn;
+	FILE *file;
+	int i, argc, line_num = 0;
+
+	file = fopen(batch_fn, "r");
+	if (file == NULL) {
+		ERROR("Cannot open %s\n", batch_fn);
+		exit(1);
+	}
+
+	key_fn = malloc(num_keys * sizeof(*key_fn));
+	ext_arg = malloc(num_extensions * sizeof(*ext_arg));
+	cert_fn = malloc(num_certs * sizeof(*cert_fn));
+	if ((key_fn == NULL) || (ext_arg == NULL) || (cert_fn == NULL)) {
+		ERROR("%s:%d Failed to allocate memory.\n", __func__, __LINE__);
+		exit(1);
+	}
+
+	saved_opts[0] = key_alg;
+	saved_opts[1] = hash_alg;
+	saved_opts[2] = key_size;
+	saved_opts[3] = new_keys;
+	saved_opts[4] = save_keys;
+	saved_opts[5] = print_cert;
+	for (i = 0; i < num_keys; i++) {
+		key_fn[i] = keys[i].fn;
+	}
+	for (i = 0; i < num_extensions; i++) {
+		ext_arg[i] = extensions[i].arg;
+	}
+	for (i = 0; i < num_certs; i++) {
+		cert_fn[i] = certs[i].fn;
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		line_num++;
+		if (strchr(line, '\n') == NULL && !feof(file)) {
+			ERROR("%s:%d: line too long\n", batch_fn, line_num);
+			exit(1);
+		}
+
+		argv[0] = prog;
+		argc = 1;
+		for (argv[argc] = strtok(line, " \t\r\n"); argv[argc] != NULL;
+		     argv[argc] = strtok(NULL, " \t\r\n")) {
+			if (++argc > BATCH_MAX_ARGS) {
+				ERROR("%s:%d: too many options\n", batch_fn,
+				      line_num);
+				exit(1);
+			}
+		}
+		if ((argc == 1) || (argv[1][0] == '#')) {
+			continue;
+		}
+
+		NOTICE("Creating certificates of %s:%d\n", batch_fn, line_num);
+		parse_cmd_opts(argc, argv, 1);
+		create_cert_set();
+		restore_cmd_opts(saved_opts, key_fn, ext_arg, cert_fn);
+	}
+
+	fclose(file);
+	free(cert_fn);
+	free(ext_arg);
+	free(key_fn);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *batch_fn;
+	int i;
+
+	NOTICE("CoT Generation Tool: %s\n", build_msg);
+	NOTICE("Target platform: %s\n", platform_msg);
+
+	/* Set default options */
+	key_alg = KEY_ALG_RSA;
+	hash_alg = HASH_ALG_SHA256;
+	key_size = -1;
+
+	/* Add common command line options */
+	for (i = 0; i < NUM_ELEM(common_cmd_opt); i++) {
+		cmd_opt_add(&common_cmd_opt[i]);
+	}
+
+	/* Initialize the certificates */
+	if (cert_init() != 0) {
+		ERROR("Cannot initialize certificates\n");
+		exit(1);
+	}
+
+	/* Initialize the keys */
+	if (key_init() != 0) {
+		ERROR("Cannot initialize keys\n");
+		exit(1);
+	}
+
+	/* Initialize the new types and register OIDs for the extensions */
+	if (ext_init() != 0) {
+		ERROR("Cannot initialize extensions\n");
+		exit(1);
+	}
+
+	batch_fn = parse_cmd_opts(argc, argv, 0);
+	if (batch_fn != NULL) {
+		run_batch(batch_fn, argv[0]);
+	} else {
+		create_cert_set();
+	}
+
+	key_cache_free();
 
 #ifndef OPENSSL_NO_ENGINE
 	ENGINE_cleanup();
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "debug.h"
+#include "parallel.h"
+
+#define MAX_THREADS		64
+
+/* Maximum number of threads running the jobs, 0 for one per online CPU */
+static unsigned int max_threads;
+
+typedef struct pool_s {
+	parallel_job_t job;
+	void *arg;
+	unsigned int num_jobs;
+	unsigned int next;
+	pthread_mutex_t lock;
+} pool_t;
+
+void parallel_set_max_threads(unsigned int num)
+{
+	max_threads = num;
+}
+
+static void *worker(void *arg)
+{
+	pool_t *pool = arg;
+	unsigned int idx;
+
+	while (1) {
+		pthread_mutex_lock(&pool->lock);
+		idx = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+		if (idx >= pool->num_jobs) {
+			break;
+		}
+
+		pool->job(idx, pool->arg);
+	}
+
+	return NULL;
+}
+
+/*
+ * Run the jobs 0 to 'num_jobs' - 1 on a pool of threads, and return when all
+ * of them are done. The jobs may run in any order.
+ */
+void parallel_run(unsigned int num_jobs, parallel_job_t job, void *arg)
+{
+	pthread_t threads[MAX_THREADS - 1];
+	pool_t pool;
+	unsigned int num_threads = max_threads, i = 0;
+	long num_cpus;
+
+	if (num_threads == 0) {
+		num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		num_threads = (num_cpus > 1) ? (unsigned int)num_cpus : 1;
+	}
+	if (num_threads > MAX_THREADS) {
+		num_threads = MAX_THREADS;
+	}
+	if (num_threads > num_jobs) {
+		num_threads = num_jobs;
+	}
+
+	pool.job = job;
+	pool.arg = arg;
+	pool.num_jobs = num_jobs;
+	pool.next = 0;
+	pthread_mutex_init(&pool.lock, NULL);
+
+	/* The calling thread runs jobs too */
+	while (i + 1 < num_threads) {
+		if (pthread_create(&threads[i], NULL, worker, &pool) != 0) {
+			WARN("Cannot create thread, using %u threads only\n",
+			     i + 1);
+			break;
+		}
+		i++;
+	}
+	worker(&pool);
+
+	while (i > 0) {
+		pthread_join(threads[--i], NULL);
+	}
+	pthread_mutex_destroy(&pool.lock);
+}
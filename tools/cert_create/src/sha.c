@@ -1,55 +1,105 @@
 /*
- * Copyright (c) 2015-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
-#include <openssl/sha.h>
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+
 #include "debug.h"
 #include "key.h"
+#include "sha.h"
+
+#define BUFFER_SIZE	(1024 * 1024)
+
+static const EVP_MD *get_md(int md_alg)
+{
+	switch (md_alg) {
+	case HASH_ALG_SHA384:
+		return EVP_sha384();
+	case HASH_ALG_SHA512:
+		return EVP_sha512();
+	default:
+		return EVP_sha256();
+	}
+}
 
-#define BUFFER_SIZE	256
+/*
+ * Hash the file read in large chunks, for the files which cannot be mapped.
+ */
+static int sha_fd(const EVP_MD *md_info, int fd, unsigned char *md)
+{
+	EVP_MD_CTX *ctx;
+	unsigned char *data;
+	ssize_t bytes;
+	int rc = 0;
 
+	data = malloc(BUFFER_SIZE);
+	ctx = EVP_MD_CTX_create();
+	if ((data == NULL) || (ctx == NULL) ||
+	    !EVP_DigestInit_ex(ctx, md_info, NULL)) {
+		goto END;
+	}
+
+	while ((bytes = read(fd, data, BUFFER_SIZE)) > 0) {
+		if (!EVP_DigestUpdate(ctx, data, bytes)) {
+			goto END;
+		}
+	}
+
+	if ((bytes == 0) && EVP_DigestFinal_ex(ctx, md, NULL)) {
+		rc = 1;
+	}
+
+END:
+	EVP_MD_CTX_destroy(ctx);
+	free(data);
+	return rc;
+}
+
+/*
+ * Calculate the hash of a file. The file is mapped in memory and hashed in one
+ * go when possible. This function may be called concurrently.
+ */
 int sha_file(int md_alg, const char *filename, unsigned char *md)
 {
-	FILE *inFile;
-	SHA256_CTX shaContext;
-	SHA512_CTX sha512Context;
-	int bytes;
-	unsigned char data[BUFFER_SIZE];
+	const EVP_MD *md_info = get_md(md_alg);
+	struct stat st;
+	void *data;
+	int fd, rc;
 
 	if ((filename == NULL) || (md == NULL)) {
-		ERROR("%s(): NULL argument\n", __FUNCTION__);
+		ERROR("%s(): NULL argument\n", __func__);
 		return 0;
 	}
 
-	inFile = fopen(filename, "rb");
-	if (inFile == NULL) {
+	fd = open(filename, O_RDONLY);
+	if (fd == -1) {
 		ERROR("Cannot read %s\n", filename);
 		return 0;
 	}
 
-	if (md_alg == HASH_ALG_SHA384) {
-		SHA384_Init(&sha512Context);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-			SHA384_Update(&sha512Context, data, bytes);
-		}
-		SHA384_Final(md, &sha512Context);
-	} else if (md_alg == HASH_ALG_SHA512) {
-		SHA512_Init(&sha512Context);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-			SHA512_Update(&sha512Context, data, bytes);
-		}
-		SHA512_Final(md, &sha512Context);
+	data = MAP_FAILED;
+	if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+		data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+
+	if (data != MAP_FAILED) {
+		rc = EVP_Digest(data, st.st_size, md, NULL, md_info, NULL);
+		munmap(data, st.st_size);
 	} else {
-		SHA256_Init(&shaContext);
-		while ((bytes = fread(data, 1, BUFFER_SIZE, inFile)) != 0) {
-			SHA256_Update(&shaContext, data, bytes);
-		}
-		SHA256_Final(md, &shaContext);
+		rc = sha_fd(md_info, fd, md);
 	}
 
-	fclose(inFile);
-	return 1;
+	close(fd);
+	return rc;
 }
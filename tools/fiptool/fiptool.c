@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -23,6 +23,23 @@
 #define OPT_PLAT_TOC_FLAGS 1
 #define OPT_ALIGN 2
 
+/* Maximum number of threads computing the image digests. */
+#define MAX_DIGEST_THREADS 16
+
+/*
+ * An input file. On Posix hosts, the file is mmap()ed so that only the parts
+ * used are read, and images are copied from it to the output file within the
+ * kernel when possible.
+ */
+typedef struct file_map {
+	FILE            *fp;
+	void            *base;
+	size_t           size;
+	int              mapped;
+	struct BLD_PLAT_STAT st;
+	struct file_map *next;
+} file_map_t;
+
 static int info_cmd(int argc, char *argv[]);
 static void info_usage(int);
 static int create_cmd(int argc, char *argv[]);
@@ -51,6 +68,7 @@ static cmd_t cmds[] = {
 
 static image_desc_t *image_desc_head;
 static size_t nr_image_descs;
+static file_map_t *file_map_head;
 static const uuid_t uuid_null;
 static int verbose;
 
@@ -134,6 +152,69 @@ static void xfwrite(void *buf, size_t size, FILE *fp, const char *filename)
 		log_errx("Failed to write %s", filename);
 }
 
+static file_map_t *map_file(const char *filename)
+{
+	file_map_t *map;
+
+	map = xzalloc(sizeof(*map), "failed to allocate memory for file map");
+	map->fp = fopen(filename, "rb");
+	if (map->fp == NULL)
+		log_err("fopen %s", filename);
+
+	if (fstat(fileno(map->fp), &map->st) == -1)
+		log_err("fstat %s", filename);
+	map->size = map->st.st_size;
+
+#ifndef _MSC_VER
+	if (map->size != 0) {
+		map->base = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE,
+		    fileno(map->fp), 0);
+		map->mapped = (map->base != MAP_FAILED);
+	}
+#endif
+	if (!map->mapped) {
+		map->base = xmalloc(map->size,
+		    "failed to load file into memory");
+		if (fread(map->base, 1, map->size, map->fp) != map->size)
+			log_errx("Failed to read %s", filename);
+	}
+
+	map->next = file_map_head;
+	file_map_head = map;
+	return map;
+}
+
+static void free_file_maps(void)
+{
+	file_map_t *map = file_map_head, *tmp;
+
+	while (map != NULL) {
+		tmp = map->next;
+#ifndef _MSC_VER
+		if (map->mapped)
+			munmap(map->base, map->size);
+		else
+#endif
+			free(map->base);
+		fclose(map->fp);
+		free(map);
+		map = tmp;
+	}
+	file_map_head = NULL;
+}
+
+static int is_same_file(const file_map_t *map, const struct BLD_PLAT_STAT *st)
+{
+	return map->st.st_dev == st->st_dev && map->st.st_ino == st->st_ino;
+}
+
+static void free_image(image_t *image)
+{
+	if (image->map == NULL)
+		free(image->buffer);
+	free(image);
+}
+
 static image_desc_t *new_image_desc(const uuid_t *uuid,
     const char *name, const char *cmdline_name)
 {
@@ -169,10 +250,8 @@ static void free_image_desc(image_desc_t *desc)
 	free(desc->name);
 	free(desc->cmdline_name);
 	free(desc->action_arg);
-	if (desc->image) {
-		free(desc->image->buffer);
-		free(desc->image);
-	}
+	if (desc->image)
+		free_image(desc->image);
 	free(desc);
 }
 
@@ -292,27 +371,18 @@ static void uuid_from_str(uuid_t *u, const char *s)
 
 static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 {
-	struct BLD_PLAT_STAT st;
-	FILE *fp;
+	file_map_t *map;
 	char *buf, *bufend;
 	fip_toc_header_t *toc_header;
 	fip_toc_entry_t *toc_entry;
 	int terminated = 0;
 
-	fp = fopen(filename, "rb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
-
-	if (fstat(fileno(fp), &st) == -1)
-		log_err("fstat %s", filename);
-
-	buf = xmalloc(st.st_size, "failed to load file into memory");
-	if (fread(buf, 1, st.st_size, fp) != st.st_size)
-		log_errx("Failed to read %s", filename);
-	bufend = buf + st.st_size;
-	fclose(fp);
+	/* The images are not copied, they point into the mapped FIP. */
+	map = map_file(filename);
+	buf = map->base;
+	bufend = buf + map->size;
 
-	if (st.st_size < sizeof(fip_toc_header_t))
+	if (map->size < sizeof(fip_toc_header_t))
 		log_errx("FIP %s is truncated", filename);
 
 	toc_header = (fip_toc_header_t *)buf;
@@ -343,16 +413,15 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 		image = xzalloc(sizeof(*image),
 		    "failed to allocate memory for image");
 		image->toc_e = *toc_entry;
-		image->buffer = xmalloc(toc_entry->size,
-		    "failed to allocate image buffer, is FIP file corrupted?");
-		/* Overflow checks before memory copy. */
+		/* Overflow checks before pointing into the FIP. */
 		if (toc_entry->size > (uint64_t)-1 - toc_entry->offset_address)
 			log_errx("FIP %s is corrupted", filename);
-		if (toc_entry->size + toc_entry->offset_address > st.st_size)
+		if (toc_entry->size + toc_entry->offset_address > map->size)
 			log_errx("FIP %s is corrupted", filename);
 
-		memcpy(image->buffer, buf + toc_entry->offset_address,
-		    toc_entry->size);
+		image->buffer = buf + toc_entry->offset_address;
+		image->map = map;
+		image->map_offset = toc_entry->offset_address;
 
 		/* If this is an unknown image, create a descriptor for it. */
 		desc = lookup_image_desc_from_uuid(&toc_entry->uuid);
@@ -378,37 +447,74 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 	if (terminated == 0)
 		log_errx("FIP %s does not have a ToC terminator entry",
 		    filename);
-	free(buf);
 	return 0;
 }
 
 static image_t *read_image_from_file(const uuid_t *uuid, const char *filename)
 {
-	struct BLD_PLAT_STAT st;
 	image_t *image;
-	FILE *fp;
+	file_map_t *map;
 
 	assert(uuid != NULL);
 	assert(filename != NULL);
 
-	fp = fopen(filename, "rb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
-
-	if (fstat(fileno(fp), &st) == -1)
-		log_errx("fstat %s", filename);
+	map = map_file(filename);
 
 	image = xzalloc(sizeof(*image), "failed to allocate memory for image");
 	image->toc_e.uuid = *uuid;
-	image->buffer = xmalloc(st.st_size, "failed to allocate image buffer");
-	if (fread(image->buffer, 1, st.st_size, fp) != st.st_size)
-		log_errx("Failed to read %s", filename);
-	image->toc_e.size = st.st_size;
-
-	fclose(fp);
+	image->toc_e.size = map->size;
+	image->buffer = map->base;
+	image->map = map;
+	image->map_offset = 0;
 	return image;
 }
 
+/*
+ * Write an image at 'offset' in the output file. When the image comes from a
+ * file, it is copied within the kernel if possible, which also lets the file
+ * systems supporting it share the data blocks instead of copying them.
+ */
+static void write_image(const image_t *image, uint64_t offset, FILE *fp,
+    const char *filename)
+{
+	uint64_t done = 0;
+
+#ifdef HAVE_COPY_FILE_RANGE
+	if (image->map != NULL && image->map->mapped) {
+		loff_t off_in = image->map_offset, off_out = offset;
+
+		if (fflush(fp) != 0)
+			log_err("Failed to write %s", filename);
+		while (done < image->toc_e.size) {
+			ssize_t ret;
+
+			ret = copy_file_range(fileno(image->map->fp), &off_in,
+			    fileno(fp), &off_out, image->toc_e.size - done, 0);
+			if (ret <= 0)
+				break;
+			done += ret;
+		}
+		if (done == image->toc_e.size)
+			return;
+		/* Not supported for these files, write what is left. */
+	}
+#endif
+	if (fseek(fp, offset + done, SEEK_SET))
+		log_errx("Failed to set file position");
+	xfwrite((char *)image->buffer + done, image->toc_e.size - done, fp,
+	    filename);
+}
+
+static void write_zeros(uint64_t offset, uint64_t size, FILE *fp,
+    const char *filename)
+{
+	if (fseek(fp, offset, SEEK_SET))
+		log_errx("Failed to set file position");
+	while (size--)
+		if (fputc(0x0, fp) == EOF)
+			log_errx("Failed to write %s", filename);
+}
+
 static int write_image_to_file(const image_t *image, const char *filename)
 {
 	FILE *fp;
@@ -416,11 +522,39 @@ static int write_image_to_file(const image_t *image, const char *filename)
 	fp = fopen(filename, "wb");
 	if (fp == NULL)
 		log_err("fopen");
-	xfwrite(image->buffer, image->toc_e.size, fp, filename);
+	write_image(image, 0, fp, filename);
 	fclose(fp);
 	return 0;
 }
 
+/*
+ * Images mapped from the file about to be overwritten must be read before it
+ * is truncated.
+ */
+static void detach_images(const char *filename)
+{
+	struct BLD_PLAT_STAT st;
+	image_desc_t *desc;
+
+	if (stat(filename, &st) == -1)
+		return;
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image = desc->image;
+		void *buffer;
+
+		if (image == NULL || image->map == NULL ||
+		    !image->map->mapped || !is_same_file(image->map, &st))
+			continue;
+
+		buffer = xmalloc(image->toc_e.size,
+		    "failed to allocate image buffer");
+		memcpy(buffer, image->buffer, image->toc_e.size);
+		image->buffer = buffer;
+		image->map = NULL;
+	}
+}
+
 static struct option *add_opt(struct option *opts, size_t *nr_opts,
     const char *name, int has_arg, int val)
 {
@@ -454,10 +588,79 @@ static void md_print(const unsigned char *md, size_t len)
 		printf("%02x", md[i]);
 }
 
+#ifndef _MSC_VER	/* We don't have SHA256 for Visual Studio. */
+typedef struct digest_pool {
+	image_t        **images;
+	unsigned char  (*md)[SHA256_DIGEST_LENGTH];
+	size_t           nr_images;
+	size_t           next;
+	pthread_mutex_t  lock;
+} digest_pool_t;
+
+static void *digest_worker(void *arg)
+{
+	digest_pool_t *pool = arg;
+
+	while (1) {
+		size_t i;
+
+		pthread_mutex_lock(&pool->lock);
+		i = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+		if (i >= pool->nr_images)
+			break;
+
+		SHA256(pool->images[i]->buffer, pool->images[i]->toc_e.size,
+		    pool->md[i]);
+	}
+	return NULL;
+}
+
+/* Compute the SHA256 digests of the images, on as many threads as CPUs. */
+static void compute_digests(image_t **images, size_t nr_images,
+    unsigned char (*md)[SHA256_DIGEST_LENGTH])
+{
+	pthread_t threads[MAX_DIGEST_THREADS - 1];
+	digest_pool_t pool = {
+		.images = images,
+		.md = md,
+		.nr_images = nr_images,
+		.next = 0,
+	};
+	size_t nr_threads = 0, max_threads;
+	long nr_cpus;
+
+	nr_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	max_threads = (nr_cpus > 1) ? (size_t)nr_cpus : 1;
+	if (max_threads > MAX_DIGEST_THREADS)
+		max_threads = MAX_DIGEST_THREADS;
+	if (max_threads > nr_images)
+		max_threads = nr_images;
+
+	pthread_mutex_init(&pool.lock, NULL);
+	/* The calling thread is one of the workers. */
+	while (nr_threads + 1 < max_threads) {
+		if (pthread_create(&threads[nr_threads], NULL, digest_worker,
+		    &pool) != 0)
+			break;
+		nr_threads++;
+	}
+	digest_worker(&pool);
+	while (nr_threads > 0)
+		pthread_join(threads[--nr_threads], NULL);
+	pthread_mutex_destroy(&pool.lock);
+}
+#endif
+
 static int info_cmd(int argc, char *argv[])
 {
 	image_desc_t *desc;
 	fip_toc_header_t toc_header;
+#ifndef _MSC_VER
+	unsigned char (*md)[SHA256_DIGEST_LENGTH] = NULL;
+	image_t **images = NULL;
+	size_t nr_images = 0;
+#endif
 
 	if (argc != 2)
 		info_usage(EXIT_FAILURE);
@@ -474,6 +677,20 @@ static int info_cmd(int argc, char *argv[])
 		    (unsigned long long)toc_header.flags);
 	}
 
+#ifndef _MSC_VER
+	if (verbose) {
+		images = xmalloc(nr_image_descs * sizeof(*images),
+		    "failed to allocate memory for images");
+		md = xmalloc(nr_image_descs * sizeof(*md),
+		    "failed to allocate memory for digests");
+		for (desc = image_desc_head; desc != NULL; desc = desc->next)
+			if (desc->image != NULL)
+				images[nr_images++] = desc->image;
+		compute_digests(images, nr_images, md);
+		nr_images = 0;
+	}
+#endif
+
 	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
 		image_t *image = desc->image;
 
@@ -486,16 +703,17 @@ static int info_cmd(int argc, char *argv[])
 		       desc->cmdline_name);
 #ifndef _MSC_VER	/* We don't have SHA256 for Visual Studio. */
 		if (verbose) {
-			unsigned char md[SHA256_DIGEST_LENGTH];
-
-			SHA256(image->buffer, image->toc_e.size, md);
 			printf(", sha256=");
-			md_print(md, sizeof(md));
+			md_print(md[nr_images++], sizeof(*md));
 		}
 #endif
 		putchar('\n');
 	}
 
+#ifndef _MSC_VER
+	free(images);
+	free(md);
+#endif
 	return 0;
 }
 
@@ -505,6 +723,76 @@ static void info_usage(int exit_status)
 	exit(exit_status);
 }
 
+#ifndef _MSC_VER
+/*
+ * Update the FIP in place when it is the input FIP and the images it already
+ * contains keep their offsets, so that only the ToC and the images added or
+ * replaced are written. Return 0 on success, -1 if the FIP must be repacked.
+ */
+static int update_fip_in_place(const char *filename, const char *toc,
+    uint64_t toc_size, uint64_t fip_size)
+{
+	struct BLD_PLAT_STAT st;
+	file_map_t *map = NULL;
+	image_desc_t *desc;
+	uint64_t offset;
+	FILE *fp;
+
+	if (stat(filename, &st) == -1)
+		return -1;
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image = desc->image;
+
+		if (image == NULL || image->map == NULL ||
+		    !is_same_file(image->map, &st))
+			continue;
+		if (!image->map->mapped ||
+		    image->map_offset != image->toc_e.offset_address)
+			return -1;
+		map = image->map;
+	}
+	if (map == NULL)
+		return -1;
+
+	fp = fopen(filename, "r+b");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	if (verbose)
+		log_dbgx("Updating %s in place", filename);
+
+	if (map->size < toc_size || memcmp(map->base, toc, toc_size) != 0) {
+		if (fseek(fp, 0, SEEK_SET))
+			log_errx("Failed to set file position");
+		xfwrite((void *)toc, toc_size, fp, filename);
+	}
+
+	offset = toc_size;
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image = desc->image;
+
+		if (image == NULL)
+			continue;
+		write_zeros(offset, image->toc_e.offset_address - offset, fp,
+		    filename);
+		if (image->map != map) {
+			if (verbose)
+				log_dbgx("Writing %s", desc->cmdline_name);
+			write_image(image, image->toc_e.offset_address, fp,
+			    filename);
+		}
+		offset = image->toc_e.offset_address + image->toc_e.size;
+	}
+	write_zeros(offset, fip_size - offset, fp, filename);
+
+	if (fflush(fp) != 0 || ftruncate(fileno(fp), fip_size) == -1)
+		log_err("Failed to write %s", filename);
+	fclose(fp);
+	return 0;
+}
+#endif
+
 static int pack_images(const char *filename, uint64_t toc_flags, unsigned long align)
 {
 	FILE *fp;
@@ -554,7 +842,16 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 	memset(toc_entry, 0, sizeof(*toc_entry));
 	toc_entry->offset_address = (entry_offset + align - 1) & ~(align - 1);
 
+#ifndef _MSC_VER
+	if (update_fip_in_place(filename, buf, buf_size,
+	    toc_entry->offset_address) == 0) {
+		free(buf);
+		return 0;
+	}
+#endif
+
 	/* Generate the FIP file. */
+	detach_images(filename);
 	fp = fopen(filename, "wb");
 	if (fp == NULL)
 		log_err("fopen %s", filename);
@@ -572,18 +869,11 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 
 		if (image == NULL)
 			continue;
-		if (fseek(fp, image->toc_e.offset_address, SEEK_SET))
-			log_errx("Failed to set file position");
-
-		xfwrite(image->buffer, image->toc_e.size, fp, filename);
+		write_image(image, image->toc_e.offset_address, fp, filename);
 	}
 
-	if (fseek(fp, entry_offset, SEEK_SET))
-		log_errx("Failed to set file position");
-
 	pad_size = toc_entry->offset_address - entry_offset;
-	while (pad_size--)
-		fputc(0x0, fp);
+	write_zeros(entry_offset, pad_size, fp, filename);
 
 	free(buf);
 	fclose(fp);
@@ -616,7 +906,7 @@ static void update_fip(void)
 				    desc->cmdline_name,
 				    desc->action_arg);
 			}
-			free(desc->image);
+			free_image(desc->image);
 			desc->image = image;
 		} else {
 			if (verbose)
@@ -1128,7 +1418,7 @@ static int remove_cmd(int argc, char *argv[])
 			if (verbose)
 				log_dbgx("Removing %s",
 				    desc->cmdline_name);
-			free(desc->image);
+			free_image(desc->image);
 			desc->image = NULL;
 		} else {
 			log_warnx("%s does not exist in %s",
@@ -1262,5 +1552,6 @@ int main(int argc, char *argv[])
 	if (i == NELEM(cmds))
 		usage();
 	free_image_descs();
+	free_file_maps();
 	return ret;
 }
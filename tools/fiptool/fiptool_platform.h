@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,10 +17,18 @@
 /* Not Visual Studio, so include Posix Headers. */
 # include <getopt.h>
 # include <openssl/sha.h>
+# include <pthread.h>
+# include <sys/mman.h>
 # include <unistd.h>
 
 # define  BLD_PLAT_STAT stat
 
+/* copy_file_range() is available from glibc 2.27. */
+# if defined(__linux__) && defined(__GLIBC__) && \
+     (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#  define HAVE_COPY_FILE_RANGE
+# endif
+
 #else
 
 /* Visual Studio. */
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MMIO_SIM_H
+#define MMIO_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * A simulated register. Every address the firmware touches behaves as RAM,
+ * a register only needs to be described when it has a non-zero reset value,
+ * a latency different from the default one or when it should be reported
+ * by name.
+ */
+struct mmio_sim_reg {
+	const char *name;
+	uintptr_t addr;
+	uint32_t reset;
+	/* Modelled cost of an access, 0 for the default latency */
+	unsigned int read_ns;
+	unsigned int write_ns;
+};
+
+/*
+ * Scripted response of the hardware: a 32-bit write of 'addr' with
+ * (value & mask) == match updates 'target' 'delay_ns' of modelled time
+ * later, clearing then setting the given bits. This is how status bits that
+ * the firmware polls for are set and cleared.
+ */
+struct mmio_sim_rule {
+	uintptr_t addr;
+	uint32_t mask;
+	uint32_t match;
+	uintptr_t target;
+	uint32_t clear;
+	uint32_t set;
+	uint64_t delay_ns;
+};
+
+/* 'bits' of 'addr', once written to 1, are cleared by the hardware */
+#define MMIO_SIM_SELF_CLEAR(_addr, _bits, _delay_ns)			\
+	{								\
+		.addr = (_addr), .mask = (_bits), .match = (_bits),	\
+		.target = (_addr), .clear = (_bits),			\
+		.delay_ns = (_delay_ns),				\
+	}
+
+/* 'ack' of 'target' follows 'req' of 'addr' */
+#define MMIO_SIM_HANDSHAKE(_addr, _req, _target, _ack, _delay_ns)	\
+	{								\
+		.addr = (_addr), .mask = (_req), .match = (_req),	\
+		.target = (_target), .set = (_ack),			\
+		.delay_ns = (_delay_ns),				\
+	},								\
+	{								\
+		.addr = (_addr), .mask = (_req), .match = 0U,		\
+		.target = (_target), .clear = (_ack),			\
+		.delay_ns = (_delay_ns),				\
+	}
+
+struct mmio_sim_scenario {
+	const char *name;
+	const char *help;
+	const struct mmio_sim_reg *regs;
+	unsigned int num_regs;
+	const struct mmio_sim_rule *rules;
+	unsigned int num_rules;
+	/* Optional, called once after the registers are reset */
+	void (*setup)(void);
+	/* One iteration of the code path under measure */
+	void (*run)(unsigned int iteration);
+};
+
+/* Counters of one run of a scenario */
+struct mmio_sim_stats {
+	uint64_t reads;
+	uint64_t writes;
+	/* Reads of the register read just before, i.e. poll iterations */
+	uint64_t polls;
+	/* Pages of simulated memory the scenario touched */
+	uint64_t pages;
+	uint64_t delay_ns;
+	uint64_t time_ns;
+};
+
+#define MMIO_SIM_DEFAULT_READ_NS	100U
+#define MMIO_SIM_DEFAULT_WRITE_NS	50U
+
+/* Platform scenarios, from plat/<plat>/ */
+extern const struct mmio_sim_scenario mmio_sim_scenarios[];
+extern const unsigned int mmio_sim_num_scenarios;
+
+int mmio_sim_init(void);
+void mmio_sim_reset(const struct mmio_sim_scenario *scenario);
+int mmio_sim_run(const struct mmio_sim_scenario *scenario,
+		 unsigned int iterations, struct mmio_sim_stats *stats);
+void mmio_sim_print_registers(unsigned int max_regs);
+
+void mmio_sim_set_trace(bool trace);
+void mmio_sim_set_poll_limit(uint64_t limit);
+
+/* Stop the current scenario, e.g. when the firmware panics */
+void mmio_sim_abort(void) __attribute__((noreturn));
+
+/* Messages of the firmware up to this level are printed */
+extern unsigned int mmio_sim_log_level;
+
+/* Modelled time, advanced by the accesses and the delays */
+uint64_t mmio_sim_now_ns(void);
+void mmio_sim_delay_ns(uint64_t ns);
+
+#endif /* MMIO_SIM_H */
@@ -0,0 +1,238 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <context.h>
+#include <lib/bakery_lock.h>
+#include <lib/utils_def.h>
+#include <platform_def.h>
+
+#include <dram.h>
+#include <gpc.h>
+#include <imx_sip_svc.h>
+#include <plat_imx8.h>
+
+#include "mmio_sim.h"
+
+/* pu_domain_id of gpc.c */
+#define PD_GPUMIX		4U
+#define PD_VPUMIX		5U
+#define PD_VPU_G1		6U
+
+#define PU_PGC_UP		(IMX_GPC_BASE + PU_PGC_UP_TRG)
+#define PU_PGC_DN		(IMX_GPC_BASE + PU_PGC_DN_TRG)
+#define PU_PWRHSK		(IMX_GPC_BASE + GPC_PU_PWRHSK)
+
+/* Sizes similar to the PHY tables of an LPDDR4 board */
+#define PHY_CFG_NUM		96U
+#define PHY_TRAINED_CSR_NUM	768U
+#define PHY_PIE_NUM		640U
+
+/* Reached from gpc.c, outside of the simulated paths */
+struct plat_gic_ctx imx_gicv3_ctx;
+
+void imx_noc_slot_config(bool pdn)
+{
+}
+
+void plat_gic_save(unsigned int proc_num, struct plat_gic_ctx *ctx)
+{
+}
+
+void plat_gic_restore(unsigned int proc_num, struct plat_gic_ctx *ctx)
+{
+}
+
+static cpu_context_t smc_ctx;
+
+static struct dram_cfg_param phy_cfg[PHY_CFG_NUM];
+static struct dram_cfg_param phy_trained_csr[PHY_TRAINED_CSR_NUM];
+static struct dram_cfg_param phy_pie[PHY_PIE_NUM];
+
+/* 3000MTS, 400MTS and 100MTS, the last two in PLL bypass mode */
+static struct dram_timing_info timing = {
+	.ddrphy_cfg = phy_cfg,
+	.ddrphy_cfg_num = PHY_CFG_NUM,
+	.ddrphy_trained_csr = phy_trained_csr,
+	.ddrphy_trained_csr_num = PHY_TRAINED_CSR_NUM,
+	.ddrphy_pie = phy_pie,
+	.ddrphy_pie_num = PHY_PIE_NUM,
+	.fsp_table = { 3000, 400, 100, },
+};
+
+static const struct mmio_sim_reg ddrc_regs[] = {
+	/* LPDDR4, two ranks, booted at FSP0 */
+	{ "DDRC_MSTR", DDRC_MSTR(0), 0x03080020, 0, 0 },
+	{ "DDRC_STAT", DDRC_STAT(0), 0x1, 150, 0 },
+	{ "DDRC_MRSTAT", DDRC_MRSTAT(0), 0x0, 150, 0 },
+	{ "DDRC_MRCTRL0", DDRC_MRCTRL0(0), 0x0, 0, 0 },
+	{ "DDRC_PWRCTL", DDRC_PWRCTL(0), 0x1, 0, 0 },
+	{ "DDRC_DFIMISC", DDRC_DFIMISC(0), 0x0, 0, 0 },
+	{ "DDRC_DFISTAT", DDRC_DFISTAT(0), 0x1, 150, 0 },
+	{ "DDRC_DBGCAM", DDRC_DBGCAM(0), 0x30000000, 150, 0 },
+	{ "DDRC_DBGCMD", DDRC_DBGCMD(0), 0x0, 0, 0 },
+	{ "DDRC_DBGSTAT", DDRC_DBGSTAT(0), 0x0, 150, 0 },
+	{ "DDRC_SWCTL", DDRC_SWCTL(0), 0x1, 0, 0 },
+	{ "DDRC_SWSTAT", DDRC_SWSTAT(0), 0x1, 150, 0 },
+	{ "DDRC_PSTAT", DDRC_PSTAT(0), 0x0, 150, 0 },
+	{ "DDRC_INIT3", DDRC_INIT3(0), 0x00540036, 0, 0 },
+	{ "DDRC_INIT4", DDRC_INIT4(0), 0x00310000, 0, 0 },
+	{ "DDRC_INIT6", DDRC_INIT6(0), 0x0066004d, 0, 0 },
+	{ "DDRC_INIT7", DDRC_INIT7(0), 0x0016004d, 0, 0 },
+	{ "DDRC_FREQ1_INIT3", DDRC_FREQ1_INIT3(0), 0x00140009, 0, 0 },
+	{ "DDRC_FREQ1_INIT4", DDRC_FREQ1_INIT4(0), 0x00310000, 0, 0 },
+	{ "DDRC_FREQ1_INIT6", DDRC_FREQ1_INIT6(0), 0x0066004d, 0, 0 },
+	{ "DDRC_FREQ1_INIT7", DDRC_FREQ1_INIT7(0), 0x0016004d, 0, 0 },
+	{ "DDRC_FREQ2_INIT3", DDRC_FREQ2_INIT3(0), 0x00140009, 0, 0 },
+	{ "DDRC_FREQ2_INIT4", DDRC_FREQ2_INIT4(0), 0x00310000, 0, 0 },
+	{ "DDRC_FREQ2_INIT6", DDRC_FREQ2_INIT6(0), 0x0066004d, 0, 0 },
+	{ "DDRC_FREQ2_INIT7", DDRC_FREQ2_INIT7(0), 0x0016004d, 0, 0 },
+	{ "DRAM_PLL_CTRL", DRAM_PLL_CTRL, BIT(31) | BIT(9), 0, 0 },
+};
+
+static const struct mmio_sim_rule ddrc_rules[] = {
+	/* Mode register write */
+	{ DDRC_MRCTRL0(0), BIT(31), BIT(31), DDRC_MRSTAT(0), 0, 0x1, 0 },
+	{ DDRC_MRCTRL0(0), BIT(31), BIT(31), DDRC_MRSTAT(0), 0x1, 0, 300 },
+	MMIO_SIM_SELF_CLEAR(DDRC_MRCTRL0(0), BIT(31), 300),
+	/* PWRCTL.selfref_sw and stay_in_selfref move STAT.selfref_state */
+	{ DDRC_PWRCTL(0), 0x60, 0x60, DDRC_STAT(0), 0x307, 0x103, 1000 },
+	{ DDRC_PWRCTL(0), 0x60, 0x20, DDRC_STAT(0), 0x307, 0x203, 1000 },
+	{ DDRC_PWRCTL(0), 0x60, 0x40, DDRC_STAT(0), 0x307, 0x303, 1000 },
+	{ DDRC_PWRCTL(0), 0x60, 0x00, DDRC_STAT(0), 0x307, 0x001, 1000 },
+	/* DFIMISC.dfi_init_start deasserts DFISTAT.dfi_init_complete */
+	{ DDRC_DFIMISC(0), 0x20, 0x20, DDRC_DFISTAT(0), 0x1, 0, 200 },
+	{ DDRC_DFIMISC(0), 0x20, 0x00, DDRC_DFISTAT(0), 0, 0x1, 200 },
+	/* Quasi dynamic register programming */
+	{ DDRC_SWCTL(0), 0x1, 0x1, DDRC_SWSTAT(0), 0, 0x1, 100 },
+	{ DDRC_SWCTL(0), 0x1, 0x0, DDRC_SWSTAT(0), 0x1, 0, 0 },
+	/* ZQ calibration */
+	{ DDRC_DBGCMD(0), 0x10, 0x10, DDRC_DBGSTAT(0), 0, 0x10, 0 },
+	{ DDRC_DBGCMD(0), 0x10, 0x10, DDRC_DBGSTAT(0), 0x10, 0, 1000 },
+	MMIO_SIM_SELF_CLEAR(DDRC_DBGCMD(0), 0x10, 1000),
+	/* DRAM PLL locks 20us after it is powered up */
+	{ DRAM_PLL_CTRL, BIT(9), BIT(9), DRAM_PLL_CTRL, 0, BIT(31), 20000 },
+	{ DRAM_PLL_CTRL, BIT(9), 0, DRAM_PLL_CTRL, BIT(31), 0, 0 },
+};
+
+static void dram_dvfs_setup(void)
+{
+	dram_info_init((unsigned long)&timing);
+}
+
+/* Switch between 3000MTS and 400MTS, as a DDR DVFS SiP call from core 0 */
+static void dram_dvfs_run(unsigned int iteration)
+{
+	u_register_t fsp_index = ((iteration & 1U) == 0U) ? 1U : 0U;
+
+	dram_dvfs_handler(IMX_SIP_DDR_DVFS, &smc_ctx, fsp_index, 0x1, 0);
+}
+
+static void dram_phy_setup(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < PHY_CFG_NUM; i++) {
+		phy_cfg[i].reg = 0x100a0U + ((i / 8U) << 12) + (i % 8U);
+		phy_cfg[i].val = i;
+	}
+
+	for (i = 0U; i < PHY_TRAINED_CSR_NUM; i++) {
+		phy_trained_csr[i].reg = 0x200b2U + ((i / 32U) << 12) +
+					 (i % 32U);
+		phy_trained_csr[i].val = i;
+	}
+
+	for (i = 0U; i < PHY_PIE_NUM; i++) {
+		phy_pie[i].reg = 0x90000U + i;
+		phy_pie[i].val = i;
+	}
+}
+
+/* Restore of the PHY configuration on resume from DDR retention */
+static void dram_phy_run(unsigned int iteration)
+{
+	dram_phy_init(&timing);
+}
+
+static const struct mmio_sim_rule gpc_rules[] = {
+	MMIO_SIM_SELF_CLEAR(PU_PGC_UP, GPUMIX_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_UP, GPU2D_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_UP, GPU3D_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_UP, VPUMIX_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_UP, VPU_G1_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_DN, GPUMIX_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_DN, GPU2D_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_DN, GPU3D_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_DN, VPUMIX_PWR_REQ, 5000),
+	MMIO_SIM_SELF_CLEAR(PU_PGC_DN, VPU_G1_PWR_REQ, 5000),
+	MMIO_SIM_HANDSHAKE(PU_PWRHSK, GPUMIX_ADB400_SYNC,
+			   PU_PWRHSK, GPUMIX_ADB400_ACK, 1000),
+	MMIO_SIM_HANDSHAKE(PU_PWRHSK, GPU2D_ADB400_SYNC,
+			   PU_PWRHSK, GPU2D_ADB400_ACK, 1000),
+	MMIO_SIM_HANDSHAKE(PU_PWRHSK, GPU3D_ADB400_SYNC,
+			   PU_PWRHSK, GPU3D_ADB400_ACK, 1000),
+	MMIO_SIM_HANDSHAKE(PU_PWRHSK, VPUMIX_ADB400_SYNC,
+			   PU_PWRHSK, VPUMIX_ADB400_ACK, 1000),
+};
+
+static const struct mmio_sim_reg gpc_regs[] = {
+	{ "PU_PGC_UP_TRG", PU_PGC_UP, 0x0, 0, 0 },
+	{ "PU_PGC_DN_TRG", PU_PGC_DN, 0x0, 0, 0 },
+	{ "GPC_PU_PWRHSK", PU_PWRHSK, 0x0, 0, 0 },
+};
+
+static void gpc_gpumix_run(unsigned int iteration)
+{
+	imx_gpc_pm_domain_enable(PD_GPUMIX, true);
+	imx_gpc_pm_domain_enable(PD_GPUMIX, false);
+}
+
+static void gpc_vpu_run(unsigned int iteration)
+{
+	imx_gpc_pm_domain_enable(PD_VPUMIX, true);
+	imx_gpc_pm_domain_enable(PD_VPU_G1, true);
+	imx_gpc_pm_domain_enable(PD_VPU_G1, false);
+	imx_gpc_pm_domain_enable(PD_VPUMIX, false);
+}
+
+const struct mmio_sim_scenario mmio_sim_scenarios[] = {
+	{
+		.name = "dram_dvfs",
+		.help = "DDR DVFS SiP call, LPDDR4 3000MTS <-> 400MTS",
+		.regs = ddrc_regs,
+		.num_regs = ARRAY_SIZE(ddrc_regs),
+		.rules = ddrc_rules,
+		.num_rules = ARRAY_SIZE(ddrc_rules),
+		.setup = dram_dvfs_setup,
+		.run = dram_dvfs_run,
+	},
+	{
+		.name = "dram_phy_init",
+		.help = "Restore of the DDR PHY configuration",
+		.setup = dram_phy_setup,
+		.run = dram_phy_run,
+	},
+	{
+		.name = "gpc_gpumix",
+		.help = "GPUMIX power domain on and off",
+		.regs = gpc_regs,
+		.num_regs = ARRAY_SIZE(gpc_regs),
+		.rules = gpc_rules,
+		.num_rules = ARRAY_SIZE(gpc_rules),
+		.run = gpc_gpumix_run,
+	},
+	{
+		.name = "gpc_vpu",
+		.help = "VPUMIX and VPU_G1 power domains on and off",
+		.regs = gpc_regs,
+		.num_regs = ARRAY_SIZE(gpc_regs),
+		.rules = gpc_rules,
+		.num_rules = ARRAY_SIZE(gpc_rules),
+		.run = gpc_vpu_run,
+	},
+};
+
+const unsigned int mmio_sim_num_scenarios = ARRAY_SIZE(mmio_sim_scenarios);
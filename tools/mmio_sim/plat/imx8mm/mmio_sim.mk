@@ -0,0 +1,17 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+SIM_FW_INCLUDES		:=	-I${TF_ROOT}/plat/imx/common/include		\
+				-I${TF_ROOT}/plat/imx/imx8m/include		\
+				-I${TF_ROOT}/plat/imx/imx8m/imx8mm/include
+
+SIM_FW_SOURCES		:=	${TF_ROOT}/drivers/arm/tzc/tzc380.c		\
+				${TF_ROOT}/plat/imx/imx8m/ddr/clock.c		\
+				${TF_ROOT}/plat/imx/imx8m/ddr/dram.c		\
+				${TF_ROOT}/plat/imx/imx8m/ddr/lpddr4_dvfs.c	\
+				${TF_ROOT}/plat/imx/imx8m/imx8mm/gpc.c
+
+SIM_SCENARIO_SOURCES	:=	plat/imx8mm/imx8mm_scenarios.c
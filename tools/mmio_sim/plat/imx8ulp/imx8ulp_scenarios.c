@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+#include <platform_def.h>
+
+#include <xrdc.h>
+
+#include "mmio_sim.h"
+
+#define XRDC_ADDR		U(0x292f0000)
+#define XRDC_MDA_W0(_mda)	(XRDC_ADDR + 0x800 + (_mda) * 0x20)
+
+/* DFMT of the masters which are not a processor core */
+#define MDA_NON_CPU(_mda)						\
+	{ "XRDC_MDA" #_mda "_W0", XRDC_MDA_W0(_mda), BIT(29), 0, 0 }
+
+static const struct mmio_sim_reg xrdc_regs[] = {
+	{ "XRDC_CR", XRDC_ADDR, 0x0, 0, 0 },
+	MDA_NON_CPU(1),
+	MDA_NON_CPU(2),
+	MDA_NON_CPU(3),
+	MDA_NON_CPU(4),
+	MDA_NON_CPU(5),
+	MDA_NON_CPU(6),
+	MDA_NON_CPU(7),
+	MDA_NON_CPU(8),
+	MDA_NON_CPU(10),
+	MDA_NON_CPU(11),
+	MDA_NON_CPU(12),
+	MDA_NON_CPU(13),
+	MDA_NON_CPU(14),
+	MDA_NON_CPU(15),
+	MDA_NON_CPU(16),
+};
+
+/* The XRDC configuration restored on exit from Deep Power Down */
+static void xrdc_reinit_run(unsigned int iteration)
+{
+	xrdc_apply_apd_config();
+	xrdc_apply_lpav_config();
+	xrdc_enable();
+}
+
+/* The part of the configuration done once the HIFI4 is released */
+static void xrdc_hifi_run(unsigned int iteration)
+{
+	xrdc_apply_hifi_config();
+}
+
+const struct mmio_sim_scenario mmio_sim_scenarios[] = {
+	{
+		.name = "xrdc_reinit",
+		.help = "APD and LPAV XRDC configuration and enable",
+		.regs = xrdc_regs,
+		.num_regs = ARRAY_SIZE(xrdc_regs),
+		.run = xrdc_reinit_run,
+	},
+	{
+		.name = "xrdc_hifi",
+		.help = "HIFI4 XRDC configuration",
+		.regs = xrdc_regs,
+		.num_regs = ARRAY_SIZE(xrdc_regs),
+		.run = xrdc_hifi_run,
+	},
+};
+
+const unsigned int mmio_sim_num_scenarios = ARRAY_SIZE(mmio_sim_scenarios);
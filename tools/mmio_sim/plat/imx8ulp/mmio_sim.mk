@@ -0,0 +1,13 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+SIM_FW_INCLUDES		:=	-I${TF_ROOT}/plat/imx/common/include		\
+				-I${TF_ROOT}/plat/imx/imx8ulp/include		\
+				-I${TF_ROOT}/plat/imx/imx8ulp/xrdc
+
+SIM_FW_SOURCES		:=	${TF_ROOT}/plat/imx/imx8ulp/xrdc/xrdc_core.c
+
+SIM_SCENARIO_SOURCES	:=	plat/imx8ulp/imx8ulp_scenarios.c
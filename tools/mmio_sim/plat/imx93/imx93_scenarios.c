@@ -0,0 +1,263 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <context.h>
+#include <lib/utils_def.h>
+#include <platform_def.h>
+
+#include <dram.h>
+#include <imx_sip_svc.h>
+#include <trdc.h>
+
+#include "mmio_sim.h"
+
+/* Clock registers of ddr_dvfs.c */
+#define DRAM_PLL_BASE		U(0x44481300)
+#define DRAM_ALT_CLK		U(0x44452600)
+#define DRAM_APB_CLK		U(0x44452680)
+
+#define TRDC_A_BASE		U(0x44270000)
+#define TRDC_W_BASE		U(0x42460000)
+#define TRDC_N_BASE		U(0x49010000)
+
+#define TRDC_HWCFG0(_base)	((_base) + 0xf0)
+#define TRDC_MDA_W(_base, _inst, _reg)	((_base) + 0x800 + (_inst) * 0x20 + \
+					 (_reg) * 4)
+#define TRDC_HWCFG0_VAL(_mbc, _mrc)	(((_mbc) << 16) | ((_mrc) << 24))
+
+/* MBCn_MEMm_GLBCFG, holding the number of blocks of the memory */
+#define MBC_GLBCFG(_base, _mbc, _mem)	((_base) + 0x10000 + (_mbc) * 0x2000 + \
+					 (_mem) * 4)
+
+/* Both the MBC and the MRC checks are enabled */
+#define TRDC_CR_VAL		U(0xc000)
+
+static cpu_context_t smc_ctx;
+
+/*
+ * 3733MTS, 1866MTS and 400MTS in bypass mode, each with a few DDRC timing
+ * registers and mode registers to update.
+ */
+static struct dram_fsp_cfg fsp_cfg[3] = {
+	{
+		.ddrc_cfg = {
+			{ REG_DDR_TIMING_CFG_0, 0x9a55000a },
+			{ REG_DDR_TIMING_CFG_4, 0x0220330c },
+			{ REG_DDR_TIMING_CFG_3, 0x1085f000 },
+			{ REG_DDR_TIMING_CFG_1, 0xfaf7b266 },
+			{ REG_DDR_TIMING_CFG_2, 0x00e0f06c },
+			{ REG_DDR_SDRAM_INTERVAL, 0x0e3c0000 },
+			{ REG_DDR_TIMING_CFG_8, 0x06907d11 },
+			{ REG_DDR_TIMING_CFG_9, 0x00000000 },
+			{ 0, 0 },
+		},
+		.mr_cfg = {
+			{ 0x1, 0xe4 },
+			{ 0x2, 0x36 },
+			{ 0x3, 0xb1 },
+			{ 0xb, 0x44 },
+			{ 0x16, 0x04 },
+			{ 0, 0 },
+		},
+		.bypass = 0,
+	},
+	{
+		.ddrc_cfg = {
+			{ REG_DDR_TIMING_CFG_0, 0x4d2b0005 },
+			{ REG_DDR_TIMING_CFG_4, 0x01101986 },
+			{ REG_DDR_TIMING_CFG_3, 0x0042f000 },
+			{ REG_DDR_TIMING_CFG_1, 0x7d7b6133 },
+			{ REG_DDR_TIMING_CFG_2, 0x00707836 },
+			{ REG_DDR_SDRAM_INTERVAL, 0x071e0000 },
+			{ REG_DDR_TIMING_CFG_8, 0x03483f09 },
+			{ REG_DDR_TIMING_CFG_9, 0x00000000 },
+			{ 0, 0 },
+		},
+		.mr_cfg = {
+			{ 0x1, 0xc4 },
+			{ 0x2, 0x24 },
+			{ 0x3, 0xb1 },
+			{ 0xb, 0x44 },
+			{ 0x16, 0x04 },
+			{ 0, 0 },
+		},
+		.bypass = 0,
+	},
+	{
+		.ddrc_cfg = {
+			{ REG_DDR_TIMING_CFG_0, 0x0d110001 },
+			{ REG_DDR_TIMING_CFG_4, 0x00050408 },
+			{ REG_DDR_TIMING_CFG_3, 0x00000000 },
+			{ REG_DDR_TIMING_CFG_1, 0x00100000 },
+			{ REG_DDR_TIMING_CFG_2, 0x00000000 },
+			{ REG_DDR_SDRAM_INTERVAL, 0x01860000 },
+			{ REG_DDR_TIMING_CFG_8, 0x00000000 },
+			{ REG_DDR_TIMING_CFG_9, 0x00000000 },
+			{ 0, 0 },
+		},
+		.mr_cfg = {
+			{ 0x1, 0x84 },
+			{ 0x2, 0x00 },
+			{ 0x3, 0x31 },
+			{ 0xb, 0x00 },
+			{ 0x16, 0x04 },
+			{ 0, 0 },
+		},
+		.bypass = 1,
+	},
+};
+
+static struct dram_timing_info timing = {
+	.fsp_cfg = fsp_cfg,
+	.fsp_cfg_num = ARRAY_SIZE(fsp_cfg),
+	.fsp_table = { 3733, 1866, 400, },
+};
+
+static const struct mmio_sim_reg ddr_regs[] = {
+	{ "DDR_SDRAM_MD_CNTL", REG_DDR_SDRAM_MD_CNTL, 0x0, 0, 0 },
+	{ "DDR_SDRAM_CFG", REG_DDR_SDRAM_CFG, 0x0, 150, 0 },
+	{ "DDR_SDRAM_CFG_2", REG_DDR_SDRAM_CFG_2, 0x0, 150, 0 },
+	{ "DDR_SDRAM_CFG_3", REG_DDR_SDRAM_CFG_3, 0x0, 150, 0 },
+	{ "DDR_SDRAM_CFG_4", REG_DDR_SDRAM_CFG_4, 0x0, 150, 0 },
+	/* The controller is always idle */
+	{ "DDRDSR_2", REG_DDRDSR_2, BIT(31), 150, 0 },
+	{ "DDRC_STOP_CTRL", REG_DDRC_STOP_CTRL, 0x0, 150, 0 },
+	{ "HWFFC_CTRL", REG_HWFFC_CTRL, 0x0, 0, 0 },
+	{ "DRAM_PLL_CTRL_SET", DRAM_PLL_BASE + 0x4, 0x0, 0, 0 },
+	{ "DRAM_PLL_CTRL_CLR", DRAM_PLL_BASE + 0x8, 0x0, 0, 0 },
+	{ "DRAM_PLL_DIV", DRAM_PLL_BASE + 0x60, 0x009b2004, 0, 0 },
+	{ "DRAM_PLL_STATUS", DRAM_PLL_BASE + 0xf0, 0x1, 0, 0 },
+	{ "DRAM_ALT_CLK", DRAM_ALT_CLK, 0x0, 0, 0 },
+	{ "DRAM_ALT_CLK_STATUS", DRAM_ALT_CLK + 0x20, 0x0, 0, 0 },
+	{ "DRAM_APB_CLK", DRAM_APB_CLK, 0x0, 0, 0 },
+	{ "DRAM_APB_CLK_STATUS", DRAM_APB_CLK + 0x20, 0x0, 0, 0 },
+};
+
+static const struct mmio_sim_rule ddr_rules[] = {
+	/* Mode register set */
+	MMIO_SIM_SELF_CLEAR(REG_DDR_SDRAM_MD_CNTL, BIT(31), 200),
+	/* DDRC state machine reset */
+	MMIO_SIM_SELF_CLEAR(REG_DDR_SDRAM_CFG_3, BIT(31), 500),
+	/* HWFFC stop request and acknowledge */
+	MMIO_SIM_HANDSHAKE(REG_DDRC_STOP_CTRL, BIT(0), REG_DDRC_STOP_CTRL,
+			   BIT(1), 1000),
+	/* The PLL locks 20us after it is powered up */
+	{ DRAM_PLL_BASE + 0x8, BIT(0), BIT(0), DRAM_PLL_BASE + 0xf0, 0x1, 0,
+	  0 },
+	{ DRAM_PLL_BASE + 0x4, BIT(0), BIT(0), DRAM_PLL_BASE + 0xf0, 0, 0x1,
+	  20000 },
+	/* Clock roots are busy for 1us after any update */
+	{ DRAM_ALT_CLK, 0, 0, DRAM_ALT_CLK + 0x20, 0, BIT(28), 0 },
+	{ DRAM_ALT_CLK, 0, 0, DRAM_ALT_CLK + 0x20, BIT(28), 0, 1000 },
+	{ DRAM_APB_CLK, 0, 0, DRAM_APB_CLK + 0x20, 0, BIT(28), 0 },
+	{ DRAM_APB_CLK, 0, 0, DRAM_APB_CLK + 0x20, BIT(28), 0, 1000 },
+};
+
+/*
+ * dram.c keeps the current setpoint across the scenarios: bring the DRAM back
+ * to 3733MTS, from bypass mode if needed, before the first iteration.
+ */
+static void ddr_dvfs_setup(void)
+{
+	dram_info_init((unsigned long)&timing);
+	dram_dvfs_handler(IMX_SIP_DDR_DVFS, &smc_ctx, 0U, 0x1, 0);
+}
+
+/* Software frequency change between 3733MTS and 400MTS in bypass mode */
+static void ddr_swffc_run(unsigned int iteration)
+{
+	u_register_t fsp_index = ((iteration & 1U) == 0U) ? 2U : 0U;
+
+	dram_dvfs_handler(IMX_SIP_DDR_DVFS, &smc_ctx, fsp_index, 0x1, 0);
+}
+
+/* Hardware frequency change between full and half speed */
+static void ddr_hwffc_run(unsigned int iteration)
+{
+	u_register_t fsp_index = ((iteration & 1U) == 0U) ? 1U : 0U;
+
+	dram_dvfs_handler(IMX_SIP_DDR_DVFS, &smc_ctx, fsp_index, 0x1, 0);
+}
+
+static const struct mmio_sim_reg trdc_regs[] = {
+	{ "TRDC_A_CR", TRDC_A_BASE, TRDC_CR_VAL, 0, 0 },
+	{ "TRDC_A_HWCFG0", TRDC_HWCFG0(TRDC_A_BASE), TRDC_HWCFG0_VAL(2, 1),
+	  0, 0 },
+	{ "TRDC_W_CR", TRDC_W_BASE, TRDC_CR_VAL, 0, 0 },
+	{ "TRDC_W_HWCFG0", TRDC_HWCFG0(TRDC_W_BASE), TRDC_HWCFG0_VAL(2, 1),
+	  0, 0 },
+	{ "TRDC_N_CR", TRDC_N_BASE, TRDC_CR_VAL, 0, 0 },
+	{ "TRDC_N_HWCFG0", TRDC_HWCFG0(TRDC_N_BASE), TRDC_HWCFG0_VAL(4, 1),
+	  0, 0 },
+	/* MTR is a non-CPU master */
+	{ "TRDC_A_MDA4_W0", TRDC_MDA_W(TRDC_A_BASE, 4, 0), BIT(29), 0, 0 },
+	{ "TRDC_A_MBC0_MEM0", MBC_GLBCFG(TRDC_A_BASE, 0, 0), 88, 0, 0 },
+	{ "TRDC_A_MBC0_MEM1", MBC_GLBCFG(TRDC_A_BASE, 0, 1), 8, 0, 0 },
+	{ "TRDC_A_MBC0_MEM2", MBC_GLBCFG(TRDC_A_BASE, 0, 2), 8, 0, 0 },
+	{ "TRDC_A_MBC1_MEM0", MBC_GLBCFG(TRDC_A_BASE, 1, 0), 32, 0, 0 },
+	{ "TRDC_A_MBC1_MEM1", MBC_GLBCFG(TRDC_A_BASE, 1, 1), 32, 0, 0 },
+	{ "TRDC_W_MBC0_MEM0", MBC_GLBCFG(TRDC_W_BASE, 0, 0), 120, 0, 0 },
+	{ "TRDC_W_MBC0_MEM1", MBC_GLBCFG(TRDC_W_BASE, 0, 1), 8, 0, 0 },
+	{ "TRDC_W_MBC0_MEM2", MBC_GLBCFG(TRDC_W_BASE, 0, 2), 8, 0, 0 },
+	{ "TRDC_W_MBC1_MEM0", MBC_GLBCFG(TRDC_W_BASE, 1, 0), 16, 0, 0 },
+	{ "TRDC_W_MBC1_MEM1", MBC_GLBCFG(TRDC_W_BASE, 1, 1), 8, 0, 0 },
+	{ "TRDC_W_MBC1_MEM2", MBC_GLBCFG(TRDC_W_BASE, 1, 2), 8, 0, 0 },
+	{ "TRDC_W_MBC1_MEM3", MBC_GLBCFG(TRDC_W_BASE, 1, 3), 8, 0, 0 },
+	{ "TRDC_N_MBC0_MEM0", MBC_GLBCFG(TRDC_N_BASE, 0, 0), 56, 0, 0 },
+	{ "TRDC_N_MBC0_MEM1", MBC_GLBCFG(TRDC_N_BASE, 0, 1), 16, 0, 0 },
+	{ "TRDC_N_MBC0_MEM2", MBC_GLBCFG(TRDC_N_BASE, 0, 2), 40, 0, 0 },
+	{ "TRDC_N_MBC0_MEM3", MBC_GLBCFG(TRDC_N_BASE, 0, 3), 48, 0, 0 },
+	{ "TRDC_N_MBC1_MEM0", MBC_GLBCFG(TRDC_N_BASE, 1, 0), 8, 0, 0 },
+	{ "TRDC_N_MBC1_MEM1", MBC_GLBCFG(TRDC_N_BASE, 1, 1), 8, 0, 0 },
+	{ "TRDC_N_MBC1_MEM2", MBC_GLBCFG(TRDC_N_BASE, 1, 2), 24, 0, 0 },
+	{ "TRDC_N_MBC1_MEM3", MBC_GLBCFG(TRDC_N_BASE, 1, 3), 24, 0, 0 },
+	{ "TRDC_N_MBC2_MEM0", MBC_GLBCFG(TRDC_N_BASE, 2, 0), 16, 0, 0 },
+	{ "TRDC_N_MBC2_MEM1", MBC_GLBCFG(TRDC_N_BASE, 2, 1), 16, 0, 0 },
+	{ "TRDC_N_MBC3_MEM0", MBC_GLBCFG(TRDC_N_BASE, 3, 0), 40, 0, 0 },
+	{ "TRDC_N_MBC3_MEM1", MBC_GLBCFG(TRDC_N_BASE, 3, 1), 40, 0, 0 },
+	/* NPU and both USB controllers fused out */
+	{ "FSB_SHADOW_19", FSB_BASE + FSB_SHADOW_OFF + (19 << 2), BIT(13),
+	  0, 0 },
+	{ "FSB_SHADOW_20", FSB_BASE + FSB_SHADOW_OFF + (20 << 2),
+	  BIT(3) | BIT(4), 0, 0 },
+};
+
+static void trdc_config_run(unsigned int iteration)
+{
+	trdc_config();
+}
+
+const struct mmio_sim_scenario mmio_sim_scenarios[] = {
+	{
+		.name = "ddr_swffc",
+		.help = "DDR DVFS SiP call, 3733MTS <-> 400MTS bypass",
+		.regs = ddr_regs,
+		.num_regs = ARRAY_SIZE(ddr_regs),
+		.rules = ddr_rules,
+		.num_rules = ARRAY_SIZE(ddr_rules),
+		.setup = ddr_dvfs_setup,
+		.run = ddr_swffc_run,
+	},
+	{
+		.name = "ddr_hwffc",
+		.help = "DDR DVFS SiP call, full speed <-> half speed",
+		.regs = ddr_regs,
+		.num_regs = ARRAY_SIZE(ddr_regs),
+		.rules = ddr_rules,
+		.num_rules = ARRAY_SIZE(ddr_rules),
+		.setup = ddr_dvfs_setup,
+		.run = ddr_hwffc_run,
+	},
+	{
+		.name = "trdc_config",
+		.help = "TRDC configuration of the boot",
+		.regs = trdc_regs,
+		.num_regs = ARRAY_SIZE(trdc_regs),
+		.run = trdc_config_run,
+	},
+};
+
+const unsigned int mmio_sim_num_scenarios = ARRAY_SIZE(mmio_sim_scenarios);
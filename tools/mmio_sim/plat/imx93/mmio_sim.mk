@@ -0,0 +1,15 @@
+#
+# Copyright 2022 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+SIM_FW_INCLUDES		:=	-I${TF_ROOT}/plat/imx/common/include		\
+				-I${TF_ROOT}/plat/imx/imx93/include		\
+				-I${TF_ROOT}/plat/imx/imx93
+
+SIM_FW_SOURCES		:=	${TF_ROOT}/plat/imx/imx93/ddr/ddr_dvfs.c	\
+				${TF_ROOT}/plat/imx/imx93/ddr/dram.c		\
+				${TF_ROOT}/plat/imx/imx93/trdc.c
+
+SIM_SCENARIO_SOURCES	:=	plat/imx93/imx93_scenarios.c
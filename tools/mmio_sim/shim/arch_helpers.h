@@ -0,0 +1,91 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+#include <cdefs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <arch.h>
+
+/*
+ * Host replacement for include/arch/aarch64/arch_helpers.h: barriers and
+ * events are no-ops, the generic timer counts the modelled time of
+ * mmio_sim.c and the code runs on core 0.
+ */
+uint64_t mmio_sim_now_ns(void);
+
+#define MMIO_SIM_CNTFRQ		U(24000000)
+
+static inline u_register_t read_cntfrq_el0(void)
+{
+	return MMIO_SIM_CNTFRQ;
+}
+
+static inline u_register_t read_cntpct_el0(void)
+{
+	return (mmio_sim_now_ns() * (MMIO_SIM_CNTFRQ / 1000000U)) / 1000U;
+}
+
+static inline u_register_t read_mpidr_el1(void)
+{
+	/* Bit 31 is RES1 */
+	return U(0x80000000);
+}
+
+static inline u_register_t read_mpidr(void)
+{
+	return read_mpidr_el1();
+}
+
+static inline void wfe(void) { }
+static inline void wfi(void) { }
+static inline void sev(void) { }
+static inline void isb(void) { }
+static inline void dsbsy(void) { }
+static inline void dsbish(void) { }
+static inline void dsbishst(void) { }
+static inline void dmbsy(void) { }
+static inline void dmbish(void) { }
+static inline void dmbishst(void) { }
+
+#define dsb()	dsbsy()
+
+static inline void dcsw_op_all(u_register_t op_type) { }
+static inline void flush_dcache_range(uintptr_t addr, size_t size) { }
+static inline void inv_dcache_range(uintptr_t addr, size_t size) { }
+static inline void clean_dcache_range(uintptr_t addr, size_t size) { }
+
+/* GICv3 CPU interface, no interrupt is ever pending */
+#define MMIO_SIM_SPURIOUS_INTID	U(1023)
+
+static inline u_register_t read_icc_iar0_el1(void)
+{
+	return MMIO_SIM_SPURIOUS_INTID;
+}
+
+static inline u_register_t read_icc_iar1_el1(void)
+{
+	return MMIO_SIM_SPURIOUS_INTID;
+}
+
+static inline u_register_t read_icc_hppir0_el1(void)
+{
+	return MMIO_SIM_SPURIOUS_INTID;
+}
+
+static inline u_register_t read_icc_hppir1_el1(void)
+{
+	return MMIO_SIM_SPURIOUS_INTID;
+}
+
+static inline void write_icc_eoir0_el1(u_register_t v) { }
+static inline void write_icc_eoir1_el1(u_register_t v) { }
+
+#endif /* ARCH_HELPERS_H */
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MMIO_SIM_ASSERT_H
+#define MMIO_SIM_ASSERT_H
+
+/*
+ * The TF-A assert.h pulls in the platform definitions and the logging macros,
+ * some platform sources rely on it.
+ */
+#include <platform_def.h>
+
+#include <common/debug.h>
+
+#include_next <assert.h>
+
+#endif /* MMIO_SIM_ASSERT_H */
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MMIO_H
+#define MMIO_H
+
+#include <stdint.h>
+
+/*
+ * Replacement for include/lib/mmio.h when platform sources are built for the
+ * host: every access goes through the simulated bus of mmio_sim.c.
+ */
+uint64_t mmio_sim_read(uintptr_t addr, unsigned int size);
+void mmio_sim_write(uintptr_t addr, uint64_t value, unsigned int size);
+
+static inline void mmio_write_8(uintptr_t addr, uint8_t value)
+{
+	mmio_sim_write(addr, value, 1U);
+}
+
+static inline uint8_t mmio_read_8(uintptr_t addr)
+{
+	return (uint8_t)mmio_sim_read(addr, 1U);
+}
+
+static inline void mmio_write_16(uintptr_t addr, uint16_t value)
+{
+	mmio_sim_write(addr, value, 2U);
+}
+
+static inline uint16_t mmio_read_16(uintptr_t addr)
+{
+	return (uint16_t)mmio_sim_read(addr, 2U);
+}
+
+static inline void mmio_clrsetbits_16(uintptr_t addr,
+				uint16_t clear,
+				uint16_t set)
+{
+	mmio_write_16(addr, (mmio_read_16(addr) & ~clear) | set);
+}
+
+static inline void mmio_write_32(uintptr_t addr, uint32_t value)
+{
+	mmio_sim_write(addr, value, 4U);
+}
+
+static inline uint32_t mmio_read_32(uintptr_t addr)
+{
+	return (uint32_t)mmio_sim_read(addr, 4U);
+}
+
+static inline void mmio_write_64(uintptr_t addr, uint64_t value)
+{
+	mmio_sim_write(addr, value, 8U);
+}
+
+static inline uint64_t mmio_read_64(uintptr_t addr)
+{
+	return mmio_sim_read(addr, 8U);
+}
+
+static inline void mmio_clrbits_32(uintptr_t addr, uint32_t clear)
+{
+	mmio_write_32(addr, mmio_read_32(addr) & ~clear);
+}
+
+static inline void mmio_setbits_32(uintptr_t addr, uint32_t set)
+{
+	mmio_write_32(addr, mmio_read_32(addr) | set);
+}
+
+static inline void mmio_clrsetbits_32(uintptr_t addr,
+				uint32_t clear,
+				uint32_t set)
+{
+	mmio_write_32(addr, (mmio_read_32(addr) & ~clear) | set);
+}
+
+#endif /* MMIO_H */
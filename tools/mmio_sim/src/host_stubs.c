@@ -0,0 +1,112 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <bl31/interrupt_mgmt.h>
+#include <common/debug.h>
+#include <drivers/console.h>
+#include <drivers/delay_timer.h>
+#include <lib/spinlock.h>
+#include <plat/common/platform.h>
+
+#include "mmio_sim.h"
+
+/*
+ * Host implementation of the common firmware services the simulated platform
+ * sources call. Delays only advance the modelled time, there is a single core
+ * and no interrupt is ever pending.
+ */
+
+unsigned int mmio_sim_log_level = LOG_LEVEL_WARNING;
+
+static const char *log_prefix(unsigned int level)
+{
+	switch (level) {
+	case LOG_LEVEL_ERROR:
+		return "ERROR:   ";
+	case LOG_LEVEL_NOTICE:
+		return "NOTICE:  ";
+	case LOG_LEVEL_WARNING:
+		return "WARNING: ";
+	case LOG_LEVEL_INFO:
+		return "INFO:    ";
+	default:
+		return "VERBOSE: ";
+	}
+}
+
+void tf_log(const char *fmt, ...)
+{
+	unsigned int level = (unsigned char)fmt[0];
+	va_list args;
+
+	if (level > mmio_sim_log_level)
+		return;
+
+	printf("%s", log_prefix(level));
+	va_start(args, fmt);
+	vprintf(fmt + 1, args);
+	va_end(args);
+}
+
+void tf_log_newline(const char log_fmt[2])
+{
+	if ((unsigned char)log_fmt[0] <= mmio_sim_log_level)
+		putchar('\n');
+}
+
+void do_panic(void)
+{
+	fprintf(stderr, "ERROR: Firmware panic\n");
+	mmio_sim_abort();
+}
+
+void console_flush(void)
+{
+	fflush(stdout);
+}
+
+void udelay(uint32_t usec)
+{
+	mmio_sim_delay_ns((uint64_t)usec * 1000U);
+}
+
+void mdelay(uint32_t msec)
+{
+	mmio_sim_delay_ns((uint64_t)msec * 1000000U);
+}
+
+void spin_lock(spinlock_t *lock)
+{
+	lock->lock = 1U;
+}
+
+void spin_unlock(spinlock_t *lock)
+{
+	lock->lock = 0U;
+}
+
+uint32_t plat_ic_acknowledge_interrupt(void)
+{
+	return INTR_ID_UNAVAILABLE;
+}
+
+void plat_ic_end_of_interrupt(uint32_t id)
+{
+}
+
+void plat_ic_raise_el3_sgi(int sgi_num, u_register_t target)
+{
+}
+
+int32_t register_interrupt_type_handler(uint32_t type,
+					interrupt_type_handler_t handler,
+					uint32_t flags)
+{
+	return 0;
+}
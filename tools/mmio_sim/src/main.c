@@ -0,0 +1,219 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mmio_sim.h"
+
+#define LOG_LEVEL_ALL	50U
+
+/* Budgets per iteration, 0 when not checked */
+static uint64_t max_reads;
+static uint64_t max_writes;
+static uint64_t max_polls;
+static uint64_t max_time_us;
+
+static unsigned int iterations = 1U;
+static int show_regs = -1;
+
+static const struct option long_opt[] = {
+	{ "list", no_argument, NULL, 'l' },
+	{ "iterations", required_argument, NULL, 'n' },
+	{ "registers", required_argument, NULL, 'r' },
+	{ "trace", no_argument, NULL, 't' },
+	{ "verbose", no_argument, NULL, 'v' },
+	{ "poll-limit", required_argument, NULL, 'p' },
+	{ "max-reads", required_argument, NULL, 'R' },
+	{ "max-writes", required_argument, NULL, 'W' },
+	{ "max-polls", required_argument, NULL, 'P' },
+	{ "max-time-us", required_argument, NULL, 'T' },
+	{ "help", no_argument, NULL, 'h' },
+	{ NULL, 0, NULL, 0 }
+};
+
+static void usage(void)
+{
+	printf("mmio_sim [OPTIONS] [SCENARIO...]\n\n");
+	printf("Run platform code paths against simulated registers and "
+	       "report their\nregister accesses and modelled time. All the "
+	       "scenarios are run by default.\n\n");
+	printf("Options:\n");
+	printf("  -l, --list             List the scenarios\n");
+	printf("  -n, --iterations <n>   Run each scenario <n> times (1)\n");
+	printf("  -r, --registers <n>    Show the <n> most accessed registers, "
+	       "0 for all\n");
+	printf("  -t, --trace            Print every register access\n");
+	printf("  -v, --verbose          Print all the firmware messages\n");
+	printf("  -p, --poll-limit <n>   Consecutive reads of a register "
+	       "before a poll is\n                         considered stuck\n");
+	printf("  --max-reads <n>        Fail if an iteration does more than "
+	       "<n> reads\n");
+	printf("  --max-writes <n>       Fail if an iteration does more than "
+	       "<n> writes\n");
+	printf("  --max-polls <n>        Fail if an iteration polls more than "
+	       "<n> times\n");
+	printf("  --max-time-us <n>      Fail if an iteration takes more than "
+	       "<n> us\n");
+	printf("  -h, --help             Print this message\n");
+	exit(0);
+}
+
+static uint64_t get_number(const char *arg)
+{
+	char *end;
+	unsigned long long val;
+
+	val = strtoull(arg, &end, 0);
+	if (*arg == '\0' || *end != '\0') {
+		fprintf(stderr, "ERROR: Invalid number '%s'\n", arg);
+		exit(1);
+	}
+
+	return val;
+}
+
+static const struct mmio_sim_scenario *find_scenario(const char *name)
+{
+	unsigned int i;
+
+	for (i = 0U; i < mmio_sim_num_scenarios; i++) {
+		if (strcmp(mmio_sim_scenarios[i].name, name) == 0)
+			return &mmio_sim_scenarios[i];
+	}
+
+	return NULL;
+}
+
+static void list_scenarios(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < mmio_sim_num_scenarios; i++)
+		printf("%-24s %s\n", mmio_sim_scenarios[i].name,
+		       mmio_sim_scenarios[i].help);
+}
+
+static int check_budget(const char *scenario, const char *what,
+			uint64_t value, uint64_t max)
+{
+	if (max == 0U || value <= max)
+		return 0;
+
+	fprintf(stderr, "ERROR: %s: %" PRIu64 " %s per iteration, "
+		"budget is %" PRIu64 "\n", scenario, value, what, max);
+	return -1;
+}
+
+static int run_scenario(const struct mmio_sim_scenario *scenario)
+{
+	struct mmio_sim_stats stats;
+	uint64_t reads, writes, polls, time_ns;
+	int ret;
+
+	ret = mmio_sim_run(scenario, iterations, &stats);
+	if (ret != 0) {
+		fprintf(stderr, "ERROR: %s: Scenario aborted\n",
+			scenario->name);
+		return ret;
+	}
+
+	reads = (stats.reads + iterations - 1U) / iterations;
+	writes = (stats.writes + iterations - 1U) / iterations;
+	polls = (stats.polls + iterations - 1U) / iterations;
+	time_ns = (stats.time_ns + iterations - 1U) / iterations;
+
+	printf("%s: %" PRIu64 " reads, %" PRIu64 " writes, %" PRIu64
+	       " polls, %" PRIu64 ".%03" PRIu64 " us (delays %" PRIu64
+	       ".%03" PRIu64 " us), %" PRIu64 " pages\n", scenario->name,
+	       reads, writes, polls, time_ns / 1000U, time_ns % 1000U,
+	       stats.delay_ns / iterations / 1000U,
+	       stats.delay_ns / iterations % 1000U, stats.pages);
+
+	if (show_regs >= 0)
+		mmio_sim_print_registers((unsigned int)show_regs);
+
+	ret = check_budget(scenario->name, "reads", reads, max_reads);
+	ret |= check_budget(scenario->name, "writes", writes, max_writes);
+	ret |= check_budget(scenario->name, "polls", polls, max_polls);
+	ret |= check_budget(scenario->name, "ns", time_ns, max_time_us * 1000U);
+
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	const struct mmio_sim_scenario *scenario;
+	unsigned int i;
+	int opt, ret = 0;
+
+	while ((opt = getopt_long(argc, argv, "ln:r:tvp:h", long_opt,
+				  NULL)) != -1) {
+		switch (opt) {
+		case 'l':
+			list_scenarios();
+			return 0;
+		case 'n':
+			iterations = (unsigned int)get_number(optarg);
+			if (iterations == 0U) {
+				fprintf(stderr, "ERROR: No iteration\n");
+				return 1;
+			}
+			break;
+		case 'r':
+			show_regs = (int)get_number(optarg);
+			break;
+		case 't':
+			mmio_sim_set_trace(true);
+			break;
+		case 'v':
+			mmio_sim_log_level = LOG_LEVEL_ALL;
+			break;
+		case 'p':
+			mmio_sim_set_poll_limit(get_number(optarg));
+			break;
+		case 'R':
+			max_reads = get_number(optarg);
+			break;
+		case 'W':
+			max_writes = get_number(optarg);
+			break;
+		case 'P':
+			max_polls = get_number(optarg);
+			break;
+		case 'T':
+			max_time_us = get_number(optarg);
+			break;
+		default:
+			usage();
+			break;
+		}
+	}
+
+	if (mmio_sim_init() != 0)
+		return 1;
+
+	if (optind == argc) {
+		for (i = 0U; i < mmio_sim_num_scenarios; i++)
+			ret |= run_scenario(&mmio_sim_scenarios[i]);
+		return (ret != 0) ? 1 : 0;
+	}
+
+	for (; optind < argc; optind++) {
+		scenario = find_scenario(argv[optind]);
+		if (scenario == NULL) {
+			fprintf(stderr, "ERROR: Unknown scenario '%s'\n",
+				argv[optind]);
+			return 1;
+		}
+		ret |= run_scenario(scenario);
+	}
+
+	return (ret != 0) ? 1 : 0;
+}
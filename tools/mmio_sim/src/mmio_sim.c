@@ -0,0 +1,437 @@
+/*
+ * Copyright 2022 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <inttypes.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "mmio_sim.h"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE	0x100000
+#endif
+
+/*
+ * The simulated devices are plain anonymous memory mapped at their physical
+ * address, on demand: the first access to a page, through the mmio_*()
+ * accessors or through a pointer, faults and maps the page. Only the first
+ * 4GB are treated this way, a fault anywhere else is a real crash.
+ */
+#define SIM_PAGE_SIZE		0x1000UL
+#define SIM_ADDR_MIN		0x10000UL
+#define SIM_ADDR_MAX		0x100000000UL
+#define SIM_MAX_PAGES		16384U
+
+/* Register table, indexed by a hash of the 32-bit aligned address */
+#define SIM_TABLE_SIZE		(1U << 17)
+#define SIM_MAX_EVENTS		256U
+
+#define SIM_DEFAULT_POLL_LIMIT	1000000ULL
+
+typedef struct sim_entry {
+	uintptr_t addr;
+	const char *name;
+	unsigned int read_ns;
+	unsigned int write_ns;
+	bool used;
+	bool has_rules;
+	uint64_t reads;
+	uint64_t writes;
+	uint64_t polls;
+} sim_entry_t;
+
+typedef struct sim_event {
+	uint64_t due_ns;
+	uintptr_t target;
+	uint32_t clear;
+	uint32_t set;
+} sim_event_t;
+
+static uintptr_t pages[SIM_MAX_PAGES];
+static volatile unsigned int num_pages;
+
+static sim_entry_t *table;
+static unsigned int table_used;
+
+static sim_event_t events[SIM_MAX_EVENTS];
+static unsigned int num_events;
+
+static const struct mmio_sim_scenario *cur_scenario;
+static struct mmio_sim_stats stats;
+static uint64_t now_ns;
+
+static uintptr_t last_read;
+static uint64_t consecutive_reads;
+static uint64_t poll_limit = SIM_DEFAULT_POLL_LIMIT;
+static bool trace;
+
+static jmp_buf abort_env;
+
+static int map_page(uintptr_t page)
+{
+	void *p;
+
+	if (num_pages == SIM_MAX_PAGES)
+		return -1;
+
+	p = mmap((void *)page, SIM_PAGE_SIZE, PROT_READ | PROT_WRITE,
+		 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	if (p == MAP_FAILED)
+		return -1;
+	if (p != (void *)page) {
+		/* Kernel without MAP_FIXED_NOREPLACE, the hint was ignored */
+		munmap(p, SIM_PAGE_SIZE);
+		return -1;
+	}
+
+	pages[num_pages++] = page;
+	return 0;
+}
+
+static void unmap_pages(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < num_pages; i++)
+		munmap((void *)pages[i], SIM_PAGE_SIZE);
+	num_pages = 0U;
+}
+
+static void segv_handler(int sig, siginfo_t *info, void *ucontext)
+{
+	uintptr_t addr = (uintptr_t)info->si_addr;
+
+	if (addr >= SIM_ADDR_MIN && addr < SIM_ADDR_MAX &&
+	    map_page(addr & ~(SIM_PAGE_SIZE - 1UL)) == 0)
+		return;
+
+	/* Not a simulated device, let the access fault again and crash */
+	signal(SIGSEGV, SIG_DFL);
+}
+
+static sim_entry_t *lookup(uintptr_t addr)
+{
+	unsigned int i;
+
+	addr &= ~(uintptr_t)3U;
+	i = (unsigned int)((addr >> 2) * 2654435761U) & (SIM_TABLE_SIZE - 1U);
+
+	while (table[i].used) {
+		if (table[i].addr == addr)
+			return &table[i];
+		i = (i + 1U) & (SIM_TABLE_SIZE - 1U);
+	}
+
+	if (table_used >= SIM_TABLE_SIZE - SIM_TABLE_SIZE / 4U) {
+		fprintf(stderr, "ERROR: Too many registers accessed\n");
+		exit(1);
+	}
+
+	table[i].used = true;
+	table[i].addr = addr;
+	table_used++;
+
+	return &table[i];
+}
+
+static void raw_update(uintptr_t addr, uint32_t clear, uint32_t set)
+{
+	volatile uint32_t *reg = (volatile uint32_t *)addr;
+
+	*reg = (*reg & ~clear) | set;
+}
+
+/* Apply the events that are due, in order, the earliest scheduled first */
+static void process_events(void)
+{
+	unsigned int i, next;
+
+	while (num_events != 0U) {
+		next = 0U;
+		for (i = 1U; i < num_events; i++) {
+			if (events[i].due_ns < events[next].due_ns)
+				next = i;
+		}
+
+		if (events[next].due_ns > now_ns)
+			break;
+
+		raw_update(events[next].target, events[next].clear,
+			   events[next].set);
+		num_events--;
+		memmove(&events[next], &events[next + 1U],
+			(num_events - next) * sizeof(events[0]));
+	}
+}
+
+static void apply_rules(uintptr_t addr, uint32_t value)
+{
+	const struct mmio_sim_rule *rule;
+	unsigned int i;
+
+	for (i = 0U; i < cur_scenario->num_rules; i++) {
+		rule = &cur_scenario->rules[i];
+		if (rule->addr != addr || (value & rule->mask) != rule->match)
+			continue;
+
+		if (rule->delay_ns == 0U) {
+			raw_update(rule->target, rule->clear, rule->set);
+			continue;
+		}
+
+		if (num_events == SIM_MAX_EVENTS) {
+			fprintf(stderr, "ERROR: Too many pending events\n");
+			exit(1);
+		}
+		events[num_events].due_ns = now_ns + rule->delay_ns;
+		events[num_events].target = rule->target;
+		events[num_events].clear = rule->clear;
+		events[num_events].set = rule->set;
+		num_events++;
+	}
+}
+
+static const char *entry_name(const sim_entry_t *entry)
+{
+	return (entry->name != NULL) ? entry->name : "";
+}
+
+uint64_t mmio_sim_read(uintptr_t addr, unsigned int size)
+{
+	sim_entry_t *entry = lookup(addr);
+	uint64_t value;
+
+	now_ns += (entry->read_ns != 0U) ? entry->read_ns :
+		  MMIO_SIM_DEFAULT_READ_NS;
+	process_events();
+
+	switch (size) {
+	case 1U:
+		value = *(volatile uint8_t *)addr;
+		break;
+	case 2U:
+		value = *(volatile uint16_t *)addr;
+		break;
+	case 4U:
+		value = *(volatile uint32_t *)addr;
+		break;
+	default:
+		value = *(volatile uint64_t *)addr;
+		break;
+	}
+
+	entry->reads++;
+	stats.reads++;
+
+	if (addr == last_read) {
+		entry->polls++;
+		stats.polls++;
+		if (++consecutive_reads > poll_limit) {
+			fprintf(stderr, "ERROR: Polling 0x%08" PRIxPTR " %s "
+				"forever, value 0x%" PRIx64 "\n",
+				addr, entry_name(entry), value);
+			mmio_sim_abort();
+		}
+	} else {
+		consecutive_reads = 0U;
+	}
+	last_read = addr;
+
+	if (trace)
+		printf("R%u 0x%08" PRIxPTR " 0x%08" PRIx64 " %s\n",
+		       size * 8U, addr, value, entry_name(entry));
+
+	return value;
+}
+
+void mmio_sim_write(uintptr_t addr, uint64_t value, unsigned int size)
+{
+	sim_entry_t *entry = lookup(addr);
+
+	now_ns += (entry->write_ns != 0U) ? entry->write_ns :
+		  MMIO_SIM_DEFAULT_WRITE_NS;
+	process_events();
+
+	switch (size) {
+	case 1U:
+		*(volatile uint8_t *)addr = (uint8_t)value;
+		break;
+	case 2U:
+		*(volatile uint16_t *)addr = (uint16_t)value;
+		break;
+	case 4U:
+		*(volatile uint32_t *)addr = (uint32_t)value;
+		break;
+	default:
+		*(volatile uint64_t *)addr = value;
+		break;
+	}
+
+	entry->writes++;
+	stats.writes++;
+	last_read = 0U;
+
+	if (trace)
+		printf("W%u 0x%08" PRIxPTR " 0x%08" PRIx64 " %s\n",
+		       size * 8U, addr, value, entry_name(entry));
+
+	if (entry->has_rules && size == 4U)
+		apply_rules(addr, (uint32_t)value);
+}
+
+void mmio_sim_abort(void)
+{
+	longjmp(abort_env, 1);
+}
+
+uint64_t mmio_sim_now_ns(void)
+{
+	return now_ns;
+}
+
+void mmio_sim_delay_ns(uint64_t ns)
+{
+	now_ns += ns;
+	stats.delay_ns += ns;
+	process_events();
+}
+
+void mmio_sim_set_trace(bool enable)
+{
+	trace = enable;
+}
+
+void mmio_sim_set_poll_limit(uint64_t limit)
+{
+	poll_limit = limit;
+}
+
+int mmio_sim_init(void)
+{
+	struct sigaction sa;
+
+	table = calloc(SIM_TABLE_SIZE, sizeof(*table));
+	if (table == NULL) {
+		fprintf(stderr, "ERROR: Out of memory\n");
+		return -1;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_sigaction = segv_handler;
+	sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+	sigemptyset(&sa.sa_mask);
+
+	return sigaction(SIGSEGV, &sa, NULL);
+}
+
+void mmio_sim_reset(const struct mmio_sim_scenario *scenario)
+{
+	const struct mmio_sim_reg *reg;
+	sim_entry_t *entry;
+	unsigned int i;
+
+	unmap_pages();
+	memset(table, 0, SIM_TABLE_SIZE * sizeof(*table));
+	table_used = 0U;
+	num_events = 0U;
+	memset(&stats, 0, sizeof(stats));
+	now_ns = 0U;
+	last_read = 0U;
+	consecutive_reads = 0U;
+	cur_scenario = scenario;
+
+	for (i = 0U; i < scenario->num_regs; i++) {
+		reg = &scenario->regs[i];
+		entry = lookup(reg->addr);
+		entry->name = reg->name;
+		entry->read_ns = reg->read_ns;
+		entry->write_ns = reg->write_ns;
+		*(volatile uint32_t *)reg->addr = reg->reset;
+	}
+
+	for (i = 0U; i < scenario->num_rules; i++)
+		lookup(scenario->rules[i].addr)->has_rules = true;
+}
+
+int mmio_sim_run(const struct mmio_sim_scenario *scenario,
+		 unsigned int iterations, struct mmio_sim_stats *result)
+{
+	unsigned int i;
+	int ret = 0;
+
+	mmio_sim_reset(scenario);
+
+	if (setjmp(abort_env) == 0) {
+		if (scenario->setup != NULL)
+			scenario->setup();
+
+		/* The setup is not part of the measure */
+		memset(&stats, 0, sizeof(stats));
+		now_ns = 0U;
+		for (i = 0U; i < SIM_TABLE_SIZE; i++) {
+			table[i].reads = 0U;
+			table[i].writes = 0U;
+			table[i].polls = 0U;
+		}
+
+		for (i = 0U; i < iterations; i++)
+			scenario->run(i);
+	} else {
+		ret = -1;
+	}
+
+	stats.pages = num_pages;
+	stats.time_ns = now_ns;
+	*result = stats;
+
+	return ret;
+}
+
+static int compare_entries(const void *a, const void *b)
+{
+	const sim_entry_t *ea = *(const sim_entry_t * const *)a;
+	const sim_entry_t *eb = *(const sim_entry_t * const *)b;
+	uint64_t na = ea->reads + ea->writes;
+	uint64_t nb = eb->reads + eb->writes;
+
+	if (na != nb)
+		return (na < nb) ? 1 : -1;
+
+	return (ea->addr < eb->addr) ? -1 : (ea->addr > eb->addr);
+}
+
+void mmio_sim_print_registers(unsigned int max_regs)
+{
+	sim_entry_t **sorted;
+	unsigned int i, n = 0U;
+
+	sorted = malloc(table_used * sizeof(*sorted));
+	if (sorted == NULL)
+		return;
+
+	for (i = 0U; i < SIM_TABLE_SIZE; i++) {
+		if (table[i].used && (table[i].reads + table[i].writes) != 0U)
+			sorted[n++] = &table[i];
+	}
+	qsort(sorted, n, sizeof(*sorted), compare_entries);
+
+	printf("  %-10s %10s %10s %10s  %s\n",
+	       "address", "reads", "writes", "polls", "register");
+	for (i = 0U; i < n && (max_regs == 0U || i < max_regs); i++) {
+		printf("  0x%08" PRIxPTR " %10" PRIu64 " %10" PRIu64
+		       " %10" PRIu64 "  %s\n", sorted[i]->addr,
+		       sorted[i]->reads, sorted[i]->writes, sorted[i]->polls,
+		       entry_name(sorted[i]));
+	}
+	if (i < n)
+		printf("  ... %u more registers\n", n - i);
+
+	free(sorted);
+}